@@ -25,6 +25,8 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Analyses/StaticOptimizationTarget.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -40,6 +42,10 @@ void testArm26(const string& muscleModelClassName, double atol, double ftol);
 
 void testArm26DisabledMuscles();
 
+void testArm26Parallel();
+
+void testAnalyticConstraintMatrix();
+
 void testLapackErrorDLASD4();
 
 void testModelWithPassiveForces();
@@ -105,6 +111,22 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testArm26Parallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testArm26Parallel");
+    }
+
+    try {
+        testAnalyticConstraintMatrix();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testAnalyticConstraintMatrix");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +287,106 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testArm26Parallel() {
+    // Solving the frames in chunks on multiple threads must give the same
+    // results, in the same order, as solving them serially.
+    AnalyzeTool serial("arm26_Setup_StaticOptimization.xml");
+    serial.setResultsDir("Results_arm26_StaticOptimization_Serial");
+    serial.run();
+
+    AnalyzeTool parallel("arm26_Setup_StaticOptimization.xml");
+    parallel.setResultsDir("Results_arm26_StaticOptimization_Parallel");
+    auto& so = dynamic_cast<StaticOptimization&>(
+            parallel.updAnalysisSet().get("StaticOptimization"));
+    ASSERT_EQUAL(so.getParallel(), 0);
+    so.setParallel(3);
+    parallel.run();
+
+    for (const std::string suffix : {"_activation.sto", "_force.sto"}) {
+        const std::string fileName = "/arm26_StaticOptimization" + suffix;
+        Storage serialResults(serial.getResultsDir() + fileName);
+        Storage parallelResults(parallel.getResultsDir() + fileName);
+        ASSERT_EQUAL(parallelResults.getSize(), serialResults.getSize());
+        ASSERT_EQUAL(parallelResults.getFirstTime(),
+                serialResults.getFirstTime(), 1e-10);
+        ASSERT_EQUAL(parallelResults.getLastTime(),
+                serialResults.getLastTime(), 1e-10);
+        CHECK_STORAGE_AGAINST_STANDARD(parallelResults, serialResults,
+                std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+                "Arm26 " + suffix + " in parallel failed.");
+    }
+}
+
+void testAnalyticConstraintMatrix() {
+    // The acceleration constraints computed from the moment arms and the
+    // mass matrix must match those computed by realizing the model once per
+    // actuator, for muscles and coordinate actuators.
+    Model model("arm26.osim");
+    auto* reserve = new CoordinateActuator("r_elbow_flex");
+    reserve->setName("r_elbow_flex_reserve");
+    reserve->setOptimalForce(10);
+    model.addForce(reserve);
+    SimTK::State& s = model.initSystem();
+    const auto& coordinates = model.getCoordinateSet();
+
+    // Desired speeds, from which the desired accelerations are computed.
+    Storage speeds;
+    Array<string> labels;
+    labels.append("time");
+    for (int i = 0; i < coordinates.getSize(); ++i) {
+        labels.append(coordinates[i].getSpeedName());
+    }
+    speeds.setColumnLabels(labels);
+    for (int i = 0; i < 20; ++i) {
+        const double time = 0.01 * i;
+        double y[2] = {std::sin(time), std::cos(2 * time)};
+        speeds.append(time, 2, y);
+    }
+
+    const Set<Actuator>& actuators = model.getActuators();
+    for (int i = 0; i < actuators.getSize(); ++i) {
+        dynamic_cast<const ScalarActuator&>(actuators[i])
+                .overrideActuation(s, true);
+    }
+    s.setTime(0.1);
+    coordinates.get("r_shoulder_elev").setValue(s, 0.3);
+    coordinates.get("r_elbow_flex").setValue(s, 1.2);
+    coordinates.get("r_shoulder_elev").setSpeedValue(s, 0.5);
+    coordinates.get("r_elbow_flex").setSpeedValue(s, -1.0);
+    model.realizeVelocity(s);
+
+    const int na = actuators.getSize();
+    const int nc = coordinates.getSize();
+    SimTK::Matrix jacobians[2];
+    SimTK::Vector constraints[2];
+    for (int analytic = 0; analytic < 2; ++analytic) {
+        StaticOptimizationTarget target(s, &model, na, nc, false);
+        target.setStatesStore(&speeds);
+        target.setStatesSplineSet(GCVSplineSet(5, &speeds));
+        target.setUseAnalyticConstraintMatrix(analytic == 1);
+        SimTK::Vector parameters(na, 0.5);
+        target.prepareToOptimize(s, &parameters[0]);
+        target.constraintJacobian(parameters, true, jacobians[analytic]);
+        constraints[analytic].resize(nc);
+        target.constraintFunc(parameters, true, constraints[analytic]);
+    }
+
+    ASSERT_EQUAL(jacobians[1].nrow(), nc);
+    ASSERT_EQUAL(jacobians[1].ncol(), na);
+    for (int c = 0; c < nc; ++c) {
+        for (int p = 0; p < na; ++p) {
+            const double expected = jacobians[0](c, p);
+            ASSERT_EQUAL(expected, jacobians[1](c, p),
+                    1e-8 * std::max(1.0, std::abs(expected)), __FILE__,
+                    __LINE__, "Analytic constraint matrix does not match.");
+        }
+        ASSERT_EQUAL(constraints[0][c], constraints[1][c],
+                1e-8 * std::max(1.0, std::abs(constraints[0][c])), __FILE__,
+                __LINE__, "Constraints do not match.");
+    }
+    // The reserve actuator only accelerates the elbow directly, through the
+    // mass matrix.
+    ASSERT(jacobians[1](1, na - 1) != 0);
+}
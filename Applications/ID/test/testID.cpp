@@ -39,6 +39,7 @@ using namespace std;
 
 void testThoracoscapularShoulderModel();
 void testBallJoint();
+void testTrajectorySolve();
 
 int main()
 {
@@ -72,6 +73,8 @@ int main()
 
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
+        testTrajectorySolve();
+        cout << "testTrajectorySolve passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
         // -Ayman 03/21
         //testBallJoint();
@@ -229,4 +232,50 @@ void testBallJoint() {
     ASSERT_THROW(Exception,
             ASSERT_EQUAL(idSolverVecZeroUDot, idToolVec, 1e-6, 
             __FILE__, __LINE__, "testThoracoscapularShoulderModel failed"));
-}
\ No newline at end of file
+}
+
+void testTrajectorySolve() {
+    Model model("arm26.osim");
+    SimTK::State& s = model.initSystem();
+    for (int i = 0; i < model.updMuscles().getSize(); ++i) {
+        model.updMuscles()[i].setAppliesForce(s, false);
+    }
+    const int nt = 75;
+    const int nq = s.getNQ();
+    const int nu = s.getNU();
+    SimTK::Vector times(nt);
+    SimTK::Matrix q(nt, nq), u(nt, nu), udot(nt, nu);
+    for (int i = 0; i < nt; ++i) {
+        times[i] = 0.01 * i;
+        for (int j = 0; j < nq; ++j) {
+            q(i, j) = 0.5 * sin(times[i] + j);
+            u(i, j) = 0.5 * cos(times[i] + j);
+            udot(i, j) = -0.5 * sin(times[i] + j);
+        }
+    }
+
+    InverseDynamicsSolver idSolver(model);
+    SimTK::Matrix serial;
+    idSolver.solve(s, times, q, u, udot, serial, 0);
+    SimTK::Matrix parallel(nt, nu);
+    idSolver.solve(s, times, q, u, udot, parallel, 3);
+    ASSERT(serial.nrow() == nt && serial.ncol() == nu);
+
+    for (int i = 0; i < nt; ++i) {
+        SimTK::State state(s);
+        state.setTime(times[i]);
+        state.updQ() = ~q[i];
+        state.updU() = ~u[i];
+        const SimTK::Vector expected =
+                idSolver.solve(state, SimTK::Vector(~udot[i]));
+        const SimTK::Vector serialRow(~serial[i]);
+        const SimTK::Vector parallelRow(~parallel[i]);
+        ASSERT_EQUAL(serialRow, expected, 1e-10, __FILE__, __LINE__,
+                "Trajectory solve does not match single-state solve.");
+        ASSERT_EQUAL(parallelRow, expected, 1e-10, __FILE__, __LINE__,
+                "Parallel trajectory solve does not match serial solve.");
+    }
+
+    ASSERT_THROW(Exception, idSolver.solve(s, times, q, u,
+            SimTK::Matrix(nt - 1, nu), parallel));
+}
@@ -106,6 +106,30 @@ int main()
         failures.push_back("testInverseKinematicsGait2354_GUI_workflow");
     }
 
+    try {
+        // Solving the frames in parallel chunks must reproduce the serial
+        // solution.
+        InverseKinematicsTool ikSerial("subject01_Setup_InverseKinematics.xml");
+        ikSerial.setOutputMotionFileName("subject01_walk1_ik_serial.mot");
+        ikSerial.run();
+        InverseKinematicsTool ikParallel(
+                "subject01_Setup_InverseKinematics.xml");
+        ikParallel.setOutputMotionFileName("subject01_walk1_ik_parallel.mot");
+        ikParallel.setParallel(3);
+        ikParallel.run();
+        Storage serial(ikSerial.getOutputMotionFileName());
+        Storage parallel(ikParallel.getOutputMotionFileName());
+        ASSERT(parallel.getSize() == serial.getSize());
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+            std::vector<double>(24, 0.01), __FILE__, __LINE__,
+            "testInverseKinematicsGait2354 parallel failed");
+        cout << "testInverseKinematicsGait2354 parallel passed" << endl;
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsGait2354_parallel");
+    }
+
     try {
         InverseKinematicsTool ik3("constraintTest_setup_ik.xml");
         ik3.run();
@@ -379,6 +379,7 @@ DATATABLE_CLONE(double, SimTK::Rotation_<double>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::Vec6>)
 %shared_ptr(OpenSim::STOFileAdapter_<SimTK::SpatialVec>)
 %shared_ptr(OpenSim::CSVFileAdapter)
+%shared_ptr(OpenSim::BinaryFileAdapter)
 %shared_ptr(OpenSim::TRCFileAdapter)
 %shared_ptr(OpenSim::C3DFileAdapter)
 %template(StdMapStringDataAdapter)
@@ -401,6 +402,7 @@ namespace OpenSim {
     %ignore TRCFileAdapter::TRCFileAdapter(TRCFileAdapter &&);
     %ignore DelimFileAdapter::DelimFileAdapter(DelimFileAdapter &&);
     %ignore CSVFileAdapter::CSVFileAdapter(CSVFileAdapter &&);
+    %ignore BinaryFileAdapter::BinaryFileAdapter(BinaryFileAdapter &&);
 }
 %include <OpenSim/Common/TRCFileAdapter.h>
 %include <OpenSim/Common/DelimFileAdapter.h>
@@ -418,6 +420,7 @@ namespace OpenSim {
 %template(STOFileAdapterSpatialVec) OpenSim::STOFileAdapter_<SimTK::SpatialVec>;
 
 %include <OpenSim/Common/CSVFileAdapter.h>
+%include <OpenSim/Common/BinaryFileAdapter.h>
 %include <OpenSim/Common/XsensDataReader.h>
 
 #if defined WITH_EZC3D || defined (WITH_BTK)
@@ -231,6 +231,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 %include <OpenSim/Simulation/OrientationsReference.h>
 %template (SetOientationWeights) OpenSim::Set<OrientationWeight, OpenSim::Object>;
 %shared_ptr(OpenSim::OrientationsReference);
+%include <OpenSim/Common/DataQueue.h>
 %include <OpenSim/Simulation/BufferedOrientationsReference.h>
 %shared_ptr(OpenSim::BufferedOrientationsReference);
 
@@ -80,6 +80,7 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_polynomial_approximation_tolerance(0.0);
 }
 
 void ActiveForceLengthCurve::buildCurve()
@@ -87,6 +88,8 @@ void ActiveForceLengthCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    m_curve.buildPiecewisePolynomial(
+            get_polynomial_approximation_tolerance());
     setObjectIsUpToDateWithProperties();
 }
 
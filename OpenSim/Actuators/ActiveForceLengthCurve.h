@@ -127,6 +127,10 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_PROPERTY(polynomial_approximation_tolerance, double,
+        "If positive, evaluate the curve from piecewise quintic polynomials "
+        "within this tolerance of it instead of from its Bezier curves "
+        "(default: 0)");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -77,6 +77,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_polynomial_approximation_tolerance(0.0);
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -93,6 +94,8 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
 
     m_curve = *f;
     delete f;
+    m_curve.buildPiecewisePolynomial(
+            get_polynomial_approximation_tolerance());
 
     setObjectIsUpToDateWithProperties();
 }
@@ -172,6 +172,10 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_PROPERTY(polynomial_approximation_tolerance, double,
+        "If positive, evaluate the curve from piecewise quintic polynomials "
+        "within this tolerance of it instead of from its Bezier curves "
+        "(default: 0)");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -82,6 +82,7 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_polynomial_approximation_tolerance(0.0);
 }
 
 void ForceVelocityCurve::buildCurve()
@@ -89,6 +90,8 @@ void ForceVelocityCurve::buildCurve()
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
     delete f;
+    m_curve.buildPiecewisePolynomial(
+            get_polynomial_approximation_tolerance());
     setObjectIsUpToDateWithProperties();
 }
 
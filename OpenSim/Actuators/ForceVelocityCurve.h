@@ -158,6 +158,10 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_PROPERTY(polynomial_approximation_tolerance, double,
+        "If positive, evaluate the curve from piecewise quintic polynomials "
+        "within this tolerance of it instead of from its Bezier curves "
+        "(default: 0)");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -21,8 +21,11 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 #include "Millard2012EquilibriumMuscle.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <exception>
+
 using namespace std;
 using namespace OpenSim;
 using namespace SimTK;
@@ -547,47 +550,116 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
 
     // Compute the fiber length where the fiber and tendon are in static
     // equilibrium. Fiber and tendon velocity are set to zero.
-
-    // tol is the desired tolerance in Newtons.
-    const double tol = max(1e-8*getMaxIsometricForce(), SimTK::SignificantReal*10);
-
-    int maxIter = 200;
     double pathLength = getLength(s);
     double pathSpeed = solveForVelocity ? getLengtheningSpeed(s) : 0;
     double activation = getActivation(s);
 
+    // Start from the fiber length in the state, which is usually close to
+    // equilibrium when equilibrating repeatedly (e.g., at each time of a
+    // trajectory).
+    applyFiberEquilibrium(s,
+            solveFiberEquilibrium(activation, pathLength, pathSpeed,
+                    getStateVariableValue(s, STATE_FIBER_LENGTH_NAME),
+                    solveForVelocity),
+            activation);
+}
+
+void Millard2012EquilibriumMuscle::computeFiberEquilibria(SimTK::State& s,
+        const std::vector<const Millard2012EquilibriumMuscle*>& muscles,
+        bool solveForVelocity, int parallel)
+{
+    OPENSIM_THROW_IF(parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", parallel);
+    std::vector<const Millard2012EquilibriumMuscle*> compliant;
+    for (const auto* muscle : muscles) {
+        if (!muscle->get_ignore_tendon_compliance()) {
+            compliant.push_back(muscle);
+        }
+    }
+    const int numMuscles = (int)compliant.size();
+    if (!numMuscles) return;
+    compliant[0]->getModel().getMultibodySystem().realize(
+            s, SimTK::Stage::Velocity);
+
+    // Gather the inputs of all muscles.
+    std::vector<double> activations(numMuscles);
+    std::vector<double> pathLengths(numMuscles);
+    std::vector<double> pathSpeeds(numMuscles, 0.0);
+    std::vector<double> fiberLengths(numMuscles);
+    for (int i = 0; i < numMuscles; ++i) {
+        const Millard2012EquilibriumMuscle& muscle = *compliant[i];
+        activations[i] = muscle.getActivation(s);
+        pathLengths[i] = muscle.getLength(s);
+        if (solveForVelocity) pathSpeeds[i] = muscle.getLengtheningSpeed(s);
+        fiberLengths[i] = muscle.getStateVariableValue(
+                s, STATE_FIBER_LENGTH_NAME);
+    }
+
+    // Solve the equilibria, in contiguous chunks of muscles per thread.
+    using Result = std::pair<StatusFromEstimateMuscleFiberState,
+                             ValuesFromEstimateMuscleFiberState>;
+    std::vector<Result> results(numMuscles);
+    std::vector<std::exception_ptr> errors(numMuscles);
+    // A thread only pays off if it has enough muscles to solve.
+    const int minMusclesPerThread = 8;
+    const int numThreads = getNumThreadsForParallel(
+            parallel, numMuscles, minMusclesPerThread);
+    runInContiguousChunks(numMuscles, numThreads,
+            [&](int, int first, int last) {
+        for (int i = first; i < last; ++i) {
+            try {
+                results[i] = compliant[i]->solveFiberEquilibrium(
+                        activations[i], pathLengths[i], pathSpeeds[i],
+                        fiberLengths[i], solveForVelocity);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    });
+
+    // Set the fiber lengths; the first failure is rethrown after the other
+    // muscles are equilibrated.
+    std::exception_ptr firstError;
+    for (int i = 0; i < numMuscles; ++i) {
+        try {
+            if (errors[i]) std::rethrow_exception(errors[i]);
+            compliant[i]->applyFiberEquilibrium(s, results[i], activations[i]);
+        } catch (...) {
+            if (!firstError) firstError = std::current_exception();
+        }
+    }
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+namespace {
+// The tolerance (in Newtons) and maximum number of Newton iterations of the
+// fiber equilibrium.
+double getFiberEquilibriumTolerance(double maxIsometricForce) {
+    return max(1e-8*maxIsometricForce, SimTK::SignificantReal*10);
+}
+const int maxFiberEquilibriumIterations = 200;
+} // anonymous namespace
+
+std::pair<Millard2012EquilibriumMuscle::StatusFromEstimateMuscleFiberState,
+          Millard2012EquilibriumMuscle::ValuesFromEstimateMuscleFiberState>
+Millard2012EquilibriumMuscle::solveFiberEquilibrium(double activation,
+        double pathLength, double pathLengtheningSpeed,
+        double initialFiberLength, bool solveForVelocity) const
+{
+    const double tol = getFiberEquilibriumTolerance(getMaxIsometricForce());
     try {
-        std::pair<StatusFromEstimateMuscleFiberState,
-                  ValuesFromEstimateMuscleFiberState> result =
-            estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
-
-        switch(result.first) {
-
-        case StatusFromEstimateMuscleFiberState::Success_Converged:
-            setActuation(s, result.second["tendon_force"]);
-            setFiberLength(s, result.second["fiber_length"]);
-            break;
-
-        case StatusFromEstimateMuscleFiberState::Warning_FiberAtLowerBound:
-            log_warn("Millard2012EquilibriumMuscle static solution: '{}' is "
-                   "at its minimum fiber length of {}.",
-                   getName(), result.second["fiber_length"]);
-            setActuation(s, result.second["tendon_force"]);
-            setFiberLength(s, result.second["fiber_length"]);
-            break;
-
-        case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
-            // Report internal variables and throw exception.
-            std::ostringstream ss;
-            ss << "\n  Solution error " << abs(result.second["solution_error"])
-               << " exceeds tolerance of " << tol << "\n"
-               << "  Newton iterations reached limit of " << maxIter << "\n"
-               << "  Activation is " << activation << "\n"
-               << "  Fiber length is " << result.second["fiber_length"] << "\n";
-            OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
-            break;
+        if (initialFiberLength > 0) {
+            auto result = estimateMuscleFiberState(activation, pathLength,
+                    pathLengtheningSpeed, tol, maxFiberEquilibriumIterations,
+                    solveForVelocity, initialFiberLength);
+            if (result.first ==
+                    StatusFromEstimateMuscleFiberState::Success_Converged) {
+                return result;
+            }
         }
+        return estimateMuscleFiberState(activation, pathLength,
+                pathLengtheningSpeed, tol, maxFiberEquilibriumIterations,
+                solveForVelocity);
 
     } catch (const std::exception& x) {
         OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate,
@@ -595,6 +667,42 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
     }
 }
 
+void Millard2012EquilibriumMuscle::applyFiberEquilibrium(SimTK::State& s,
+        const std::pair<StatusFromEstimateMuscleFiberState,
+                        ValuesFromEstimateMuscleFiberState>& result,
+        double activation) const
+{
+    ValuesFromEstimateMuscleFiberState values = result.second;
+    switch(result.first) {
+
+    case StatusFromEstimateMuscleFiberState::Success_Converged:
+        setActuation(s, values["tendon_force"]);
+        setFiberLength(s, values["fiber_length"]);
+        break;
+
+    case StatusFromEstimateMuscleFiberState::Warning_FiberAtLowerBound:
+        log_warn("Millard2012EquilibriumMuscle static solution: '{}' is "
+               "at its minimum fiber length of {}.",
+               getName(), values["fiber_length"]);
+        setActuation(s, values["tendon_force"]);
+        setFiberLength(s, values["fiber_length"]);
+        break;
+
+    case StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached:
+        // Report internal variables and throw exception.
+        std::ostringstream ss;
+        ss << "\n  Solution error " << abs(values["solution_error"])
+           << " exceeds tolerance of "
+           << getFiberEquilibriumTolerance(getMaxIsometricForce()) << "\n"
+           << "  Newton iterations reached limit of "
+           << maxFiberEquilibriumIterations << "\n"
+           << "  Activation is " << activation << "\n"
+           << "  Fiber length is " << values["fiber_length"] << "\n";
+        OPENSIM_THROW_FRMOBJ(MuscleCannotEquilibrate, ss.str());
+        break;
+    }
+}
+
 //==============================================================================
 // SCALING
 //==============================================================================
@@ -1364,7 +1472,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double initialFiberLength) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1393,7 +1502,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-    double lce = clampFiberLength(getPennationModel().calcFiberLength(ml,tl));
+    double lce = clampFiberLength(initialFiberLength > 0 ? initialFiberLength
+            : getPennationModel().calcFiberLength(ml,tl));
 
     double phi = 0.0;
     double cosphi = 1.0;
@@ -442,6 +442,27 @@ public:
     void computeFiberEquilibrium(SimTK::State& s, 
                                  bool solveForVelocity = false) const;
 
+    /** Computes the fiber equilibrium of each of the given muscles, as
+        computeFiberEquilibrium() does, for muscles that share a state (e.g.,
+        all Millard2012EquilibriumMuscles of a model). The activations and
+        path lengths and speeds of all muscles are gathered from the state
+        first, the equilibria are then solved independently of the state
+        (on multiple threads, if requested), and the fiber lengths are finally
+        set in the state.
+        @param[in,out] s         The state of the system.
+        @param muscles           The muscles, all in the model of the state.
+        @param solveForVelocity  Flag indicating to solve for fiber velocity,
+                                 as in computeFiberEquilibrium()
+        @param parallel          0 to solve the equilibria serially (default),
+                                 1 to use a thread per core, or the number of
+                                 threads
+        @throws MuscleCannotEquilibrate for the first muscle that could not be
+                equilibrated, after setting the fiber lengths of the others
+    */
+    static void computeFiberEquilibria(SimTK::State& s,
+            const std::vector<const Millard2012EquilibriumMuscle*>& muscles,
+            bool solveForVelocity = false, int parallel = 0);
+
 //==============================================================================
 // DEPRECATED
 //==============================================================================
@@ -759,6 +780,10 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param initialFiberLength the fiber length to start the Newton iterations
+           from (e.g., the previous solution); if it is not positive (or is
+           NaN), the iterations start from the fiber length for which the
+           tendon is stretched 1% beyond its slack length
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +792,28 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double initialFiberLength=SimTK::NaN) const;
+
+    /* Calls estimateMuscleFiberState(), starting from the given fiber length
+    (the fiber length in the state, when equilibrating a state) and, if that
+    does not converge, from the default initial fiber length. Exceptions are
+    rethrown as MuscleCannotEquilibrate. Does not use the state, so the
+    equilibria of different muscles can be solved concurrently. */
+    std::pair<StatusFromEstimateMuscleFiberState,
+              ValuesFromEstimateMuscleFiberState>
+        solveFiberEquilibrium(double activation, double pathLength,
+                              double pathLengtheningSpeed,
+                              double initialFiberLength,
+                              bool solveForVelocity) const;
+
+    /* Sets the tendon force and fiber length from the result of
+    solveFiberEquilibrium(), or throws MuscleCannotEquilibrate if it did not
+    converge. */
+    void applyFiberEquilibrium(SimTK::State& s,
+            const std::pair<StatusFromEstimateMuscleFiberState,
+                            ValuesFromEstimateMuscleFiberState>& result,
+            double activation) const;
 
 };
 } //end of namespace OpenSim
@@ -158,6 +158,10 @@ public:
         "Normalized force developed at the end of the toe region");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Tendon curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_PROPERTY(polynomial_approximation_tolerance, double,
+        "If positive, evaluate the curve from piecewise quintic polynomials "
+        "within this tolerance of it instead of from its Bezier curves "
+        "(default: 0)");
 
 //==============================================================================
 // PUBLIC METHODS
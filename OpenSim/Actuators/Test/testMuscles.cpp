@@ -901,6 +901,47 @@ void testMillard2012EquilibriumMuscle()
         muscle->computeInitialFiberEquilibrium(state);
     }
 
+    // Solving the equilibria of many muscles together (on multiple threads)
+    // must agree with solving them one at a time.
+    {
+        Model model;
+        std::vector<const Millard2012EquilibriumMuscle*> muscles;
+        for (int i = 0; i < 24; ++i) {
+            auto muscle = new Millard2012EquilibriumMuscle(
+                    "muscle" + std::to_string(i), 100. + 10 * i,
+                    0.1, 0.2, 0.02 * (i % 5));
+            muscle->addNewPathPoint("p1", model.updGround(), SimTK::Vec3(0));
+            muscle->addNewPathPoint("p2", model.updGround(),
+                    SimTK::Vec3(0, 0, 0.25 + 0.005 * i));
+            model.addForce(muscle);
+            muscles.push_back(muscle);
+        }
+        SimTK::State& state = model.initSystem();
+        for (int i = 0; i < (int)muscles.size(); ++i) {
+            muscles[i]->setActivation(state, 0.05 + 0.035 * i);
+        }
+        SimTK::State serialState = state;
+        for (const auto* muscle : muscles) {
+            muscle->computeFiberEquilibrium(serialState);
+        }
+        Millard2012EquilibriumMuscle::computeFiberEquilibria(
+                state, muscles, false, 4);
+        model.realizeDynamics(state);
+        model.realizeDynamics(serialState);
+        for (const auto* muscle : muscles) {
+            const double tol = 1e-6 * muscle->getMaxIsometricForce();
+            ASSERT_EQUAL(muscle->getFiberLength(serialState),
+                    muscle->getFiberLength(state), 1e-8);
+            ASSERT_EQUAL(muscle->getTendonForce(state),
+                    muscle->getFiberForceAlongTendon(state), tol);
+        }
+
+        // Starting from the previous equilibrium gives the same equilibrium.
+        const double fiberLength = muscles[0]->getFiberLength(state);
+        muscles[0]->computeFiberEquilibrium(state);
+        ASSERT_EQUAL(fiberLength, muscles[0]->getFiberLength(state), 1e-8);
+    }
+
     // Test exception handling when invalid properties are propagated to
     // MuscleFixedWidthPennationModel and MuscleFirstOrderActivationDynamicModel
     // subcomponents.
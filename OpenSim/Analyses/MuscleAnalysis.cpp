@@ -203,6 +203,8 @@ void MuscleAnalysis::allocateStorageObjects()
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    // Created again in record() since it holds a copy of the model's state.
+    _momentArmSolver.reset();
 
     // FOR MOMENT ARMS AND MOMENTS
     if(_computeMoments) {
@@ -640,24 +642,32 @@ int MuscleAnalysis::record(const SimTK::State& s)
     _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
 
     if (_computeMoments){
-        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
+        // COMPUTE THE MOMENT ARMS OF ALL MUSCLES ABOUT ALL COORDINATES AT ONCE
+        if (!_momentArmSolver)
+            _momentArmSolver.reset(new MomentArmSolver(*_model));
+        SimTK::Array_<const Coordinate*> coordinates(nq);
+        for(int i=0; i<nq; i++)
+            coordinates[i] = _momentArmStorageArray[i]->q;
+        SimTK::Array_<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++)
+            paths[j] = &_muscleArray[j]->getGeometryPath();
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        _momentArmSolver->solve(s, coordinates, paths, _momentArms);
+
+        // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
         for(int i=0; i<nq; i++) {
 
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = _momentArms(j, i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
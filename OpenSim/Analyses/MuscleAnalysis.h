@@ -30,6 +30,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -141,6 +142,13 @@ private:
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
 
+#ifndef SWIG
+    /** Solver for the moment arms of all muscles about all coordinates. */
+    std::unique_ptr<MomentArmSolver> _momentArmSolver;
+#endif
+    /** Work matrix of moment arms (muscles x coordinates). */
+    SimTK::Matrix _momentArms;
+
 //=============================================================================
 // METHODS
 //=============================================================================
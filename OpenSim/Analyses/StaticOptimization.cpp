@@ -25,6 +25,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -61,6 +62,7 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _parallel(_parallelProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +84,7 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _parallel(_parallelProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +117,7 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _parallel=aStaticOptimization._parallel;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,7 +142,13 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _parallel = 0;
     _forceReporter = nullptr;
+
+    // IPOPT
+    _numericalDerivativeStepSize = 0.0001;
+    _optimizerAlgorithm = "ipopt";
+    _printLevel = 0;
     setName("StaticOptimization");
 }
 //_____________________________________________________________________________
@@ -173,6 +183,14 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _parallelProp.setComment(
+        "Number of threads used to solve the optimization problems of "
+        "different time frames: 0 (default) to solve serially, 1 to use all "
+        "cores, or N > 1 to use N threads. When solving in parallel, "
+        "results are only available once the analysis has ended.");
+    _parallelProp.setName("parallel");
+    _propertySet.append(&_parallelProp);
 }
 
 //=============================================================================
@@ -316,24 +334,39 @@ record(const SimTK::State& s)
     sWorkingCopy.setQ(s.getQ());
     sWorkingCopy.setU(s.getU());
 
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
+    solveFrame(*_modelWorkingCopy, sWorkingCopy, _parameters,
+            *_activationStorage, *_forceReporter);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Solve the optimization problem for one time frame, and append the
+ * activations and forces to the given storages.
+ *
+ * @param model Working copy of the model. The default activations of its
+ * muscles are set to the solution, to warm start the next frame.
+ * @param sWorkingCopy State of the model, with the time, Q's, and U's of the
+ * frame.
+ * @param parameters Solution (activations or controls) on return.
+ */
+void StaticOptimization::
+solveFrame(Model& model, SimTK::State& sWorkingCopy,
+        SimTK::Vector& parameters, Storage& activationStorage,
+        ForceReporter& forceReporter) const
+{
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
 
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& fs = model.getActuators();
+    ForceSet& forceSet = model.updForceSet();
 
     int na = fs.getSize();
     int nacc = _accelerationIndices.getSize();
 
-    // IPOPT
-    _numericalDerivativeStepSize = 0.0001;
-    _optimizerAlgorithm = "ipopt";
-    _printLevel = 0;
-    //_optimizationConvergenceTolerance = 1e-004;
-    //_maxIterations = 2000;
-
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    model.setAllControllersEnabled(false);
+    StaticOptimizationTarget target(sWorkingCopy,&model,na,nacc,_useMusclePhysiology);
     target.setStatesStore(_statesStore);
     target.setStatesSplineSet(_statesSplineSet);
     target.setActivationExponent(_activationExponent);
@@ -376,11 +409,11 @@ record(const SimTK::State& s)
     
     target.setParameterLimits(lowerBounds, upperBounds);
 
-    _parameters = 0; // Set initial guess to zeros
+    parameters = 0; // Set initial guess to zeros
 
     // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
 
     //LARGE_INTEGER start;
     //LARGE_INTEGER stop;
@@ -391,24 +424,24 @@ record(const SimTK::State& s)
 
     try {
         target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        optimizer->optimize(parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
         log_warn(ex.getMessage());
         log_warn("OPTIMIZATION FAILED...");
         log_warn("StaticOptimization.record: The optimizer could not find a "
                  "solution at time = {}.",
-                s.getTime());
+                sWorkingCopy.getTime());
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            Actuator* act = dynamic_cast<Actuator*>(&forceSet.get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                Muscle*  mus = dynamic_cast<Muscle*>(&forceSet.get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -417,7 +450,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -428,7 +461,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -448,9 +481,9 @@ record(const SimTK::State& s)
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -465,7 +498,7 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
+            forceReporter.step(sWorkingCopy, 1);
             if(incompleteModel) log_warn(msgIncomplete);
         }
     }
@@ -475,27 +508,118 @@ record(const SimTK::State& s)
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
     if (Logger::shouldLog(Logger::Level::Info)) {
-        target.printPerformance(sWorkingCopy, &_parameters[0]);
+        target.printPerformance(sWorkingCopy, &parameters[0]);
     }
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& actuators = model.getActuators();
     for(int k=0; k < actuators.getSize(); ++k){
         ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
+    activationStorage.append(sWorkingCopy.getTime(),na,&parameters[0]);
 
     SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
+    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), parameters,forces);
 
-    _forceReporter->step(sWorkingCopy, 1);
+    forceReporter.step(sWorkingCopy, 1);
 
-    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Save the time, Q's, and U's of a frame to be solved by solveSavedFrames().
+ */
+void StaticOptimization::
+saveFrame(const SimTK::State& s)
+{
+    _frameTimes.push_back(s.getTime());
+    _frameQs.push_back(s.getQ());
+    _frameUs.push_back(s.getU());
+}
+//_____________________________________________________________________________
+/**
+ * Solve the frames saved by step() and end() when solving in parallel. The
+ * frames are split into contiguous chunks, one per thread, and each thread
+ * solves its chunk in order with its own copy of the model. Each frame is
+ * warm started from the previous frame of its chunk, and the first frame of
+ * each chunk from the last frame solved by record(). The results are
+ * appended to the activation and force storages in order.
+ */
+void StaticOptimization::
+solveSavedFrames()
+{
+    const int nt = (int)_frameTimes.size();
+    if(nt == 0 || !_modelWorkingCopy) return;
+
+    // Each thread copies the model, which only pays off if the thread has
+    // enough frames to solve.
+    const int minFramesPerThread = 5;
+    const int numThreads =
+            getNumThreadsForParallel(_parallel, nt, minFramesPerThread);
+
+    // Copying and initializing the models is not thread-safe, so it is done
+    // up front.
+    std::vector<std::unique_ptr<Model>> models;
+    std::vector<std::unique_ptr<ForceReporter>> forceReporters;
+    std::vector<std::unique_ptr<Storage>> activationStorages;
+    for(int ithread = 0; ithread < numThreads; ++ithread) {
+        models.emplace_back(_modelWorkingCopy->clone());
+        Model& model = *models.back();
+        SimTK::State& sWorkingCopy = model.initSystem();
+        const ForceSet& forceSet = model.getForceSet();
+        for(int i=0; i<forceSet.getSize(); i++) {
+            const ScalarActuator* act =
+                    dynamic_cast<const ScalarActuator*>(&forceSet.get(i));
+            if( act ) {
+                act->overrideActuation(sWorkingCopy, true);
+            }
+        }
+        forceReporters.emplace_back(new ForceReporter(&model));
+        forceReporters.back()->begin(sWorkingCopy);
+        forceReporters.back()->updForceStorage().reset();
+        activationStorages.emplace_back(
+                new Storage(*_activationStorage, false));
+    }
+
+    std::vector<SimTK::Vector> parameters(numThreads, _parameters);
+    // The saved frames are consumed even if solving them fails.
+    std::vector<double> frameTimes;
+    std::vector<SimTK::Vector> frameQs, frameUs;
+    frameTimes.swap(_frameTimes);
+    frameQs.swap(_frameQs);
+    frameUs.swap(_frameUs);
+    runInContiguousChunks(nt, numThreads,
+            [&](int ithread, int first, int last) {
+        Model& model = *models[ithread];
+        for(int i = first; i < last; ++i) {
+            SimTK::State& sWorkingCopy = model.updWorkingState();
+            sWorkingCopy.setTime(frameTimes[i]);
+            model.initStateWithoutRecreatingSystem(sWorkingCopy);
+            sWorkingCopy.setQ(frameQs[i]);
+            sWorkingCopy.setU(frameUs[i]);
+            solveFrame(model, sWorkingCopy, parameters[ithread],
+                    *activationStorages[ithread],
+                    *forceReporters[ithread]);
+        }
+    });
+
+    // Merge the results in order.
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(int ithread = 0; ithread < numThreads; ++ithread) {
+        const Storage& activations = *activationStorages[ithread];
+        for(int i = 0; i < activations.getSize(); ++i) {
+            _activationStorage->append(*activations.getStateVector(i));
+        }
+        const Storage& forces = forceReporters[ithread]->getForceStorage();
+        for(int i = 0; i < forces.getSize(); ++i) {
+            forceStorage.append(*forces.getStateVector(i));
+        }
+    }
+    _parameters = parameters.back();
 }
 //_____________________________________________________________________________
 /**
@@ -595,6 +719,9 @@ int StaticOptimization::begin(const SimTK::State& s )
     }
 
     _statesSplineSet=GCVSplineSet(5,_statesStore);
+    _frameTimes.clear();
+    _frameQs.clear();
+    _frameUs.clear();
 
     // DESCRIPTION AND LABELS
     constructDescription();
@@ -646,7 +773,8 @@ int StaticOptimization::step(const SimTK::State& s, int stepNumber )
 {
     if(!proceed(stepNumber)) return(0);
 
-    record(s);
+    if(_parallel) saveFrame(s);
+    else record(s);
 
     return(0);
 }
@@ -663,7 +791,12 @@ int StaticOptimization::end( const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
-    record(s);
+    if(_parallel) {
+        saveFrame(s);
+        solveSavedFrames();
+    } else {
+        record(s);
+    }
 
     return(0);
 }
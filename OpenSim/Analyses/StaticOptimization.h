@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -46,6 +47,12 @@ class ForceSet;
  * This class implements static optimization to compute Muscle Forces and 
  * activations. 
  *
+ * The optimization problems of different time frames are independent, except
+ * that each is warm started from the solution of the previous frame. With
+ * the parallel property, the frames are split into contiguous chunks that
+ * are solved concurrently, each with its own copy of the model, with warm
+ * starts within each chunk.
+ *
  * @author Jeff Reinbolt
  */
 class OSIMANALYSES_API StaticOptimization : public Analysis {
@@ -76,6 +83,9 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    PropertyInt _parallelProp;
+    int &_parallel;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -93,6 +103,12 @@ protected:
 
     Model *_modelWorkingCopy;
 
+    // Frames saved by step() and end() to be solved together when solving in
+    // parallel.
+    std::vector<double> _frameTimes;
+    std::vector<SimTK::Vector> _frameQs;
+    std::vector<SimTK::Vector> _frameUs;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -114,6 +130,11 @@ private:
     void constructColumnLabels();
     void allocateStorage();
     void deleteStorage();
+    void solveFrame(Model& model, SimTK::State& sWorkingCopy,
+            SimTK::Vector& parameters, Storage& activationStorage,
+            ForceReporter& forceReporter) const;
+    void saveFrame(const SimTK::State& s);
+    void solveSavedFrames();
 
 public:
     //--------------------------------------------------------------------------
@@ -135,6 +156,12 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** Number of threads used to solve the optimization problems of
+    different time frames: 0 (default) to solve them serially, 1 to use all
+    cores, or N > 1 to use N threads. When solving in parallel, step() only
+    saves the frame, and the frames are solved by end(). */
+    void setParallel(int parallel) { _parallel = parallel; }
+    int getParallel() const { return _parallel; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
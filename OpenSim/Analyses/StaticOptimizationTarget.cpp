@@ -30,6 +30,8 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 
 using namespace OpenSim;
@@ -65,6 +67,7 @@ StaticOptimizationTarget(const SimTK::State& s, Model *aModel,int aNP,int aNC, b
     _recipOptForceSquared.setSize(aNP);
     _optimalForce.setSize(aNP);
     _useMusclePhysiology=useMusclePhysiology;
+    _useAnalyticConstraintMatrix=true;
 
     setModel(*aModel);
     setNumParams(aNP);
@@ -127,7 +130,13 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
+    // Columns that could not be computed analytically are computed by
+    // perturbing the parameters.
+    std::vector<bool> computed(np, false);
+    if(_useAnalyticConstraintMatrix) computeConstraintMatrix(s, computed);
+
     for(int p=0; p<np; p++) {
+        if(computed[p]) continue;
         pVector[p] = 1;
         computeConstraintVector(s, pVector, cVector);
         for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
@@ -138,6 +147,70 @@ prepareToOptimize(SimTK::State& s, double *x)
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//______________________________________________________________________________
+/**
+ * Compute the columns of the linear constraint matrix of the actuators whose
+ * generalized forces are known explicitly (muscles, through their paths, and
+ * coordinate actuators), without realizing the model to Acceleration. The
+ * generalized forces of each actuator at its optimal force (the moment arms
+ * times the optimal force, for muscles) are mapped to accelerations with a
+ * single O(n) solve with the mass matrix. This requires that the model has
+ * no constraints, since the accelerations would otherwise also depend on
+ * the constraint forces; in that case, no columns are computed.
+ *
+ * @param s State realized to Velocity.
+ * @param computed Set to true for each column that was computed.
+ */
+void StaticOptimizationTarget::
+computeConstraintMatrix(const SimTK::State& s, std::vector<bool>& computed)
+{
+    if(s.getNMultipliers() > 0) return;
+
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    const int nu = s.getNU();
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies());
+    SimTK::Vector mobilityForces(nu);
+    SimTK::Vector generalizedForces(nu);
+    SimTK::Vector udot(nu);
+
+    const ForceSet& fs = _model->getForceSet();
+    for(int i=0,j=0;i<fs.getSize();i++) {
+        const ScalarActuator* act =
+                dynamic_cast<const ScalarActuator*>(&fs.get(i));
+        if(!act) continue;
+        const int p = j++;
+
+        bodyForces.setToZero();
+        mobilityForces = 0;
+        if(!act->appliesForce(s)) {
+            // Disabled actuators do not affect the accelerations.
+        } else if(const auto* mus = dynamic_cast<const Muscle*>(act)) {
+            mus->getGeometryPath().addInEquivalentForces(
+                    s, _optimalForce[p], bodyForces, mobilityForces);
+        } else if(const auto* ca =
+                dynamic_cast<const CoordinateActuator*>(act)) {
+            const Coordinate* coord = ca->getCoordinate();
+            if(!coord) continue;
+            matter.addInMobilityForce(s, coord->getBodyIndex(),
+                    SimTK::MobilizerUIndex(coord->getMobilizerQIndex()),
+                    _optimalForce[p], mobilityForces);
+        } else {
+            continue;
+        }
+
+        // f = ~J(q) * F, plus the mobility forces.
+        matter.multiplyBySystemJacobianTranspose(
+                s, bodyForces, generalizedForces);
+        generalizedForces += mobilityForces;
+        matter.multiplyByMInv(s, generalizedForces, udot);
+
+        // The constraints are the desired minus the actual accelerations.
+        for(int c=0; c<getNumConstraints(); c++) {
+            _constraintMatrix(c,p) = -udot[_accelerationIndices[c]];
+        }
+        computed[p] = true;
+    }
+}
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -30,6 +30,7 @@
 #include "OpenSim/Common/Array.h"
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <simmath/Optimizer.h>
+#include <vector>
 
 //=============================================================================
 //=============================================================================
@@ -71,6 +72,7 @@ private:
 protected:
     double _activationExponent;
     bool   _useMusclePhysiology;
+    bool   _useAnalyticConstraintMatrix;
     /** Perturbation size for computing numerical derivatives. */
     Array<double> _dx;
     Array<int> _accelerationIndices;
@@ -94,6 +96,14 @@ public:
     void getActuation(SimTK::State& s, const SimTK::Vector &parameters, SimTK::Vector &forces);
     void setActivationExponent(double aActivationExponent) { _activationExponent=aActivationExponent; }
     double getActivationExponent() const { return _activationExponent; }
+    /** If true (the default), prepareToOptimize() computes the columns of
+    the (linear) acceleration constraints for muscles and coordinate
+    actuators from their moment arms and the mass matrix, instead of
+    realizing the model to Acceleration once per actuator. This requires a
+    model without constraints; otherwise, or for other actuators, the
+    columns are computed by perturbation. */
+    void setUseAnalyticConstraintMatrix(bool useIt) { _useAnalyticConstraintMatrix = useIt; }
+    bool getUseAnalyticConstraintMatrix() const { return _useAnalyticConstraintMatrix; }
     void setCurrentState( const SimTK::State* state) { _currentState = state; }
     const SimTK::State* getCurrentState() const { return _currentState; }
 
@@ -122,6 +132,7 @@ public:
     int constraintJacobian(const SimTK::Vector &x, bool new_coefficients, SimTK::Matrix &jac) const override;
 
 private:
+    void computeConstraintMatrix(const SimTK::State& s, std::vector<bool>& computed);
     void computeConstraintVector(SimTK::State& s, const SimTK::Vector &x, SimTK::Vector &c) const;
     void computeAcceleration(SimTK::State& s, const SimTK::Vector &aF,SimTK::Vector &rAccel) const;
     void cumulativeTime(double &aTime, double aIncrement);
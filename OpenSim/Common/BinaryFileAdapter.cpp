@@ -0,0 +1,482 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  BinaryFileAdapter.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryFileAdapter.h"
+
+#include "MemoryMappedFile.h"
+#include "STOFileAdapter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+using namespace OpenSim;
+
+namespace {
+
+const char magic[8] = {'O', 'S', 'I', 'M', 'S', 'T', 'B', '\0'};
+const std::uint32_t formatVersion = 1;
+const std::uint32_t byteOrderMark = 0x01020304;
+
+/// Codes for the type of the values of a metadata entry.
+enum MetaDataType : std::uint8_t {
+    MetaDataString = 0,
+    MetaDataDouble = 1,
+    MetaDataInt = 2,
+    MetaDataUnsignedInt = 3,
+    MetaDataBool = 4
+};
+
+std::uint64_t alignTo8(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t(7);
+}
+
+// Writing
+// -------
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeValue(std::ostream& out, const std::string& value) {
+    writeValue(out, static_cast<std::uint32_t>(value.size()));
+    out.write(value.data(), value.size());
+}
+
+void writeValue(std::ostream& out, const bool& value) {
+    writeValue(out, static_cast<std::uint8_t>(value));
+}
+
+template <typename T>
+bool writeValues(std::ostream& out, const AbstractValueArray& absArray,
+        MetaDataType type) {
+    auto* array = dynamic_cast<const ValueArray<T>*>(&absArray);
+    if (!array) return false;
+    writeValue(out, static_cast<std::uint8_t>(type));
+    writeValue(out, static_cast<std::uint32_t>(array->size()));
+    for (const auto& value : array->get()) writeValue(out, value.get());
+    return true;
+}
+
+void writeMetaData(std::ostream& out, const ValueArrayDictionary& metaData) {
+    const auto keys = metaData.getKeys();
+    writeValue(out, static_cast<std::uint32_t>(keys.size()));
+    for (const auto& key : keys) {
+        writeValue(out, key);
+        const auto& absArray = metaData.getValueArrayForKey(key);
+        if (writeValues<std::string>(out, absArray, MetaDataString)) continue;
+        if (writeValues<double>(out, absArray, MetaDataDouble)) continue;
+        if (writeValues<int>(out, absArray, MetaDataInt)) continue;
+        if (writeValues<unsigned int>(out, absArray, MetaDataUnsignedInt))
+            continue;
+        if (writeValues<bool>(out, absArray, MetaDataBool)) continue;
+        // Store any other type as strings.
+        writeValue(out, static_cast<std::uint8_t>(MetaDataString));
+        writeValue(out, static_cast<std::uint32_t>(absArray.size()));
+        for (size_t i = 0; i < absArray.size(); ++i) {
+            writeValue(out, absArray.toString(i));
+        }
+    }
+}
+
+template <typename T>
+bool writeTable(const AbstractDataTable* absTable,
+        const std::string& fileName) {
+    auto* table = dynamic_cast<const TimeSeriesTable_<T>*>(absTable);
+    if (!table) return false;
+
+    static_assert(sizeof(T) % sizeof(double) == 0,
+            "Element type must consist of doubles.");
+    const std::uint32_t numComponents = sizeof(T) / sizeof(double);
+    const std::uint64_t numRows = table->getNumRows();
+    const std::uint64_t numColumns = table->getNumColumns();
+
+    std::ofstream out{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            "Could not open file '" + fileName + "' for writing.");
+
+    out.write(magic, sizeof(magic));
+    writeValue(out, formatVersion);
+    writeValue(out, byteOrderMark);
+    writeValue(out, numRows);
+    writeValue(out, numColumns);
+    writeValue(out, numComponents);
+    writeValue(out, STOFileAdapter_<T>::dataTypeName());
+    writeMetaData(out, table->getTableMetaData());
+    writeMetaData(out, table->getIndependentMetaData());
+    writeMetaData(out, table->getDependentsMetaData());
+
+    // Align the data so that it can be read in place.
+    const std::uint64_t headerSize = static_cast<std::uint64_t>(out.tellp());
+    const char padding[8] = {};
+    out.write(padding, alignTo8(headerSize) - headerSize);
+
+    const auto& times = table->getIndependentColumn();
+    if (numRows) {
+        out.write(reinterpret_cast<const char*>(times.data()),
+                numRows * sizeof(double));
+    }
+    std::vector<T> column(numRows);
+    for (std::uint64_t icol = 0; icol < numColumns; ++icol) {
+        const auto values = table->getDependentColumnAtIndex(icol);
+        for (std::uint64_t irow = 0; irow < numRows; ++irow) {
+            column[irow] = values[static_cast<int>(irow)];
+        }
+        if (numRows) {
+            out.write(reinterpret_cast<const char*>(column.data()),
+                    numRows * sizeof(T));
+        }
+    }
+    OPENSIM_THROW_IF(!out.good(), IOError,
+            "Error writing file '" + fileName + "'.");
+    return true;
+}
+
+// Reading
+// -------
+/// Reads values sequentially from the mapped file, checking that the file is
+/// long enough.
+class Reader {
+public:
+    Reader(const MemoryMappedFile& file, const std::string& fileName) :
+            _begin(file.getData()), _cur(file.getData()),
+            _end(file.getData() + file.getSize()), _fileName(fileName) {}
+
+    void checkAvailable(std::uint64_t numBytes) const {
+        OPENSIM_THROW_IF(numBytes > static_cast<std::uint64_t>(_end - _cur),
+                IOError,
+                "File '" + _fileName + "' is truncated or corrupted.");
+    }
+
+    template <typename T>
+    T read() {
+        checkAvailable(sizeof(T));
+        T value;
+        std::memcpy(&value, _cur, sizeof(T));
+        _cur += sizeof(T);
+        return value;
+    }
+
+    std::string readString() {
+        const auto size = read<std::uint32_t>();
+        checkAvailable(size);
+        std::string value(_cur, size);
+        _cur += size;
+        return value;
+    }
+
+    bool readBool() { return read<std::uint8_t>() != 0; }
+
+    std::uint64_t getOffset() const { return _cur - _begin; }
+    const char* getBegin() const { return _begin; }
+
+private:
+    const char* _begin;
+    const char* _cur;
+    const char* _end;
+    const std::string& _fileName;
+};
+
+template <typename T>
+T readMetaDataValue(Reader& reader) {
+    return reader.read<T>();
+}
+template <>
+std::string readMetaDataValue<std::string>(Reader& reader) {
+    return reader.readString();
+}
+template <>
+bool readMetaDataValue<bool>(Reader& reader) {
+    return reader.readBool();
+}
+
+/// Read `size` values. If `indices` is not null, keep only the values at
+/// these indices.
+template <typename T>
+ValueArray<T> readValues(Reader& reader, std::uint32_t size,
+        const std::vector<int>* indices) {
+    std::vector<T> values;
+    values.reserve(size);
+    for (std::uint32_t i = 0; i < size; ++i) {
+        values.push_back(readMetaDataValue<T>(reader));
+    }
+    ValueArray<T> array;
+    if (indices) {
+        for (int index : *indices) {
+            array.upd().push_back(SimTK::Value<T>{values[index]});
+        }
+    } else {
+        for (const auto& value : values) {
+            array.upd().push_back(SimTK::Value<T>{value});
+        }
+    }
+    return array;
+}
+
+ValueArrayDictionary readMetaData(Reader& reader,
+        const std::vector<int>* indices = nullptr,
+        std::uint64_t numColumns = 0) {
+    ValueArrayDictionary metaData;
+    const auto numKeys = reader.read<std::uint32_t>();
+    for (std::uint32_t ikey = 0; ikey < numKeys; ++ikey) {
+        const auto key = reader.readString();
+        const auto type = reader.read<std::uint8_t>();
+        const auto size = reader.read<std::uint32_t>();
+        // Select columns only for entries that have one value per column.
+        const auto* keep = indices && size == numColumns ? indices : nullptr;
+        switch (type) {
+        case MetaDataString:
+            metaData.setValueArrayForKey(key,
+                    readValues<std::string>(reader, size, keep));
+            break;
+        case MetaDataDouble:
+            metaData.setValueArrayForKey(key,
+                    readValues<double>(reader, size, keep));
+            break;
+        case MetaDataInt:
+            metaData.setValueArrayForKey(key,
+                    readValues<int>(reader, size, keep));
+            break;
+        case MetaDataUnsignedInt:
+            metaData.setValueArrayForKey(key,
+                    readValues<unsigned int>(reader, size, keep));
+            break;
+        case MetaDataBool:
+            metaData.setValueArrayForKey(key,
+                    readValues<bool>(reader, size, keep));
+            break;
+        default:
+            OPENSIM_THROW(IOError, "Metadata '" + key +
+                    "' has unrecognized type " + std::to_string(type) + ".");
+        }
+    }
+    return metaData;
+}
+
+struct Header {
+    std::uint64_t numRows;
+    std::uint64_t numColumns;
+    std::uint32_t numComponents;
+    std::string dataType;
+};
+
+Header readHeader(Reader& reader, const std::string& fileName) {
+    reader.checkAvailable(sizeof(magic));
+    OPENSIM_THROW_IF(std::memcmp(reader.getBegin(), magic, sizeof(magic)),
+            IOError, "File '" + fileName + "' is not an OpenSim binary "
+            "table file.");
+    reader.read<std::uint64_t>();
+    const auto version = reader.read<std::uint32_t>();
+    OPENSIM_THROW_IF(reader.read<std::uint32_t>() != byteOrderMark, IOError,
+            "File '" + fileName + "' was written on a machine with a "
+            "different byte order.");
+    OPENSIM_THROW_IF(version > formatVersion, IOError,
+            "File '" + fileName + "' has format version " +
+            std::to_string(version) + ", but this version of OpenSim only "
+            "reads versions up to " + std::to_string(formatVersion) + ".");
+    Header header;
+    header.numRows = reader.read<std::uint64_t>();
+    header.numColumns = reader.read<std::uint64_t>();
+    header.numComponents = reader.read<std::uint32_t>();
+    header.dataType = reader.readString();
+    return header;
+}
+
+template <typename T>
+std::shared_ptr<AbstractDataTable> readTable(Reader& reader,
+        const Header& header, const std::vector<std::string>& labelsToRead,
+        const std::string& fileName) {
+    OPENSIM_THROW_IF(header.numComponents * sizeof(double) != sizeof(T),
+            IOError, "File '" + fileName + "' has " +
+            std::to_string(header.numComponents) + " values per element, "
+            "which does not match its data type '" + header.dataType + "'.");
+
+    auto tableMetaData = readMetaData(reader);
+    auto independentMetaData = readMetaData(reader);
+    // Read the dependents metadata once to find the column labels, then
+    // again to keep only the selected columns.
+    Reader dependentsReader = reader;
+    auto dependentsMetaData = readMetaData(reader);
+    std::vector<std::string> allLabels;
+    if (dependentsMetaData.hasKey("labels")) {
+        const auto& labels = dependentsMetaData.getValueArrayForKey("labels");
+        for (size_t i = 0; i < labels.size(); ++i) {
+            allLabels.push_back(labels[i].getValue<std::string>());
+        }
+    }
+    OPENSIM_THROW_IF(allLabels.size() != header.numColumns, IOError,
+            "File '" + fileName + "' has " +
+            std::to_string(header.numColumns) + " columns but " +
+            std::to_string(allLabels.size()) + " column labels.");
+
+    std::vector<int> columns;
+    if (labelsToRead.empty()) {
+        for (int i = 0; i < (int)header.numColumns; ++i) columns.push_back(i);
+    } else {
+        std::unordered_map<std::string, int> indexOfLabel;
+        for (int i = 0; i < (int)allLabels.size(); ++i)
+            indexOfLabel.emplace(allLabels[i], i);
+        for (const auto& label : labelsToRead) {
+            const auto it = indexOfLabel.find(label);
+            OPENSIM_THROW_IF(it == indexOfLabel.end(), KeyNotFound, label);
+            columns.push_back(it->second);
+        }
+        dependentsMetaData =
+                readMetaData(dependentsReader, &columns, header.numColumns);
+    }
+    std::vector<std::string> labels;
+    for (int column : columns) labels.push_back(allLabels[column]);
+
+    const std::uint64_t numRows = header.numRows;
+    const std::uint64_t dataOffset = alignTo8(reader.getOffset());
+    const std::uint64_t columnSize = numRows * sizeof(T);
+    reader.checkAvailable(dataOffset - reader.getOffset() +
+            numRows * sizeof(double) + header.numColumns * columnSize);
+    const char* data = reader.getBegin() + dataOffset;
+
+    std::vector<double> times(numRows);
+    if (numRows) std::memcpy(times.data(), data, numRows * sizeof(double));
+    const char* columnsBegin = data + numRows * sizeof(double);
+
+    SimTK::Matrix_<T> matrix(static_cast<int>(numRows),
+            static_cast<int>(columns.size()));
+    for (int j = 0; j < (int)columns.size(); ++j) {
+        const char* src = columnsBegin + columns[j] * columnSize;
+        for (int i = 0; i < (int)numRows; ++i) {
+            std::memcpy(&matrix.updElt(i, j), src + i * sizeof(T), sizeof(T));
+        }
+    }
+
+    auto table = std::make_shared<TimeSeriesTable_<T>>(times, matrix, labels);
+    table->updTableMetaData() = tableMetaData;
+    table->setIndependentMetaData(independentMetaData);
+    table->setDependentsMetaData(dependentsMetaData);
+    return table;
+}
+
+} // anonymous namespace
+
+BinaryFileAdapter*
+BinaryFileAdapter::clone() const {
+    return new BinaryFileAdapter{*this};
+}
+
+const std::string
+BinaryFileAdapter::tableString() {
+    return "table";
+}
+
+std::string
+BinaryFileAdapter::readDataTypeName(const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+    MemoryMappedFile file(fileName);
+    Reader reader(file, fileName);
+    return readHeader(reader, fileName).dataType;
+}
+
+BinaryFileAdapter::OutputTables
+BinaryFileAdapter::extendRead(const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+    MemoryMappedFile file(fileName);
+    OPENSIM_THROW_IF(file.getSize() == 0, FileIsEmpty, fileName);
+
+    Reader reader(file, fileName);
+    const Header header = readHeader(reader, fileName);
+    const auto& type = header.dataType;
+
+    using namespace SimTK;
+    std::shared_ptr<AbstractDataTable> table;
+    const auto& labels = _columnLabelsToRead;
+    if (type == "double")
+        table = readTable<double>(reader, header, labels, fileName);
+    else if (type == "Vec2")
+        table = readTable<Vec2>(reader, header, labels, fileName);
+    else if (type == "Vec3")
+        table = readTable<Vec3>(reader, header, labels, fileName);
+    else if (type == "Vec4")
+        table = readTable<Vec4>(reader, header, labels, fileName);
+    else if (type == "Vec5")
+        table = readTable<Vec5>(reader, header, labels, fileName);
+    else if (type == "Vec6")
+        table = readTable<Vec6>(reader, header, labels, fileName);
+    else if (type == "Vec7")
+        table = readTable<Vec7>(reader, header, labels, fileName);
+    else if (type == "Vec8")
+        table = readTable<Vec8>(reader, header, labels, fileName);
+    else if (type == "Vec9")
+        table = readTable<Vec9>(reader, header, labels, fileName);
+    else if (type == "Vec10")
+        table = readTable<Vec<10>>(reader, header, labels, fileName);
+    else if (type == "Vec11")
+        table = readTable<Vec<11>>(reader, header, labels, fileName);
+    else if (type == "Vec12")
+        table = readTable<Vec<12>>(reader, header, labels, fileName);
+    else if (type == "UnitVec3")
+        table = readTable<UnitVec3>(reader, header, labels, fileName);
+    else if (type == "Quaternion")
+        table = readTable<Quaternion>(reader, header, labels, fileName);
+    else if (type == "SpatialVec")
+        table = readTable<SpatialVec>(reader, header, labels, fileName);
+    else
+        OPENSIM_THROW(STODataTypeNotSupported, type);
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+    return output_tables;
+}
+
+void
+BinaryFileAdapter::extendWrite(const InputTables& absTables,
+                               const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    const AbstractDataTable* absTable{};
+    try {
+        absTable = absTables.at(tableString());
+    } catch (std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing, tableString());
+    }
+
+    using namespace SimTK;
+    // Try derived class before base class.
+    if (writeTable<UnitVec3>(absTable, fileName)) return;
+    if (writeTable<Quaternion>(absTable, fileName)) return;
+    if (writeTable<SpatialVec>(absTable, fileName)) return;
+    if (writeTable<double>(absTable, fileName)) return;
+    if (writeTable<Vec2>(absTable, fileName)) return;
+    if (writeTable<Vec3>(absTable, fileName)) return;
+    if (writeTable<Vec4>(absTable, fileName)) return;
+    if (writeTable<Vec5>(absTable, fileName)) return;
+    if (writeTable<Vec6>(absTable, fileName)) return;
+    if (writeTable<Vec7>(absTable, fileName)) return;
+    if (writeTable<Vec8>(absTable, fileName)) return;
+    if (writeTable<Vec9>(absTable, fileName)) return;
+    if (writeTable<Vec<10>>(absTable, fileName)) return;
+    if (writeTable<Vec<11>>(absTable, fileName)) return;
+    if (writeTable<Vec<12>>(absTable, fileName)) return;
+
+    OPENSIM_THROW(IncorrectTableType,
+            "BinaryFileAdapter only writes TimeSeriesTable_ of the types "
+            "supported by STOFileAdapter.");
+}
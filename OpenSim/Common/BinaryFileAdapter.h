@@ -0,0 +1,133 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  BinaryFileAdapter.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_BINARY_FILE_ADAPTER_H_
+#define OPENSIM_BINARY_FILE_ADAPTER_H_
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** BinaryFileAdapter reads and writes TimeSeriesTable_ in a binary, columnar
+format (extension .stb). It holds the same tables as STOFileAdapter, but
+values are stored as raw doubles rather than text, so files are smaller and
+load much faster. The file is memory-mapped when it is read, and a subset of
+the columns can be read without touching the others:
+\code
+BinaryFileAdapter::write(table, "states.stb");
+TimeSeriesTable all("states.stb");
+auto some = BinaryFileAdapter::readFile<double>("states.stb",
+        {"/jointset/knee/knee_angle/value"});
+\endcode
+All table, independent-column and dependent-column metadata are preserved.
+Metadata values of type std::string, double, int, unsigned int and bool keep
+their type; other types are stored as strings.
+
+The layout of the file (version 1) is:
+- the 7 characters "OSIMSTB" followed by a null character;
+- uint32 format version and uint32 byte-order mark (0x01020304);
+- uint64 number of rows, uint64 number of columns, uint32 number of doubles
+  per element, and the data type name (e.g., "double", "Vec3");
+- the table, independent and dependents metadata;
+- padding to a multiple of 8 bytes, followed by the time column and then each
+  dependent column in turn, each stored contiguously.
+
+Strings are stored as a uint32 length followed by the characters. All values
+use the byte order of the machine that wrote the file; reading a file written
+with a different byte order throws an exception.
+
+The data types supported are those of STOFileAdapter: double, SimTK::Vec2 to
+SimTK::Vec<12>, SimTK::UnitVec3, SimTK::Quaternion and SimTK::SpatialVec.    */
+class OSIMCOMMON_API BinaryFileAdapter : public FileAdapter {
+public:
+    BinaryFileAdapter()                                    = default;
+    BinaryFileAdapter(const BinaryFileAdapter&)            = default;
+    BinaryFileAdapter(BinaryFileAdapter&&)                 = default;
+    BinaryFileAdapter& operator=(const BinaryFileAdapter&) = default;
+    BinaryFileAdapter& operator=(BinaryFileAdapter&&)      = default;
+    ~BinaryFileAdapter()                                   = default;
+
+    BinaryFileAdapter* clone() const override;
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string tableString();
+
+    /** Read only the columns with these labels, in the given order. An empty
+    list (the default) reads all columns.                                     */
+    void setColumnLabelsToRead(const std::vector<std::string>& labels) {
+        _columnLabelsToRead = labels;
+    }
+    const std::vector<std::string>& getColumnLabelsToRead() const {
+        return _columnLabelsToRead;
+    }
+
+    /** Get the name of the data type (e.g., "double", "Vec3") of the table
+    in the file without reading the data.                                     */
+    static std::string readDataTypeName(const std::string& fileName);
+
+    /** Read the table from a file, optionally reading only the columns with
+    the given labels.
+
+    \throws IncorrectTableType If the file holds a table with a different
+                               data type.                                     */
+    template<typename T>
+    static TimeSeriesTable_<T> readFile(const std::string& fileName,
+            const std::vector<std::string>& columnLabels = {}) {
+        BinaryFileAdapter adapter;
+        adapter.setColumnLabelsToRead(columnLabels);
+        auto tables = adapter.read(fileName);
+        auto* table = dynamic_cast<TimeSeriesTable_<T>*>(
+                tables.at(tableString()).get());
+        OPENSIM_THROW_IF(table == nullptr, IncorrectTableType,
+                "File '" + fileName + "' holds a table of type '" +
+                readDataTypeName(fileName) + "'.");
+        return std::move(*table);
+    }
+
+    /** Write a table to a binary file.                                       */
+    template<typename T>
+    static void write(const TimeSeriesTable_<T>& table,
+                      const std::string& fileName) {
+        InputTables tables{};
+        tables.emplace(tableString(), &table);
+        BinaryFileAdapter{}.extendWrite(tables, fileName);
+    }
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    std::vector<std::string> _columnLabelsToRead;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_FILE_ADAPTER_H_
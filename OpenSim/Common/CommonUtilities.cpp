@@ -26,11 +26,14 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -183,3 +186,42 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+int OpenSim::getNumThreadsForParallel(
+        int parallel, int numItems, int minItemsPerThread) {
+    OPENSIM_THROW_IF(parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", parallel);
+    int numThreads = parallel;
+    if (parallel == 0) {
+        numThreads = 1;
+    } else if (parallel == 1) {
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    return std::max(1,
+            std::min(numThreads, numItems / std::max(1, minItemsPerThread)));
+}
+
+void OpenSim::runInContiguousChunks(int numItems, int numThreads,
+        const std::function<void(int, int, int)>& function) {
+    if (numThreads <= 1) {
+        function(0, 0, numItems);
+        return;
+    }
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        const int begin = int((long long)numItems * ithread / numThreads);
+        const int end = int((long long)numItems * (ithread + 1) / numThreads);
+        threads.emplace_back([&function, &exceptions, ithread, begin, end] {
+            try {
+                function(ithread, begin, end);
+            } catch (...) {
+                exceptions[ithread] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
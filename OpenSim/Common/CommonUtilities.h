@@ -26,6 +26,7 @@
 #include "osimCommonDLL.h"
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <stack>
@@ -124,12 +125,51 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+/// Get the number of threads to use for a `parallel` setting: 0 to run
+/// serially (1 thread), 1 to use one thread per core, or N > 1 to use N
+/// threads. The number is reduced so that each thread gets at least
+/// `minItemsPerThread` of the `numItems` items of work, since starting a
+/// thread (and often, copying a model for it) only pays off if the thread has
+/// enough work; the result is at least 1.
+/// @throws Exception if `parallel` is negative.
+/// @ingroup commonutil
+OSIMCOMMON_API
+int getNumThreadsForParallel(int parallel,
+        int numItems = std::numeric_limits<int>::max(),
+        int minItemsPerThread = 1);
+
+#ifndef SWIG
+/// Split the items [0, numItems) into `numThreads` contiguous chunks of
+/// (nearly) equal size, and call `function(ithread, begin, end)` on a separate
+/// thread for each chunk [begin, end). If `numThreads` is 1, the function is
+/// called on the calling thread. After all threads have finished, the
+/// exception thrown by the lowest-numbered thread that threw, if any, is
+/// rethrown; for items processed in order, this is the error that processing
+/// serially would have raised.
+/// @ingroup commonutil
+OSIMCOMMON_API
+void runInContiguousChunks(int numItems, int numThreads,
+        const std::function<void(int ithread, int begin, int end)>& function);
+#endif
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
+/// The jar can either be filled up front with leave(), or be given a factory
+/// and a capacity, in which case objects are created lazily: take() creates a
+/// new object if no object is available and fewer than `capacity` objects
+/// have been created. The factory is called by one thread at a time (creating
+/// an object, e.g., copying a Model, need not be threadsafe), but without
+/// blocking threads that take or leave existing objects.
 /// @ingroup commonutil
 // TODO: Find a way to always give the same thread the same object.
 template <typename T> class ThreadsafeJar {
 public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+    ThreadsafeJar() = default;
+    /// Create objects with `factory`, as they are needed, up to `capacity`
+    /// objects.
+    ThreadsafeJar(Factory factory, int capacity)
+            : m_factory(std::move(factory)), m_capacity(capacity) {}
     /// Request an object for your exclusive use on your thread. This function
     /// blocks the thread until an object is available. Make sure to return
     /// (leave()) the object when you're done!
@@ -139,7 +179,25 @@ public:
         std::unique_lock<std::mutex> lock(m_mutex);
         // Block this thread until the condition variable is woken up
         // (by a notify_...()) and the lambda function returns true.
-        m_inventoryMonitor.wait(lock, [this] { return m_entries.size() > 0; });
+        m_inventoryMonitor.wait(lock, [this] {
+            return m_entries.size() > 0 || m_numCreated < m_capacity;
+        });
+        if (m_entries.empty()) {
+            // Reserve the object, then create it without holding the lock on
+            // the entries.
+            ++m_numCreated;
+            lock.unlock();
+            try {
+                std::lock_guard<std::mutex> factoryLock(m_factoryMutex);
+                return m_factory();
+            } catch (...) {
+                lock.lock();
+                --m_numCreated;
+                lock.unlock();
+                m_inventoryMonitor.notify_one();
+                throw;
+            }
+        }
         std::unique_ptr<T> top = std::move(m_entries.top());
         m_entries.pop();
         return top;
@@ -153,15 +211,21 @@ public:
         lock.unlock();
         m_inventoryMonitor.notify_one();
     }
-    /// Obtain the number of entries that can be taken.
+    /// Obtain the number of entries that can be taken, including those that
+    /// have not been created yet.
     int size() const {
         std::lock_guard<std::mutex> lock(m_mutex);
-        return (int)m_entries.size();
+        return (int)m_entries.size() + (m_capacity - m_numCreated);
     }
 
 private:
     std::stack<std::unique_ptr<T>> m_entries;
+    Factory m_factory;
+    int m_capacity = 0;
+    int m_numCreated = 0;
     mutable std::mutex m_mutex;
+    // Serializes calls to m_factory.
+    std::mutex m_factoryMutex;
     std::condition_variable m_inventoryMonitor;
 };
 
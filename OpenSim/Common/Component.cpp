@@ -24,6 +24,7 @@
 
 // INCLUDES
 #include "Component.h"
+#include "ComponentProfiler.h"
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
 #include <unordered_map>
@@ -86,22 +87,32 @@ public:
         const override final
     {   _Component.extendRealizeInstance(s); }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {   OPENSIM_PROFILE_COMPONENT(_Component, "realize", SimTK::Stage::Time);
+        _Component.extendRealizeTime(s); }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {   OPENSIM_PROFILE_COMPONENT(
+                _Component, "realize", SimTK::Stage::Position);
+        _Component.extendRealizePosition(s); }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {   OPENSIM_PROFILE_COMPONENT(
+                _Component, "realize", SimTK::Stage::Velocity);
+        _Component.extendRealizeVelocity(s); }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {   OPENSIM_PROFILE_COMPONENT(
+                _Component, "realize", SimTK::Stage::Dynamics);
+        _Component.extendRealizeDynamics(s); }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {   OPENSIM_PROFILE_COMPONENT(
+                _Component, "realize", SimTK::Stage::Acceleration);
+        _Component.extendRealizeAcceleration(s); }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {   OPENSIM_PROFILE_COMPONENT(_Component, "realize", SimTK::Stage::Report);
+        _Component.extendRealizeReport(s); }
 
 private:
     const Component& _Component;
@@ -709,7 +720,142 @@ void Component::setOwner(const Component& owner)
         return;
     }
 
+    // Both the former and the new owners lose or gain subcomponents.
+    invalidateSubcomponentIndexes();
     _owner.reset(&owner);
+    invalidateSubcomponentIndexes();
+}
+
+void Component::invalidateSubcomponentIndexes() const
+{
+    for (const Component* comp = this; comp;
+            comp = comp->hasOwner() ? &comp->getOwner() : nullptr) {
+        ++comp->_subtreeVersion;
+    }
+}
+
+std::shared_ptr<const Component::SubcomponentIndex>
+Component::getSubcomponentIndex() const
+{
+    if (!isObjectUpToDateWithProperties()) return nullptr;
+
+    // Read the count before checking the names, so that a component renamed
+    // during the check is checked for again by the next lookup.
+    const unsigned long long numNameChanges = Object::getNumNameChanges();
+    auto index = std::atomic_load(&_subcomponentIndex);
+    if (index && (index->component != this ||
+                         index->treeVersion != _subtreeVersion)) {
+        index.reset();
+    }
+    if (index && index->numNameChanges != numNameChanges) {
+        // Renaming a component does not mark anything out of date, but may
+        // make a name ambiguous; rebuild the index if any name changed.
+        if (isSubcomponentIndexOutOfDate(*index))
+            index.reset();
+        else
+            index->numNameChanges = numNameChanges;
+    }
+    if (!index) {
+        auto newIndex = std::make_shared<SubcomponentIndex>();
+        newIndex->component = this;
+        newIndex->treeVersion = _subtreeVersion;
+        newIndex->numNameChanges = numNameChanges;
+        addToSubcomponentIndex(-1, "", *newIndex);
+        index = std::move(newIndex);
+        std::atomic_store(&_subcomponentIndex, index);
+    }
+    if (!index->usable) return nullptr;
+    return index;
+}
+
+void Component::addToSubcomponentIndex(int owner, const std::string& path,
+        SubcomponentIndex& index) const
+{
+    // Visit the subcomponents in the same (pre-)order as getComponentList().
+    for (const auto& sub : getImmediateSubcomponents()) {
+        if (!index.usable) return;
+        const std::string& name = sub->getName();
+        std::string subPath = path.empty() ? name : path + "/" + name;
+        const int entry = (int)index.entries.size();
+        index.entries.push_back({sub.get(), owner, name});
+        index.byName[name].push_back(entry);
+        index.byPath.emplace(subPath, entry);
+        // The subcomponents of an edited component may have been deleted.
+        if (!sub->isObjectUpToDateWithProperties()) {
+            index.usable = false;
+            return;
+        }
+        sub->addToSubcomponentIndex(entry, subPath, index);
+    }
+}
+
+bool Component::isSubcomponentIndexEntryValid(
+        const SubcomponentIndex& index, int entry)
+{
+    // Check from the top down: a component exists if its owner exists and
+    // has not been edited.
+    std::vector<int> chain;
+    for (int i = entry; i >= 0; i = index.entries[i].owner) chain.push_back(i);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        const auto& e = index.entries[*it];
+        if (e.component->getName() != e.name) return false;
+        if (*it != entry && !e.component->isObjectUpToDateWithProperties()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Component::isSubcomponentIndexOutOfDate(const SubcomponentIndex& index)
+{
+    // The entries are in pre-order, so each owner is checked before the
+    // subcomponents it may have deleted.
+    for (const auto& e : index.entries) {
+        if (e.owner >= 0 && !index.entries[e.owner].component
+                                     ->isObjectUpToDateWithProperties()) {
+            return true;
+        }
+        if (e.component->getName() != e.name) return true;
+    }
+    return false;
+}
+
+bool Component::findIndexedSubcomponentsByName(const std::string& name,
+        std::vector<const Component*>& found) const
+{
+    const auto index = getSubcomponentIndex();
+    if (!index) return false;
+    const auto it = index->byName.find(name);
+    if (it == index->byName.end()) return false;
+    found.clear();
+    for (int entry : it->second) {
+        if (!isSubcomponentIndexEntryValid(*index, entry)) {
+            clearSubcomponentIndex();
+            return false;
+        }
+        found.push_back(index->entries[entry].component);
+    }
+    return true;
+}
+
+const Component* Component::findIndexedSubcomponentByPath(
+        const std::string& path) const
+{
+    const auto index = getSubcomponentIndex();
+    if (!index) return nullptr;
+    const auto it = index->byPath.find(path);
+    if (it == index->byPath.end()) return nullptr;
+    if (!isSubcomponentIndexEntryValid(*index, it->second)) {
+        clearSubcomponentIndex();
+        return nullptr;
+    }
+    return index->entries[it->second].component;
+}
+
+void Component::clearSubcomponentIndex() const
+{
+    std::atomic_store(&_subcomponentIndex,
+            std::shared_ptr<const SubcomponentIndex>());
 }
 
 std::string Component::getAbsolutePathString() const
@@ -792,6 +938,101 @@ const Component::StateVariable* Component::traverseToStateVariable(
     return found;
 }
 
+namespace {
+// The StateVariables of a handle or list are deleted when the tree is reset,
+// and so are only valid while the tree still has the System for which they
+// were obtained.
+void checkStateVariableSystem(const SimTK::ReferencePtr<const Component>& root,
+        const SimTK::ReferencePtr<const SimTK::System>& system) {
+    if (root.empty()) return;
+    OPENSIM_THROW_IF(!root->hasSystem() ||
+                             !root->getSystem().isSameSystem(*system),
+            ComponentHasNoSystem, *root);
+}
+}
+
+double Component::StateVariableHandle::getValue(
+        const SimTK::State& state) const
+{
+    checkStateVariableSystem(m_root, m_system);
+    return m_stateVariable->getValue(state);
+}
+
+void Component::StateVariableHandle::setValue(
+        SimTK::State& state, double value) const
+{
+    checkStateVariableSystem(m_root, m_system);
+    m_stateVariable->setValue(state, value);
+}
+
+double Component::StateVariableHandle::getDerivative(
+        const SimTK::State& state) const
+{
+    checkStateVariableSystem(m_root, m_system);
+    return m_stateVariable->getDerivative(state);
+}
+
+void Component::StateVariableList::getValues(
+        const SimTK::State& state, SimTK::Vector& values) const
+{
+    checkStateVariableSystem(m_root, m_system);
+    const int nsv = getSize();
+    if (values.size() != nsv) values.resize(nsv);
+    for (int i = 0; i < nsv; ++i) {
+        values[i] = m_stateVariables[i]->getValue(state);
+    }
+}
+
+SimTK::Vector Component::StateVariableList::getValues(
+        const SimTK::State& state) const
+{
+    SimTK::Vector values(getSize());
+    getValues(state, values);
+    return values;
+}
+
+void Component::StateVariableList::setValues(
+        SimTK::State& state, const SimTK::Vector& values) const
+{
+    checkStateVariableSystem(m_root, m_system);
+    const int nsv = getSize();
+    OPENSIM_THROW_IF(values.size() != nsv, Exception,
+            "Expected {} state variable values, but got {}.", nsv,
+            values.size());
+    for (int i = 0; i < nsv; ++i) {
+        m_stateVariables[i]->setValue(state, values[i]);
+    }
+}
+
+Component::StateVariableHandle Component::getStateVariableHandle(
+        const std::string& path) const
+{
+    const StateVariable* sv = traverseToStateVariable(path);
+    OPENSIM_THROW_IF_FRMOBJ(!sv, Exception,
+            "State variable '{}' not found.", path);
+    StateVariableHandle handle;
+    handle.m_root.reset(&getRoot());
+    handle.m_system.reset(&getSystem());
+    handle.m_stateVariable.reset(sv);
+    return handle;
+}
+
+Component::StateVariableList Component::getStateVariableList(
+        const std::vector<std::string>& paths) const
+{
+    StateVariableList list;
+    list.m_root.reset(&getRoot());
+    list.m_system.reset(&getSystem());
+    list.m_stateVariables.reserve(paths.size());
+    for (const auto& path : paths) {
+        const StateVariable* sv = traverseToStateVariable(path);
+        OPENSIM_THROW_IF_FRMOBJ(!sv, Exception,
+                "State variable '{}' not found.", path);
+        list.m_stateVariables.emplace_back(sv);
+    }
+    return list;
+}
+
 // Get the names of "continuous" state variables maintained by the Component and
 // its subcomponents.
 Array<std::string> Component::getStateVariableNames() const
@@ -932,6 +1173,17 @@ bool Component::isAllStatesVariablesListValid() const
 // state variables allocated by its subcomponents.
 SimTK::Vector Component::
     getStateVariableValues(const SimTK::State& state) const
+{
+    Vector stateVariableValues;
+    getStateVariableValues(state, stateVariableValues);
+
+    return stateVariableValues;
+}
+
+// Same as above, but fills a Vector that can be reused across calls.
+void Component::
+    getStateVariableValues(const SimTK::State& state,
+                           SimTK::Vector& values) const
 {
     // Must have already called initSystem.
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
@@ -947,12 +1199,10 @@ SimTK::Vector Component::
             _allStateVariables[i].reset(traverseToStateVariable(names[i]));
     }
 
-    Vector stateVariableValues(nsv, SimTK::NaN);
+    if (values.size() != nsv) values.resize(nsv);
     for(int i=0; i<nsv; ++i){
-        stateVariableValues[i]= _allStateVariables[i]->getValue(state);
+        values[i]= _allStateVariables[i]->getValue(state);
     }
-
-    return stateVariableValues;
 }
 
 // Set all values of the state variables allocated by this Component. Includes
@@ -1074,7 +1324,9 @@ bool Component::isCacheVariableValid(const SimTK::State& state, const std::strin
 {
     const SimTK::DefaultSystemSubsystem& subsystem = this->getDefaultSubsystem();
     const SimTK::CacheEntryIndex idx = this->getCacheVariableIndex(name);
-    return subsystem.isCacheValueRealized(state, idx);
+    const bool valid = subsystem.isCacheValueRealized(state, idx);
+    OPENSIM_PROFILE_CACHE_ACCESS(*this, name, state.getSystemStage(), valid);
+    return valid;
 }
 
 void Component::markCacheVariableValid(const SimTK::State& state, const std::string& name) const
@@ -1517,7 +1769,12 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
         // evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+        {
+            OPENSIM_PROFILE_COMPONENT(*this,
+                    "computeStateVariableDerivatives",
+                    SimTK::Stage::Acceleration);
+            computeStateVariableDerivatives(s);
+        }
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
@@ -1830,6 +2087,7 @@ void Component::clearStateAllocations()
 
 void Component::reset()
 {
+    invalidateSubcomponentIndexes();
     _system.reset();
     _simTKcomponentIndex.invalidate();
     clearStateAllocations();
@@ -50,8 +50,14 @@
 #include "OpenSim/Common/ComponentSocket.h"
 #include "OpenSim/Common/Object.h"
 #include "simbody/internal/MultibodySystem.h"
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 
+#ifdef OPENSIM_WITH_COMPONENT_PROFILING
+#include "ComponentProfiler.h"
+#endif
+
 #include <OpenSim/Common/osimCommonDLL.h>
 
 namespace OpenSim {
@@ -1337,6 +1343,15 @@ public:
      */
     SimTK::Vector getStateVariableValues(const SimTK::State& state) const;
 
+    /**
+     * Same as above, but the values are written into the provided Vector,
+     * which is resized only if its length is not getNumStateVariables().
+     * Reuse the same Vector to get the values for many states without
+     * allocating memory for each state.
+     */
+    void getStateVariableValues(const SimTK::State& state,
+                                SimTK::Vector& values) const;
+
     /**
      * %Set all values of the state variables allocated by this Component.
      * Includes state variables allocated by its subcomponents. Note, this
@@ -1603,6 +1618,27 @@ public:
         return getCacheVariableValueGeneric<T>(state, cv);
     }
 
+    /**
+     * Get a handle to a cache variable allocated by this Component, by name.
+     * Use the handle, instead of the name, to access the cache variable (e.g.,
+     * with getCacheVariableValue()) without looking up the name each time.
+     *
+     * @tparam T
+     *     Type of value held in the cache variable
+     * @param name
+     *     the name of the cache variable
+     * @throws Exception
+     *     if this Component has not allocated a cache variable with this name
+     */
+    template<class T>
+    CacheVariable<T> getCacheVariable(const std::string& name) const
+    {
+        OPENSIM_THROW_IF_FRMOBJ(
+                _namedCacheVariables.find(name) == _namedCacheVariables.end(),
+                Exception, "No cache variable named '{}'.", name);
+        return CacheVariable<T>{name};
+    }
+
 private:
     template<typename T, typename K>
     void setCacheVariableValueGeneric(const SimTK::State& state, const K& key, T value) const
@@ -1753,7 +1789,12 @@ public:
     bool isCacheVariableValid(const SimTK::State& state, const CacheVariable<T>& cv) const {
         const SimTK::DefaultSystemSubsystem& subsystem = this->getDefaultSubsystem();
         const SimTK::CacheEntryIndex idx = this->getCacheVariableIndex(cv);
-        return subsystem.isCacheValueRealized(state, idx);
+        const bool valid = subsystem.isCacheValueRealized(state, idx);
+#ifdef OPENSIM_WITH_COMPONENT_PROFILING
+        OPENSIM_PROFILE_CACHE_ACCESS(
+                *this, cv.name, state.getSystemStage(), valid);
+#endif
+        return valid;
     }
 
     /**
@@ -2504,10 +2545,9 @@ public:
             throw Exception(msg);
         }
 
-        ComponentPath thisAbsPath = getAbsolutePath();
-
         const C* found = NULL;
-        if (thisAbsPath == pathToFind) {
+        // A relative path cannot be this Component's absolute path.
+        if (pathToFind.isAbsolute() && getAbsolutePath() == pathToFind) {
             found = dynamic_cast<const C*>(this);
             if (found)
                 return found;
@@ -2522,34 +2562,47 @@ public:
                 foundCs.push_back(found);
         }
 
-        ComponentList<const C> compsList = this->template getComponentList<C>();
-
-        for (const C& comp : compsList) {
+        // Returns true if the search is over.
+        auto addMatch = [&](const C& comp) {
             // if a child of this Component, one should not need
             // to specify this Component's absolute path name
-            ComponentPath compAbsPath = comp.getAbsolutePath();
-            ComponentPath thisAbsPathPlusSubname = getAbsolutePath();
-            thisAbsPathPlusSubname.pushBack(subname);
-            if (compAbsPath == thisAbsPathPlusSubname) {
+            if (comp.hasOwner() && &comp.getOwner() == this) {
                 foundCs.push_back(&comp);
-                break;
+                return true;
             }
 
             // otherwise, we just have a type and name match
             // which we may need to support for compatibility with older models
             // where only names were used (not path or type)
             // TODO replace with an exception -aseth
-            std::string compName = comp.getName();
-            if (compName == subname) {
-                foundCs.push_back(&comp);
-                // TODO Revisit why the exact match isn't found when
-                // when what appears to be the complete path.
-                log_debug("{} Found '{}' as a match for: Component '{}' of "
-                          "type {}, but it is not on the specified path.",
-                          msg, compAbsPath.toString(),
-                          comp.getConcreteClassName());
-                //throw Exception(details, __FILE__, __LINE__);
+            foundCs.push_back(&comp);
+            // TODO Revisit why the exact match isn't found when
+            // when what appears to be the complete path.
+            log_debug("{} Found '{}' as a match for: Component '{}' of "
+                      "type {}, but it is not on the specified path.",
+                      msg, comp.getAbsolutePathString(),
+                      comp.getConcreteClassName());
+            //throw Exception(details, __FILE__, __LINE__);
+            return false;
+        };
+
+        // The index lists the subcomponents with this name in the same order
+        // as getComponentList().
+        std::vector<const Component*> indexed;
+        if (findIndexedSubcomponentsByName(subname, indexed)) {
+            for (const Component* comp : indexed) {
+                const C* compC = dynamic_cast<const C*>(comp);
+                if (compC && addMatch(*compC)) break;
+            }
+        } else {
+            const size_t numFoundBefore = foundCs.size();
+            ComponentList<const C> compsList =
+                    this->template getComponentList<C>();
+            for (const C& comp : compsList) {
+                if (comp.getName() == subname && addMatch(comp)) break;
             }
+            // The index missed a subcomponent (e.g., one that was renamed).
+            if (foundCs.size() > numFoundBefore) clearSubcomponentIndex();
         }
 
         if (foundCs.size() == 1) {
@@ -2600,6 +2653,23 @@ protected:
             }
         }
 
+        // The root component indexes the paths of its subcomponents.
+        const size_t numLevels = path.getNumPathLevels();
+        const bool useIndex =
+                !current->hasOwner() && numLevels > iPathEltStart + 1;
+        if (useIndex) {
+            std::string key = path.getSubcomponentNameAtLevel(iPathEltStart);
+            for (size_t i = iPathEltStart + 1; i < numLevels; ++i) {
+                key += '/';
+                key += path.getSubcomponentNameAtLevel(i);
+            }
+            if (const Component* indexed =
+                    current->findIndexedSubcomponentByPath(key)) {
+                return dynamic_cast<const C*>(indexed);
+            }
+        }
+        const Component* root = current;
+
         using RefComp = SimTK::ReferencePtr<const Component>;
 
         // Skip over the root component name.
@@ -2617,6 +2687,8 @@ protected:
             else
                 return nullptr;
         }
+        // The index missed a subcomponent (e.g., one that was renamed).
+        if (useIndex) root->clearSubcomponentIndex();
         if (const C* comp = dynamic_cast<const C*>(current))
             return comp;
         return nullptr;
@@ -2657,6 +2729,83 @@ public:
      */
     const StateVariable* traverseToStateVariable(
             const ComponentPath& path) const;
+
+    /**
+     * A handle to a StateVariable anywhere in the Component tree, for
+     * reading and writing its value without looking up the StateVariable by
+     * its path each time (e.g., within a Controller or a cost function).
+     * Obtain a handle with getStateVariableHandle() after initSystem(). The
+     * handle is tied to that System: once the System is recreated (e.g., by
+     * calling initSystem() again), its methods throw ComponentHasNoSystem and
+     * a new handle must be obtained. The root of the Component tree must
+     * outlive the handle.
+     */
+    class StateVariableHandle {
+    public:
+        StateVariableHandle() = default;
+        /** Whether this handle refers to a StateVariable. This does not check
+         * whether the System of the handle still exists. */
+        bool isValid() const { return !m_stateVariable.empty(); }
+        double getValue(const SimTK::State& state) const;
+        void setValue(SimTK::State& state, double value) const;
+        double getDerivative(const SimTK::State& state) const;
+
+    private:
+        friend class Component;
+        // The root of the tree and its System when the handle was obtained.
+        SimTK::ReferencePtr<const Component> m_root;
+        SimTK::ReferencePtr<const SimTK::System> m_system;
+        SimTK::ReferencePtr<const StateVariable> m_stateVariable;
+    };
+
+    /**
+     * An ordered list of StateVariable%s anywhere in the Component tree, for
+     * gathering their values into a Vector, or setting their values from a
+     * Vector, without looking up the StateVariable%s by their paths. Obtain a
+     * list with getStateVariableList(); as for StateVariableHandle, its
+     * methods throw ComponentHasNoSystem once the System is recreated.
+     */
+    class StateVariableList {
+    public:
+        StateVariableList() = default;
+        /** The number of StateVariable%s in the list. */
+        int getSize() const { return (int)m_stateVariables.size(); }
+        /** Write the values of the StateVariable%s, in the order of the list,
+         * into `values`, which is resized only if its length is not
+         * getSize(). */
+        void getValues(const SimTK::State& state, SimTK::Vector& values) const;
+        SimTK::Vector getValues(const SimTK::State& state) const;
+        /** %Set the values of the StateVariable%s, in the order of the list.
+         * @throws Exception if the length of `values` is not getSize(). */
+        void setValues(SimTK::State& state, const SimTK::Vector& values) const;
+
+    private:
+        friend class Component;
+        SimTK::ReferencePtr<const Component> m_root;
+        SimTK::ReferencePtr<const SimTK::System> m_system;
+        std::vector<SimTK::ReferencePtr<const StateVariable>> m_stateVariables;
+    };
+
+    /**
+     * Get a handle to a StateVariable anywhere in the Component tree, given a
+     * StateVariable path (as for traverseToStateVariable()).
+     *
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if the StateVariable does not exist
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& path) const;
+
+    /**
+     * Get a list of StateVariable%s anywhere in the Component tree, given
+     * their paths (as for traverseToStateVariable()), in the given order.
+     *
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if any of the StateVariable%s does not exist
+     */
+    StateVariableList getStateVariableList(
+            const std::vector<std::string>& paths) const;
 #endif
 
     /// @name Access to the owning component (advanced).
@@ -3104,6 +3253,73 @@ private:
     // tree order of its subcomponents.
     mutable std::vector<SimTK::ReferencePtr<const Component> > _orderedSubcomponents;
 
+    // Lookup tables for the subcomponents (immediate and otherwise) of this
+    // Component, used by findComponent() and traversePathToComponent().
+    struct SubcomponentIndex {
+        // The Component and the version of its subtree for which the index
+        // was built; the index is out of date if either changed.
+        const Component* component = nullptr;
+        unsigned long long treeVersion = 0;
+        // False if a subcomponent was not up to date with its properties when
+        // the index was built; the index is then not used until the tree is
+        // finalized again.
+        bool usable = true;
+        // Object::getNumNameChanges() when the names in the index were last
+        // found to match the names of the subcomponents.
+        mutable std::atomic<unsigned long long> numNameChanges{0};
+        // A subcomponent, the entry of its owner (-1 for this Component) and
+        // its name when the index was built.
+        struct Entry {
+            const Component* component;
+            int owner;
+            std::string name;
+        };
+        // All subcomponents, in the order of getComponentList().
+        std::vector<Entry> entries;
+        // Entries by name, in the order of getComponentList().
+        std::unordered_map<std::string, std::vector<int>> byName;
+        // Entries by path relative to this Component (e.g.,
+        // "forceset/soleus"); the first in the tree if paths are repeated.
+        std::unordered_map<std::string, int> byPath;
+    };
+    // Built lazily by getSubcomponentIndex(); accessed atomically, since
+    // lookups may occur concurrently.
+    mutable std::shared_ptr<const SubcomponentIndex> _subcomponentIndex;
+    // Incremented whenever this Component or any of its subcomponents is
+    // reset or changes owner, which invalidates _subcomponentIndex.
+    mutable unsigned long long _subtreeVersion = 0;
+
+    /** The index of this Component's subcomponents, which is built (again) if
+    it does not exist or is out of date. Returns nullptr if this Component is
+    not up to date with its properties, as its subcomponents may have changed
+    since the index was built, or if the index is not usable. */
+    std::shared_ptr<const SubcomponentIndex> getSubcomponentIndex() const;
+    void addToSubcomponentIndex(int owner, const std::string& path,
+            SubcomponentIndex& index) const;
+    /** Whether an entry of the index still describes the tree. The owners of
+    the entry, from this Component down, must be up to date with their
+    properties (otherwise, they may have deleted their subcomponents) and
+    none of the components along the way may have been renamed. */
+    static bool isSubcomponentIndexEntryValid(
+            const SubcomponentIndex& index, int entry);
+    /** Whether any subcomponent in the index was renamed, or any owner of a
+    subcomponent is no longer up to date with its properties. */
+    static bool isSubcomponentIndexOutOfDate(const SubcomponentIndex& index);
+    /** The subcomponents with the given name, from the index. Returns false if
+    the index cannot be used or has no such subcomponent; the caller must then
+    search the tree. */
+    bool findIndexedSubcomponentsByName(const std::string& name,
+            std::vector<const Component*>& found) const;
+    /** The subcomponent at the given path relative to this Component, from
+    the index, or nullptr if the index cannot be used or has no such
+    subcomponent. */
+    const Component* findIndexedSubcomponentByPath(
+            const std::string& path) const;
+    /** Discard the index, so that the next lookup rebuilds it. */
+    void clearSubcomponentIndex() const;
+    /** Invalidate the indexes of this Component and of its owners. */
+    void invalidateSubcomponentIndexes() const;
+
     // Structure to hold modeling option information. Modeling options are
     // integers 0..maxOptionValue. At run time we keep them in a Simbody
     // discrete state variable that invalidates Model stage if changed.
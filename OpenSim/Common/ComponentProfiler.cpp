@@ -0,0 +1,256 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim: ComponentProfiler.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+
+#include "Component.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace OpenSim;
+
+std::atomic<bool> ComponentProfiler::s_enabled{false};
+
+namespace {
+struct ProfilerRegistry {
+    std::mutex mutex;
+    // All entries, in the order they were created. The addresses of the
+    // entries do not change until reset() is called.
+    std::vector<std::unique_ptr<ComponentProfiler::Entry>> entries;
+    std::unordered_map<const Component*,
+            std::vector<ComponentProfiler::Entry*>> entriesByComponent;
+    std::vector<double> snapshotTimes;
+    // Elapsed time of each entry (in creation order) at each snapshot.
+    std::vector<std::vector<long long>> snapshots;
+    // Incremented by reset(), so that each CallSite discards the entries it
+    // remembers.
+    std::atomic<long long> generation{0};
+};
+
+ProfilerRegistry& getRegistry() {
+    static ProfilerRegistry registry;
+    return registry;
+}
+
+std::string getEntryLabel(const ComponentProfiler::Entry& entry) {
+    return entry.componentPath + "|" + entry.name + "|" +
+           entry.stage.getName();
+}
+} // anonymous namespace
+
+bool ComponentProfiler::isCompiledIn() {
+#ifdef OPENSIM_WITH_COMPONENT_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ComponentProfiler::setEnabled(bool enabled) {
+    if (enabled && !isCompiledIn()) {
+        log_warn("ComponentProfiler: OpenSim was built without "
+                 "OPENSIM_WITH_COMPONENT_PROFILING, so no profiling data "
+                 "will be recorded.");
+    }
+    s_enabled = enabled;
+}
+
+void ComponentProfiler::reset() {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.entriesByComponent.clear();
+    registry.entries.clear();
+    registry.snapshotTimes.clear();
+    registry.snapshots.clear();
+    ++registry.generation;
+}
+
+ComponentProfiler::Entry& ComponentProfiler::updEntry(
+        const Component& component, const char* name, SimTK::Stage stage,
+        bool isCacheVariable) {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto& componentEntries = registry.entriesByComponent[&component];
+    for (auto* entry : componentEntries) {
+        if (entry->stage == stage &&
+                entry->isCacheVariable == isCacheVariable &&
+                entry->name == name) {
+            return *entry;
+        }
+    }
+    registry.entries.emplace_back(new Entry());
+    auto& entry = *registry.entries.back();
+    entry.componentPath = component.getAbsolutePathString();
+    entry.name = name;
+    entry.stage = stage;
+    entry.isCacheVariable = isCacheVariable;
+    componentEntries.push_back(&entry);
+    return entry;
+}
+
+ComponentProfiler::Entry& ComponentProfiler::CallSite::updEntry(
+        const Component& component, const char* name, SimTK::Stage stage,
+        bool isCacheVariable) {
+    const long long generation = getRegistry().generation;
+    if (generation != m_generation) {
+        m_entries.clear();
+        m_generation = generation;
+    }
+    auto& componentEntries = m_entries[&component];
+    for (auto* entry : componentEntries) {
+        if (entry->stage == stage &&
+                entry->isCacheVariable == isCacheVariable &&
+                entry->name == name) {
+            return *entry;
+        }
+    }
+    auto& entry = ComponentProfiler::updEntry(
+            component, name, stage, isCacheVariable);
+    componentEntries.push_back(&entry);
+    return entry;
+}
+
+void ComponentProfiler::recordCacheAccess(CallSite& callSite,
+        const Component& component, const std::string& cacheVariableName,
+        SimTK::Stage stage, bool hit) {
+    auto& entry = callSite.updEntry(
+            component, cacheVariableName.c_str(), stage, true);
+    if (hit)
+        ++entry.numCacheHits;
+    else
+        ++entry.numCacheMisses;
+}
+
+void ComponentProfiler::takeSnapshot(double time) {
+    if (!isCompiledIn()) return;
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<long long> elapsed;
+    elapsed.reserve(registry.entries.size());
+    for (const auto& entry : registry.entries) {
+        elapsed.push_back(entry->elapsedTimeInNs);
+    }
+    registry.snapshotTimes.push_back(time);
+    registry.snapshots.push_back(std::move(elapsed));
+}
+
+TimeSeriesTable ComponentProfiler::createSnapshotsTable() {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::vector<int> columns;
+    std::vector<std::string> labels;
+    for (int i = 0; i < (int)registry.entries.size(); ++i) {
+        const auto& entry = *registry.entries[i];
+        if (entry.isCacheVariable) continue;
+        auto label = getEntryLabel(entry);
+        // Distinct components with the same path share a column.
+        if (std::find(labels.begin(), labels.end(), label) != labels.end())
+            continue;
+        columns.push_back(i);
+        labels.push_back(std::move(label));
+    }
+
+    const int nrow = (int)registry.snapshots.size();
+    SimTK::Matrix matrix(nrow, (int)columns.size(), 0.0);
+    for (int irow = 0; irow < nrow; ++irow) {
+        const auto& snapshot = registry.snapshots[irow];
+        for (int icol = 0; icol < (int)columns.size(); ++icol) {
+            // Entries created after a snapshot have no time in it.
+            if (columns[icol] < (int)snapshot.size()) {
+                matrix(irow, icol) =
+                        SimTK::nsToSec(snapshot[columns[icol]]);
+            }
+        }
+    }
+    if (nrow == 0) {
+        TimeSeriesTable table;
+        table.setColumnLabels(labels);
+        return table;
+    }
+    return TimeSeriesTable(registry.snapshotTimes, matrix, labels);
+}
+
+std::string ComponentProfiler::createReport() {
+    std::vector<const Entry*> entries;
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& entry : registry.entries) {
+            entries.push_back(entry.get());
+        }
+    }
+    // Sorting by path lists each component right after its owner.
+    std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry* a, const Entry* b) {
+                if (a->componentPath != b->componentPath)
+                    return a->componentPath < b->componentPath;
+                if (a->isCacheVariable != b->isCacheVariable)
+                    return b->isCacheVariable;
+                if (a->name != b->name) return a->name < b->name;
+                return a->stage < b->stage;
+            });
+
+    std::stringstream ss;
+    ss << "Component profile (" << entries.size() << " entries):\n";
+    const std::string* currentPath = nullptr;
+    std::string indent;
+    for (const auto* entry : entries) {
+        if (!currentPath || *currentPath != entry->componentPath) {
+            currentPath = &entry->componentPath;
+            const int depth = (int)std::count(currentPath->begin(),
+                    currentPath->end(), '/');
+            indent = std::string(2 * std::max(depth, 1), ' ');
+            ss << indent << *currentPath << "\n";
+        }
+        ss << indent << "  ";
+        if (entry->isCacheVariable) {
+            ss << "cache variable " << entry->name << " ["
+               << entry->stage.getName() << "]: " << entry->numCacheHits.load()
+               << " hit(s), " << entry->numCacheMisses.load()
+               << " miss(es)\n";
+        } else {
+            const long long numCalls = entry->numCalls;
+            const long long elapsed = entry->elapsedTimeInNs;
+            ss << entry->name << " [" << entry->stage.getName()
+               << "]: " << numCalls << " call(s), "
+               << Stopwatch::formatNs(elapsed);
+            if (numCalls) {
+                ss << " (" << Stopwatch::formatNs(elapsed / numCalls)
+                   << " per call)";
+            }
+            ss << "\n";
+        }
+    }
+    return ss.str();
+}
+
+void ComponentProfiler::logReport() {
+    std::istringstream report(createReport());
+    std::string line;
+    while (std::getline(report, line)) log_info("{}", line);
+}
@@ -0,0 +1,195 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim: ComponentProfiler.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "TimeSeriesTable.h"
+
+#include <SimTKcommon.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Stopwatch.h"
+
+namespace OpenSim {
+
+class Component;
+
+/** Per-Component timings and counters for realization, force and state
+derivative computations, and cache variable accesses.
+
+The instrumentation is only compiled in if OpenSim is built with the CMake
+option OPENSIM_WITH_COMPONENT_PROFILING; otherwise, the profiling macros
+expand to nothing and this class never has any entries. When compiled in,
+profiling must still be turned on at runtime with setEnabled(true).
+
+Each entry is identified by a component, the name of what is timed (e.g.,
+"computeForce" or "realize") or of a cache variable, and a SimTK::Stage. For
+timers, the stage is the stage being computed; for cache variables, it is
+the stage to which the State had been realized when the cache variable was
+checked. Entries are created on first use and can be updated from multiple
+threads. Entries are keyed by the address of the component (its path is
+stored when the entry is created), so call reset() after deleting profiled
+components. Each thread remembers the entries it has used at each profiled
+call site, so only the first use of an entry at a call site looks it up in
+the shared list of entries.
+
+Component.h includes this file only if OPENSIM_WITH_COMPONENT_PROFILING is
+defined; include it directly to use this class.
+
+@code
+ComponentProfiler::setEnabled(true);
+Manager manager(model, state);
+manager.integrate(1.0);
+ComponentProfiler::logReport();
+@endcode */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** The counters for one (component, name, stage) combination. */
+    struct Entry {
+        std::string componentPath;
+        std::string name;
+        SimTK::Stage stage;
+        bool isCacheVariable = false;
+        std::atomic<long long> numCalls{0};
+        std::atomic<long long> elapsedTimeInNs{0};
+        std::atomic<long long> numCacheHits{0};
+        std::atomic<long long> numCacheMisses{0};
+    };
+
+    /** The entries that one thread has used at one call site. The profiling
+    macros create a thread_local CallSite for each call site, so that finding
+    an entry does not require locking the shared list of entries. */
+    class OSIMCOMMON_API CallSite {
+    public:
+        /** Get the entry for a component, looking it up with
+        ComponentProfiler::updEntry() only the first time. */
+        Entry& updEntry(const Component& component, const char* name,
+                SimTK::Stage stage, bool isCacheVariable = false);
+    private:
+        // The value of the reset() counter when m_entries was filled.
+        long long m_generation = -1;
+        std::unordered_map<const Component*, std::vector<Entry*>> m_entries;
+    };
+
+    /** Times the enclosing scope and adds it to an entry. Use the
+    OPENSIM_PROFILE_COMPONENT macro rather than this class directly. */
+    class ScopedTimer {
+    public:
+        ScopedTimer(CallSite& callSite, const Component& component,
+                const char* name, SimTK::Stage stage)
+                : m_entry(isEnabled()
+                                  ? &callSite.updEntry(component, name, stage)
+                                  : nullptr) {}
+        ~ScopedTimer() {
+            if (m_entry) {
+                ++m_entry->numCalls;
+                m_entry->elapsedTimeInNs += m_stopwatch.getElapsedTimeInNs();
+            }
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        Entry* m_entry;
+        Stopwatch m_stopwatch;
+    };
+
+    /** Whether OpenSim was built with OPENSIM_WITH_COMPONENT_PROFILING. */
+    static bool isCompiledIn();
+
+    /** Turn profiling on or off at runtime (default: off). This has no
+    effect unless isCompiledIn() is true. */
+    static void setEnabled(bool enabled);
+    static bool isEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /** Remove all entries and snapshots. Do not call this while profiled
+    computations are running in other threads. */
+    static void reset();
+
+    /** Get the entry for a component, creating it if necessary. This locks
+    the shared list of entries; prefer CallSite::updEntry(). */
+    static Entry& updEntry(const Component& component, const char* name,
+            SimTK::Stage stage, bool isCacheVariable = false);
+
+    /** Count a check of whether a cache variable is valid. */
+    static void recordCacheAccess(CallSite& callSite,
+            const Component& component, const std::string& cacheVariableName,
+            SimTK::Stage stage, bool hit);
+
+    /** Record the elapsed time of every timed entry at the given time (e.g.,
+    the simulation time). The snapshots are returned by
+    createSnapshotsTable(). Snapshots are taken even while profiling is
+    disabled at runtime, but not if isCompiledIn() is false. */
+    static void takeSnapshot(double time);
+
+    /** Create a table with one row per snapshot and one column per timed
+    entry, containing the cumulative elapsed time of the entry in seconds.
+    Column labels have the form "<component path>|<name>|<stage>". */
+    static TimeSeriesTable createSnapshotsTable();
+
+    /** A report of all entries, grouped by component in the order of the
+    component tree. */
+    static std::string createReport();
+
+    /** Write the report to the Logger (and therefore to all of its sinks) at
+    the info level. */
+    static void logReport();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+} // namespace OpenSim
+
+#ifdef OPENSIM_WITH_COMPONENT_PROFILING
+    #define OPENSIM_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define OPENSIM_PROFILE_CONCAT(a, b) OPENSIM_PROFILE_CONCAT_IMPL(a, b)
+    /** Time the rest of the enclosing scope. */
+    #define OPENSIM_PROFILE_COMPONENT(component, name, stage)                 \
+        static thread_local ::OpenSim::ComponentProfiler::CallSite            \
+                OPENSIM_PROFILE_CONCAT(osimProfileCallSite, __LINE__);        \
+        ::OpenSim::ComponentProfiler::ScopedTimer                             \
+                OPENSIM_PROFILE_CONCAT(osimProfileTimer, __LINE__)(           \
+                        OPENSIM_PROFILE_CONCAT(osimProfileCallSite, __LINE__),\
+                        component, name, stage)
+    /** Count a cache variable validity check as a hit or a miss. */
+    #define OPENSIM_PROFILE_CACHE_ACCESS(component, name, stage, hit)         \
+        do {                                                                  \
+            if (::OpenSim::ComponentProfiler::isEnabled()) {                  \
+                static thread_local ::OpenSim::ComponentProfiler::CallSite    \
+                        osimProfileCallSite;                                  \
+                ::OpenSim::ComponentProfiler::recordCacheAccess(              \
+                        osimProfileCallSite, component, name, stage, hit);    \
+            }                                                                 \
+        } while (false)
+#else
+    #define OPENSIM_PROFILE_COMPONENT(component, name, stage)
+    #define OPENSIM_PROFILE_CACHE_ACCESS(component, name, stage, hit)
+#endif
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
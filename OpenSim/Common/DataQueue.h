@@ -22,13 +22,21 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
-#include <queue>
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <OpenSim/Common/Exception.h>
 
 namespace OpenSim {
 
+#ifndef SWIG
 //=============================================================================
 //=============================================================================
 /**
@@ -37,9 +45,6 @@ namespace OpenSim {
  * potentially different in processing speeds, decoupling the producers 
  * (e.g. File or live stream) from consumers. 
  *
- * Synchronization mechanism will be implmented later to allow handling of 
- * multiple threads or significant differences in speeds.
- *
  * @author Ayman Habib
  */
 /** Template class to contain Queue Entries, typically timestamped */
@@ -60,16 +65,41 @@ private:
     double _timeStamp;
     SimTK::RowVectorView_<U> _data;
 };
+#endif // SWIG
+
+/** What a bounded DataQueue_ does with a new entry when it is full.
+ * - DropOldest: discard the oldest entry in the queue to make room. The
+ *   producer never waits. Use this when the consumer only cares about the
+ *   most recent data (e.g., live streaming).
+ * - Backpressure: push_back() waits until the consumer makes room and
+ *   try_push_back() rejects the entry. No data is lost.                    */
+enum class DataQueueOverflowPolicy {
+    DropOldest,
+    Backpressure
+};
+
+#ifndef SWIG
 /**
- * DataQueue is a wrapper around the std::queue customized to handle data 
- * processing and synchronization, and limiting the interface to only the 
- * subset of operations needed for this use case. 
- * Synchronization is experimental as of now. Client is responsible for 
- * making sure order is preserved.
- * timestamp is required to pass in data so that clients can enforce order,
- * however timestamp is not used/order-enforced internally.
+ * DataQueue is a queue of timestamped rows used to pass data from one
+ * producer thread to one consumer thread (e.g., from a live stream to the
+ * InverseKinematicsSolver). Entries are stored in ring buffers of
+ * preallocated slots; pushing and popping copy rows into and out of these
+ * slots and do not take a lock. Once a slot has held a row of a given size,
+ * reusing it does not allocate.
+ *
+ * By default, the queue is unbounded: when its ring buffer is full, the
+ * producer continues in a new ring buffer twice as large, and the consumer
+ * moves on to it once it has emptied the old one. No entry is lost and the
+ * producer never waits, so a queue can be filled on one thread and drained
+ * later. A queue created with a nonzero capacity is bounded instead and
+ * handles overflow according to its DataQueueOverflowPolicy.
+ *
+ * The queue supports exactly one producer (push_back(), try_push_back())
+ * and one consumer (pop_front(), try_pop_front()) at a time.
+ * Timestamps are not used to order entries. An entry whose timestamp is not
+ * later than that of the previously pushed entry is counted as late (see
+ * getNumLateFrames()) but is queued as usual.
  */
-// @TODO Test support of multiple consumers. 
 template<class T> class DataQueue_ {
 //=============================================================================
 // METHODS
@@ -79,58 +109,264 @@ public:
     // CONSTRUCTION
     //--------------------------------------------------------------------------
     virtual ~DataQueue_() {}
-    
-    DataQueue_()                                = default;
-    // using compiler generated methods here is problematic due to mutex 
-    DataQueue_(const DataQueue_& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_(DataQueue_&& other){ 
-        m_data_queue = other.m_data_queue;
-    };
-    DataQueue_& operator=(const DataQueue_& other) { 
-        m_data_queue = other.m_data_queue;
-        return (*this);
-    };
+
+    /** Create a queue that holds at most `capacity` entries, or an unbounded
+    queue if `capacity` is 0 (the default); `policy` only applies to bounded
+    queues. If `numColumns` is nonzero, the row storage for every entry of
+    the (first) ring buffer is allocated here as well; otherwise each slot
+    allocates the first time it is used. */
+    explicit DataQueue_(size_t capacity = 0,
+            DataQueueOverflowPolicy policy =
+                    DataQueueOverflowPolicy::Backpressure,
+            int numColumns = 0) :
+            _capacity(capacity), _policy(policy) {
+        appendRing(capacity ? capacity : InitialUnboundedCapacity,
+                numColumns);
+    }
+    // The atomic indices are not copyable, so copying is spelled out. The
+    // copy holds the entries of `other` in a single ring buffer. Copying a
+    // queue that is in use by other threads is not safe.
+    DataQueue_(const DataQueue_& other) { copyFrom(other); }
+    DataQueue_(DataQueue_&& other) : DataQueue_(other) {}
+    DataQueue_& operator=(const DataQueue_& other) {
+        if (this != &other) copyFrom(other);
+        return *this;
+    }
 
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
-    // push data and associated timestamp to the end of the queue
-    void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
-        mlock.unlock();     // unlock before notificiation to minimize mutex con
-        m_cond.notify_one(); 
+    /** Push data and associated timestamp to the end of the queue. If a
+    bounded queue is full, the DropOldest policy discards the oldest entry
+    and the Backpressure policy waits until the consumer pops an entry.
+    Returns false if the entry was dropped instead of queued. Producer
+    only.                                                                    */
+    bool push_back(const double time, const SimTK::RowVectorView_<T>& data) {
+        if (_policy == DataQueueOverflowPolicy::Backpressure) {
+            unsigned attempt = 0;
+            while (isFull()) backoff(attempt);
+        }
+        return try_push_back(time, data);
+    }
+    /** Push data and associated timestamp to the end of the queue without
+    waiting. With the Backpressure policy, returns false and leaves the queue
+    unchanged if a bounded queue is full. Producer only.                    */
+    bool try_push_back(const double time,
+            const SimTK::RowVectorView_<T>& data) {
+        Ring* ring = _back;
+        std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        std::uint64_t head = ring->head.load();
+        if (!_capacity && tail - head >= ring->capacity) {
+            // Continue in a larger ring buffer, with rows of this size.
+            ring = appendRing(2 * ring->capacity, data.size());
+            tail = head = 0;
+        }
+        while (tail - head >= ring->capacity) {
+            if (_policy == DataQueueOverflowPolicy::Backpressure) return false;
+            // Discard the oldest entry. The CAS fails if the consumer popped
+            // it in the meantime, in which case there is room now.
+            if (ring->head.compare_exchange_weak(head, head + 1)) {
+                _numDropped.fetch_add(1, std::memory_order_relaxed);
+                ++head;
+            }
+        }
+        // Never overwrite the slot the consumer is copying from. This can
+        // only happen with DropOldest, if the consumer stalls in the middle
+        // of a pop while the producer laps the buffer; drop the new entry.
+        const std::uint64_t reading = ring->reading.load();
+        if (reading != NotReading &&
+                (tail - reading) % ring->slots.size() == 0) {
+            _numDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Slot& slot = ring->slots[tail % ring->slots.size()];
+        slot.time = time;
+        slot.data = data;
+        if (time <= _lastPushTime)
+            _numLate.fetch_add(1, std::memory_order_relaxed);
+        _lastPushTime = time;
+        ring->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /** Pop the front of the queue and return data and associated timestamp,
+    waiting for as long as it takes for an entry to arrive. Consumer only.  */
+    void pop_front(double& time, SimTK::RowVector_<T>& data) {
+        unsigned attempt = 0;
+        while (!try_pop_front(time, data)) backoff(attempt);
+    }
+    /** Same as pop_front() but gives up after `timeout` seconds. Returns
+    false if the queue was still empty at that point. Consumer only.        */
+    bool pop_front(double& time, SimTK::RowVector_<T>& data, double timeout) {
+        const auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration<double>(timeout);
+        unsigned attempt = 0;
+        while (!try_pop_front(time, data)) {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            backoff(attempt);
+        }
+        return true;
     }
-    // pop the front of the queue and return data and associated timestamp
-    void pop_front(double& time, SimTK::RowVector_<T>& data) { 
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
-        m_data_queue.pop();
-        mlock.unlock(); 
-        time = frontEntry.getTimeStamp();
-        data = frontEntry.getData();
+    /** Pop the front of the queue if the queue is not empty. Returns false
+    (and leaves the arguments unchanged) if the queue is empty. Consumer
+    only.                                                                    */
+    bool try_pop_front(double& time, SimTK::RowVector_<T>& data) {
+        Ring* ring = _front.load(std::memory_order_relaxed);
+        while (true) {
+            if (popFrom(*ring, time, data)) return true;
+            Ring* next = ring->next.load(std::memory_order_acquire);
+            if (!next) return false;
+            // The producer pushed its last entry into this ring before it
+            // published the next ring, so this ring is empty for good once
+            // the entry (if any) that we just missed is popped.
+            if (popFrom(*ring, time, data)) return true;
+            _front.store(next);
+            ring = next;
+        }
     }
     // check if the queue is empty
-    bool isEmpty() { 
-        bool status = false;
-        std::unique_lock<std::mutex> mlock(m_mutex);
-        status = m_data_queue.empty();
-        mlock.unlock(); 
-        return status;
+    bool isEmpty() const { return getSize() == 0; }
+    /** Number of entries currently in the queue. This is only a snapshot if
+    the producer or consumer is active.                                      */
+    size_t getSize() const {
+        size_t size = 0;
+        for (const Ring* ring = _front.load(); ring;
+                ring = ring->next.load(std::memory_order_acquire)) {
+            const std::uint64_t head = ring->head.load();
+            size += static_cast<size_t>(ring->tail.load() - head);
+        }
+        return size;
     }
+    /** Maximum number of entries the queue holds, or 0 if the queue is
+    unbounded.                                                               */
+    size_t getCapacity() const { return _capacity; }
+    DataQueueOverflowPolicy getOverflowPolicy() const { return _policy; }
+    /** Number of entries discarded because the queue was full.              */
+    std::uint64_t getNumDroppedFrames() const { return _numDropped.load(); }
+    /** Number of entries pushed with a timestamp that was not later than the
+    timestamp of the previously pushed entry.                                */
+    std::uint64_t getNumLateFrames() const { return _numLate.load(); }
+
 private:
-    // As of now we use std::queue but other data structures could be used as well
-    std::queue<DataQueueEntry_<T>> m_data_queue;
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
+    struct Slot {
+        double time{SimTK::NaN};
+        SimTK::RowVector_<T> data;
+    };
+    static constexpr std::uint64_t NotReading =
+            std::numeric_limits<std::uint64_t>::max();
+    static constexpr size_t InitialUnboundedCapacity = 256;
+
+    struct Ring {
+        Ring(size_t capacity, int numColumns) :
+                capacity(capacity),
+                // One extra slot so that the producer can fill the ring
+                // while the consumer is still copying out the entry it just
+                // popped.
+                slots(capacity + 1) {
+            for (auto& slot : slots) slot.data.resize(numColumns);
+        }
+        const size_t capacity;
+        std::vector<Slot> slots;
+        // Indices of the entries (not the slots) at the front and one past
+        // the back of the ring. They only ever increase. The producer owns
+        // tail; the consumer advances head, and so does the producer when it
+        // drops the oldest entry.
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<std::uint64_t> tail{0};
+        // Index of the entry the consumer is copying from, or NotReading.
+        std::atomic<std::uint64_t> reading{NotReading};
+        // The ring the producer continued in once this one was full.
+        std::atomic<Ring*> next{nullptr};
+    };
+
+    bool isFull() const { return _capacity && getSize() >= _capacity; }
+
+    // Add an empty ring after the back ring and make it the back ring.
+    Ring* appendRing(size_t capacity, int numColumns) {
+        _rings.emplace_back(new Ring(capacity, numColumns));
+        Ring* ring = _rings.back().get();
+        if (_back)
+            _back->next.store(ring, std::memory_order_release);
+        else
+            _front.store(ring);
+        _back = ring;
+        return ring;
+    }
+
+    bool popFrom(Ring& ring, double& time, SimTK::RowVector_<T>& data) {
+        std::uint64_t head = ring.head.load();
+        while (true) {
+            if (head == ring.tail.load(std::memory_order_acquire)) {
+                ring.reading.store(NotReading);
+                return false;
+            }
+            // Announce the slot before claiming it so that the producer
+            // cannot reuse it while we copy out of it.
+            ring.reading.store(head);
+            if (ring.head.compare_exchange_weak(head, head + 1)) break;
+        }
+        const Slot& slot = ring.slots[head % ring.slots.size()];
+        time = slot.time;
+        data = slot.data;
+        ring.reading.store(NotReading);
+        return true;
+    }
+
+    void copyFrom(const DataQueue_& other) {
+        _capacity = other._capacity;
+        _policy = other._policy;
+        _rings.clear();
+        _back = nullptr;
+        const Slot& lastSlot = other._back->slots.back();
+        const size_t size = other.getSize();
+        Ring* ring = appendRing(
+                _capacity ? _capacity : std::max(other._back->capacity, size),
+                lastSlot.data.size());
+        std::uint64_t tail = 0;
+        for (const Ring* from = other._front.load(); from;
+                from = from->next.load()) {
+            for (std::uint64_t i = from->head.load(); i < from->tail.load();
+                    ++i) {
+                ring->slots[tail++] = from->slots[i % from->slots.size()];
+            }
+        }
+        ring->tail.store(tail);
+        _numDropped.store(other._numDropped.load());
+        _numLate.store(other._numLate.load());
+        _lastPushTime = other._lastPushTime;
+    }
+
+    // Spin briefly, then yield, then sleep, so that waiting for a slow
+    // producer/consumer does not burn a core.
+    static void backoff(unsigned& attempt) {
+        if (attempt < 64) {
+            ++attempt;
+        } else if (attempt < 128) {
+            ++attempt;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    size_t _capacity;
+    DataQueueOverflowPolicy _policy;
+    // All rings, oldest first. Only the producer adds rings, and rings are
+    // not freed before the queue is, so the consumer can still read the ring
+    // it is emptying after the producer has moved on.
+    std::vector<std::unique_ptr<Ring>> _rings;
+    // The ring the consumer pops from (written by the consumer) and the ring
+    // the producer pushes to (only accessed by the producer).
+    std::atomic<Ring*> _front{nullptr};
+    Ring* _back{nullptr};
+    std::atomic<std::uint64_t> _numDropped{0};
+    std::atomic<std::uint64_t> _numLate{0};
+    // Only accessed by the producer.
+    double _lastPushTime{-SimTK::Infinity};
 
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
 //=============================================================================
+#endif // SWIG
 }
 
 #endif // OPENSIM_DATA_QUEUE_H_
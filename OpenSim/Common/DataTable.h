@@ -34,6 +34,7 @@ in-memory container for data access and manipulation.                         */
 #include "SimTKcommon/internal/Quaternion.h"
 #include <OpenSim/Common/IO.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -662,15 +663,40 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        const int row{static_cast<int>(_indData.size())};
+        if(row == 0 && _depData.ncol() != depRow.ncol())
+            _depData.resize(std::max(_depData.nrow(), 1), depRow.ncol());
+        else if(row == _depData.nrow())
+            // Grow the capacity geometrically so that building a table one
+            // row at a time is amortized constant time per row.
+            _depData.resizeKeep(std::max(2 * row, 1), _depData.ncol());
+
+        _depData.updRow(row) = depRow;
         _indData.push_back(indRow);
+    }
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
-        }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+    /** Reserve storage for at least the given number of rows. Appending rows
+    with appendRow() will not reallocate the table until the number of rows
+    exceeds this capacity. This does not change the number of rows of the
+    table and has no effect if the capacity is already large enough.         */
+    void reserve(size_t numRows) {
+        if(static_cast<int>(numRows) > _depData.nrow())
+            _depData.resizeKeep(static_cast<int>(numRows), _depData.ncol());
+    }
+
+    /** Get the number of rows the table can hold before appendRow() needs to
+    reallocate. This is never less than getNumRows().                         */
+    size_t getRowCapacity() const {
+        return static_cast<size_t>(_depData.nrow());
+    }
+
+    /** Release the storage reserved (by reserve() or by appendRow()) beyond the
+    rows of the table. Call this once a table built with appendRow() is
+    complete.                                                                 */
+    void shrinkToFit() {
+        if(_depData.nrow() != static_cast<int>(_indData.size()))
+            _depData.resizeKeep(static_cast<int>(_indData.size()),
+                                _depData.ncol());
     }
 
     /** Get row at index.                                                     
@@ -788,8 +814,8 @@ public:
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
-        
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+
+        // The last row is kept as reserved storage; see shrinkToFit().
         _indData.erase(_indData.begin() + index);
     }
 
@@ -942,7 +968,8 @@ public:
                          IncorrectNumRows,
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
-        
+
+        shrinkToFit();
         _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
@@ -998,7 +1025,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData.col(static_cast<int>(index))(0, (int)getNumRows());
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1033,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)))(
+                0, (int)getNumRows());
     }
 
     /** Update dependent column at index.
@@ -1020,7 +1048,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return _depData.updCol(static_cast<int>(index))(0, (int)getNumRows());
     }
 
     /** Update dependent Column which has the given column label.
@@ -1028,7 +1056,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)))(
+                0, (int)getNumRows());
     }
 
     /** %Set value of the independent column at index.
@@ -1056,8 +1085,9 @@ public:
     /// @{
 
     /** Get a read-only view to the underlying matrix.                        */
-    const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+    MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(getNumRows()),
+                              _depData.ncol());
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,11 +1109,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1099,8 +1129,10 @@ public:
                               static_cast<int>(numColumns));
     }
 
-    /** Get a writable view to the underlying matrix.                         */
+    /** Get a writable view to the underlying matrix. Any storage reserved
+    beyond the rows of the table is released first (see shrinkToFit()).      */
     MatrixView& updMatrix() {
+        shrinkToFit();
         return _depData.updAsMatrixView();
     }
 
@@ -1123,11 +1155,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1318,7 +1350,7 @@ protected:
             rowData.push_back(toStr(getIndependentColumn()[row]));
             for(const auto& col : cols)
                 for(const auto& comp :
-                        splitElement(getMatrix().getElt(row, col)))
+                        splitElement(_depData.getElt(row, col)))
                         rowData.push_back(toStr(comp));
             table.push_back(std::move(rowData));
         }
@@ -1557,7 +1589,7 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
@@ -1662,6 +1694,7 @@ protected:
     }
 
     std::vector<ETX>    _indData;
+    // Rows beyond _indData.size() are storage reserved for appendRow().
     SimTK::Matrix_<ETY> _depData;
 };  // DataTable_
 
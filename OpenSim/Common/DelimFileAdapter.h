@@ -25,10 +25,15 @@
 #include "SimTKcommon.h"
 
 #include "About.h"
+#include "CommonUtilities.h"
 #include "FileAdapter.h"
+#include "MemoryMappedFile.h"
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <fstream>
 #include <regex>
@@ -129,6 +134,13 @@ protected:
     inline SimTK::RowVector_<T> 
     readElems(const std::vector<std::string>& tokens) const;
 
+    /** Parse one data row, given without its line ending, into the time
+    and the given row of the matrix. Tokens are split and trimmed exactly as
+    getNextLine() does, but without allocating memory.                        */
+    void parseRow(const char* begin, const char* end,
+                  const std::string& fileName, size_t line_num,
+                  double& time, SimTK::Matrix_<T>& matrix, int row) const;
+
     /** Write an element of type T (template parameter) to stream with the
     specified precision.                                                      */
     inline void writeElem(std::ostream& stream, 
@@ -162,6 +174,28 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
+    /** Following overloads parse one element from the characters in
+    [begin, end).                                                             */
+    inline double
+    parseElem_impl(const char* begin, const char* end, double) const;
+    inline SimTK::UnitVec3
+    parseElem_impl(const char* begin, const char* end, SimTK::UnitVec3) const;
+    inline SimTK::Quaternion
+    parseElem_impl(const char* begin, const char* end,
+                   SimTK::Quaternion) const;
+    inline SimTK::SpatialVec
+    parseElem_impl(const char* begin, const char* end,
+                   SimTK::SpatialVec) const;
+    template<int M>
+    inline SimTK::Vec<M>
+    parseElem_impl(const char* begin, const char* end, SimTK::Vec<M>) const;
+
+    /** Split [begin, end) into components using the component delimiters,
+    check that there are exactly N of them, and convert them to doubles.     */
+    template<int N>
+    void parseComponents(const char* begin, const char* end,
+                         double (&comps)[N]) const;
+
     /** Following overloads implement writeElem().                            */
     inline void writeElem_impl(std::ostream& stream,
                                const double& elem,
@@ -174,6 +208,11 @@ private:
                                const SimTK::Vec<M>& elem,
                                const unsigned& prec) const;
       
+    /** Whether the character is removed by IO::TrimWhitespace().           */
+    static bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
     /** Trim string -- remove specified leading and trailing characters from 
     string. Trims out whitespace by default.                                  */
     static std::string trim(const std::string& str, const char& ch = ' ');
@@ -310,7 +349,9 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
+    // Binary mode so that tellg() below gives the offset of the data in the
+    // file; CRLF line endings are handled explicitly.
+    std::ifstream in_stream{fileName, std::ios::binary};
     OPENSIM_THROW_IF(!in_stream.good(),
                      FileDoesNotExist,
                      fileName);
@@ -401,55 +442,53 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
-    timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
-    // Initialize current row and capacity
-    int curCapacity = initCapacity;
-    int curRow = 0;
-
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
-        ++line_num;
-        
-        // Double capacity if we reach the end of the containers.
-        // This is necessary until Simbody issue #401 is addressed.
-        if (curRow+1 > curCapacity) {
-            curCapacity *= 2;
-            timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
-        }
-
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
+    // The remaining lines are the data rows. Parse them directly from a
+    // memory-mapped view of the file, writing each row into a preallocated
+    // matrix. tellg() fails if the labels were on the last line.
+    const std::streamoff dataOffset = in_stream.tellg();
+    in_stream.close();
+    MemoryMappedFile file{fileName};
+    const char* const fileEnd = file.getData() + file.getSize();
+    const char* const dataBegin = dataOffset < 0 ? fileEnd :
+            file.getData() + std::min<std::streamoff>(dataOffset,
+                                                      file.getSize());
+
+    // Find the rows. As when reading line by line, an empty line ends the
+    // data.
+    std::vector<std::pair<const char*, const char*>> rows;
+    for(const char* cur = dataBegin; cur < fileEnd;) {
+        const char* eol = static_cast<const char*>(
+                std::memchr(cur, '\n', fileEnd - cur));
+        if(!eol) eol = fileEnd;
+        const char* rowEnd = eol;
+        // Handle CRLF (\r\n) line endings.
+        if(rowEnd > cur && *(rowEnd - 1) == '\r') --rowEnd;
+        if(rowEnd == cur) break;
+        rows.emplace_back(cur, rowEnd);
+        cur = eol + 1;
+    }
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
-            RowLengthMismatch,
-            fileName,
-            line_num,
-            column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
+    const int ncol = static_cast<int>(column_labels.size());
+    const int nrow = static_cast<int>(rows.size());
+    std::vector<double> timeVec(nrow);
+    SimTK::Matrix_<T> matrix(nrow, ncol);
 
-        row = nextLine();
-        ++curRow;
-    }
+    auto parseRows = [&](int begin, int end) {
+        for(int row = begin; row < end; ++row) {
+            parseRow(rows[row].first, rows[row].second, fileName,
+                     line_num + row + 1, timeVec[row], matrix, row);
+        }
+    };
 
-    // Resize the matrix down to the correct number of rows.
-    // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
+    // Parse large files in parallel, in contiguous blocks of rows. Each
+    // thread stops at its first error; reporting the error of the first
+    // block that failed gives the same error as parsing serially.
+    const size_t minBytesPerThread = 1 << 20;
+    const int numMebibytes = static_cast<int>(std::min<size_t>(
+            (fileEnd - dataBegin) / minBytesPerThread,
+            std::numeric_limits<int>::max()));
+    runInContiguousChunks(nrow, getNumThreadsForParallel(1, numMebibytes),
+            [&](int, int begin, int end) { parseRows(begin, end); });
 
     // Create the table and update other metadata from above
     auto table = 
@@ -462,6 +501,131 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     return output_tables;
 }
 
+template<typename T>
+void
+DelimFileAdapter<T>::parseRow(const char* begin, const char* end,
+                              const std::string& fileName, size_t line_num,
+                              double& time, SimTK::Matrix_<T>& matrix,
+                              int row) const {
+    const int ncol = matrix.ncol();
+    // Column -1 is time.
+    int col = -1;
+    auto parseToken = [&](const char* tokenBegin, const char* tokenEnd) {
+        while(tokenBegin != tokenEnd && isWhitespace(*tokenBegin))
+            ++tokenBegin;
+        while(tokenEnd != tokenBegin && isWhitespace(*(tokenEnd - 1)))
+            --tokenEnd;
+        if(col == -1)
+            time = parseDouble(tokenBegin, tokenEnd);
+        else if(col < ncol)
+            matrix.updElt(row, col) = parseElem_impl(tokenBegin, tokenEnd, T{});
+        ++col;
+    };
+    const char* tokenBegin = begin;
+    for(const char* cur = begin; cur != end; ++cur) {
+        if(_delimitersRead.find(*cur) != std::string::npos) {
+            parseToken(tokenBegin, cur);
+            tokenBegin = cur + 1;
+        }
+    }
+    // As in tokenize(), a delimiter at the end of the row does not start
+    // another token.
+    if(end > tokenBegin)
+        parseToken(tokenBegin, end);
+
+    OPENSIM_THROW_IF(col != ncol,
+        RowLengthMismatch,
+        fileName,
+        line_num,
+        static_cast<size_t>(ncol),
+        static_cast<size_t>(std::max(col, 0)));
+}
+
+template<typename T>
+template<int N>
+void
+DelimFileAdapter<T>::parseComponents(const char* begin, const char* end,
+                                     double (&comps)[N]) const {
+    // Find the components first so that the number of components is checked
+    // before any of them is converted, as in readElems().
+    const char* compBegin[N];
+    const char* compEnd[N];
+    int numComps = 0;
+    auto addComp = [&](const char* b, const char* e) {
+        if(numComps < N) {
+            while(b != e && isWhitespace(*b)) ++b;
+            while(e != b && isWhitespace(*(e - 1))) --e;
+            compBegin[numComps] = b;
+            compEnd[numComps] = e;
+        }
+        ++numComps;
+    };
+    const char* b = begin;
+    for(const char* cur = begin; cur != end; ++cur) {
+        if(_compDelimRead.find(*cur) != std::string::npos) {
+            addComp(b, cur);
+            b = cur + 1;
+        }
+    }
+    if(end > b)
+        addComp(b, end);
+    OPENSIM_THROW_IF(numComps != N,
+                     IncorrectNumTokens,
+                     "Expected " + std::to_string(N) +
+                     "x (multiple of " + std::to_string(N) +
+                     ") number of tokens.");
+    for(int i = 0; i < N; ++i)
+        comps[i] = parseDouble(compBegin[i], compEnd[i]);
+}
+
+template<typename T>
+double
+DelimFileAdapter<T>::parseElem_impl(const char* begin, const char* end,
+                                    double) const {
+    return parseDouble(begin, end);
+}
+
+template<typename T>
+SimTK::UnitVec3
+DelimFileAdapter<T>::parseElem_impl(const char* begin, const char* end,
+                                    SimTK::UnitVec3) const {
+    double comps[3];
+    parseComponents(begin, end, comps);
+    return SimTK::UnitVec3{comps[0], comps[1], comps[2]};
+}
+
+template<typename T>
+SimTK::Quaternion
+DelimFileAdapter<T>::parseElem_impl(const char* begin, const char* end,
+                                    SimTK::Quaternion) const {
+    double comps[4];
+    parseComponents(begin, end, comps);
+    return SimTK::Quaternion{comps[0], comps[1], comps[2], comps[3]};
+}
+
+template<typename T>
+SimTK::SpatialVec
+DelimFileAdapter<T>::parseElem_impl(const char* begin, const char* end,
+                                    SimTK::SpatialVec) const {
+    double comps[6];
+    parseComponents(begin, end, comps);
+    return SimTK::SpatialVec{{comps[0], comps[1], comps[2]},
+                             {comps[3], comps[4], comps[5]}};
+}
+
+template<typename T>
+template<int M>
+SimTK::Vec<M>
+DelimFileAdapter<T>::parseElem_impl(const char* begin, const char* end,
+                                    SimTK::Vec<M>) const {
+    double comps[M];
+    parseComponents(begin, end, comps);
+    SimTK::Vec<M> elem;
+    for(int j = 0; j < M; ++j)
+        elem[j] = comps[j];
+    return elem;
+}
+
 template<typename T>
 SimTK::RowVector_<T>
 DelimFileAdapter<T>::readElems(const std::vector<std::string>& tokens) const {
@@ -2,6 +2,12 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -64,6 +70,84 @@ FileAdapter::tokenize(const std::string& str,
     return tokens;
 }
 
+double
+FileAdapter::parseDouble(const char* begin, const char* end) {
+    // Fast path: [+-]digits[.digits][(e|E)[+-]digits], with at most 19
+    // significant digits. If the significand is at most 2^53 and the power of
+    // ten is at most 22 in magnitude, both are exactly representable, and a
+    // single multiplication or division gives the correctly rounded result,
+    // which is what strtod() returns (Clinger's fast path).
+    const char* p = begin;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    std::uint64_t significand = 0;
+    int numDigits = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p, ++numDigits) {
+        if (significand || *p != '0') {
+            significand = 10 * significand + (*p - '0');
+            ++numSignificantDigits;
+        }
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++numDigits) {
+            if (significand || *p != '0') {
+                significand = 10 * significand + (*p - '0');
+                ++numSignificantDigits;
+            }
+            --exponent;
+        }
+    }
+    bool fast = numDigits > 0 && numSignificantDigits <= 19;
+    if (fast && p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p != end && (*p == '-' || *p == '+'))
+            negativeExponent = *p++ == '-';
+        int explicitExponent = 0;
+        const char* exponentBegin = p;
+        for (; p != end && *p >= '0' && *p <= '9' && explicitExponent < 1000;
+                ++p) {
+            explicitExponent = 10 * explicitExponent + (*p - '0');
+        }
+        fast = p != exponentBegin;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+            1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+            1e18, 1e19, 1e20, 1e21, 1e22};
+    if (fast && p == end && significand <= (std::uint64_t(1) << 53) &&
+            exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(significand);
+        if (exponent < 0)
+            value /= powersOf10[-exponent];
+        else
+            value *= powersOf10[exponent];
+        return negative ? -value : value;
+    }
+
+    // Slow path: same as std::stod(), but copying to a buffer on the stack
+    // when possible.
+    const std::size_t size = end - begin;
+    char buffer[64];
+    std::string longToken;
+    const char* str = buffer;
+    if (size < sizeof(buffer)) {
+        std::memcpy(buffer, begin, size);
+        buffer[size] = '\0';
+    } else {
+        longToken.assign(begin, end);
+        str = longToken.c_str();
+    }
+    char* strEnd = nullptr;
+    errno = 0;
+    const double value = std::strtod(str, &strEnd);
+    if (strEnd == str) throw std::invalid_argument("stod");
+    if (errno == ERANGE) throw std::out_of_range("stod");
+    return value;
+}
+
 std::vector<std::string>
 FileAdapter::getNextLine(std::istream& stream,
                          const std::string& delims) {
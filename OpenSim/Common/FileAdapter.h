@@ -213,6 +213,16 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** Convert the characters in [begin, end) to a double without allocating
+    memory. The result is the same as that of std::stod() on the same
+    characters, including the exceptions thrown (std::invalid_argument if no
+    conversion could be performed, std::out_of_range if the value is out of
+    range). Plain decimal numbers with up to 19 significant digits and
+    moderate exponents are converted without using the C locale; other
+    numbers (e.g., NaN, Inf, or numbers with many digits) are converted with
+    std::strtod().                                                            */
+    static double parseDouble(const char* begin, const char* end);
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
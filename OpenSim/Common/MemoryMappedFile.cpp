@@ -0,0 +1,113 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  MemoryMappedFile.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MemoryMappedFile.h"
+
+#include "FileAdapter.h"
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace OpenSim;
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName) {
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    OPENSIM_THROW_IF(file == INVALID_HANDLE_VALUE, FileDoesNotExist, fileName);
+    _fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        OPENSIM_THROW(IOError, "Could not get the size of file '" +
+                fileName + "'.");
+    }
+    _size = static_cast<std::size_t>(size.QuadPart);
+    // Empty files cannot be mapped.
+    if (_size == 0) return;
+
+    HANDLE mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        OPENSIM_THROW(IOError, "Could not map file '" + fileName + "'.");
+    }
+    _mappingHandle = mapping;
+    _data = static_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (_data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        OPENSIM_THROW(IOError, "Could not map file '" + fileName + "'.");
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (_data) UnmapViewOfFile(_data);
+    if (_mappingHandle) CloseHandle(_mappingHandle);
+    if (_fileHandle) CloseHandle(_fileHandle);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& fileName) {
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    OPENSIM_THROW_IF(fd == -1, FileDoesNotExist, fileName);
+
+    struct stat status;
+    if (fstat(fd, &status) == -1) {
+        close(fd);
+        OPENSIM_THROW(IOError, "Could not get the size of file '" +
+                fileName + "'.");
+    }
+    _size = static_cast<std::size_t>(status.st_size);
+    // Empty files cannot be mapped.
+    if (_size == 0) {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping remains valid after the file descriptor is closed.
+    close(fd);
+    OPENSIM_THROW_IF(data == MAP_FAILED, IOError,
+            "Could not map file '" + fileName + "'.");
+    // The file is read front to back.
+    madvise(data, _size, MADV_SEQUENTIAL);
+    _data = static_cast<const char*>(data);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (_data) munmap(const_cast<char*>(_data), _size);
+}
+
+#endif
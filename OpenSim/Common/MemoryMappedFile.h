@@ -0,0 +1,65 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  MemoryMappedFile.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_MEMORY_MAPPED_FILE_H_
+#define OPENSIM_MEMORY_MAPPED_FILE_H_
+
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <string>
+
+namespace OpenSim {
+
+/** A read-only view of the contents of a file, mapped into memory by the
+operating system. File adapters use this to parse large files without first
+copying them into a stream buffer. The mapping is released when the object
+is destroyed.
+
+\throws FileDoesNotExist If the file cannot be opened.
+\throws IOError If the file cannot be mapped.                                 */
+class OSIMCOMMON_API MemoryMappedFile {
+public:
+    explicit MemoryMappedFile(const std::string& fileName);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&)            = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /** Pointer to the first byte of the file; nullptr if the file is
+    empty.                                                                    */
+    const char* getData() const { return _data; }
+    /** Size of the file in bytes.                                            */
+    std::size_t getSize() const { return _size; }
+
+private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MEMORY_MAPPED_FILE_H_
@@ -0,0 +1,215 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  MultiChannelSpline.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MultiChannelSpline.h"
+
+#include "Constant.h"
+#include "GCVSpline.h"
+#include "PiecewiseLinearFunction.h"
+#include "SimmSpline.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+namespace {
+// The polynomial degree (1 or 3) of a function that is piecewise polynomial
+// between the points returned by getXValues(), 0 for a Constant, and -1 if
+// the function is not supported.
+int getPiecewiseDegree(const Function& function) {
+    if (dynamic_cast<const Constant*>(&function)) return 0;
+    if (dynamic_cast<const PiecewiseLinearFunction*>(&function)) return 1;
+    if (dynamic_cast<const SimmSpline*>(&function)) return 3;
+    if (const auto* gcv = dynamic_cast<const GCVSpline*>(&function)) {
+        const int degree = gcv->getDegree();
+        if (degree == 1 || degree == 3) return degree;
+    }
+    return -1;
+}
+} // anonymous namespace
+
+MultiChannelSpline::MultiChannelSpline(
+        const std::vector<const Function*>& channels) {
+    // Find the knots shared by the tabulated channels.
+    for (const auto* function : channels) {
+        if (!function) continue;
+        if (getPiecewiseDegree(*function) <= 0) continue;
+        const int numKnots = function->getNumberOfPoints();
+        if (numKnots < 2) continue;
+        const double* x = function->getXValues();
+        m_knots.assign(x, x + numKnots);
+        break;
+    }
+    for (int i = 1; i < (int)m_knots.size(); ++i) {
+        // Repeated knots would create empty intervals.
+        if (!(m_knots[i] > m_knots[i - 1])) {
+            m_knots.clear();
+            break;
+        }
+    }
+
+    std::vector<int> degrees;
+    for (int ic = 0; ic < (int)channels.size(); ++ic) {
+        const Function* function = channels[ic];
+        m_channels.emplace_back(function ? function->clone() : nullptr);
+        // Null channels are tabulated with zero coefficients.
+        int degree = function ? getPiecewiseDegree(*function) : 0;
+        if (degree > 0) {
+            const int numKnots = function->getNumberOfPoints();
+            if (numKnots != (int)m_knots.size() ||
+                    !std::equal(m_knots.begin(), m_knots.end(),
+                            function->getXValues())) {
+                degree = -1;
+            }
+        }
+        if (degree < 0 || m_knots.empty()) {
+            m_otherChannels.push_back(ic);
+        } else {
+            m_tabulatedChannels.push_back(ic);
+            degrees.push_back(degree);
+        }
+    }
+    m_numTabulated = (int)m_tabulatedChannels.size();
+    if (!m_numTabulated) {
+        m_knots.clear();
+        return;
+    }
+
+    // Compute the coefficients of each interval from the values (and, for
+    // cubic splines, which have continuous first derivatives, the slopes) of
+    // the functions at the knots.
+    const int numIntervals = (int)m_knots.size() - 1;
+    m_coefficients.assign(4 * numIntervals * m_numTabulated, 0.0);
+    SimTK::Vector x(1);
+    const std::vector<int> firstDerivative{0};
+    for (int c = 0; c < m_numTabulated; ++c) {
+        if (!m_channels[m_tabulatedChannels[c]]) continue;
+        const Function& function = *m_channels[m_tabulatedChannels[c]];
+        const int degree = degrees[c];
+        std::vector<double> values(m_knots.size());
+        std::vector<double> slopes(m_knots.size(), 0.0);
+        for (int i = 0; i < (int)m_knots.size(); ++i) {
+            x[0] = m_knots[i];
+            values[i] = function.calcValue(x);
+            if (degree == 3) {
+                slopes[i] = function.calcDerivative(firstDerivative, x);
+            }
+        }
+        for (int i = 0; i < numIntervals; ++i) {
+            const double h = m_knots[i + 1] - m_knots[i];
+            const double secant = (values[i + 1] - values[i]) / h;
+            double* coefs = &m_coefficients[4 * i * m_numTabulated + c];
+            coefs[0] = values[i];
+            if (degree == 0) continue;
+            if (degree == 1) {
+                coefs[m_numTabulated] = secant;
+                continue;
+            }
+            // Cubic Hermite interpolation in the power basis.
+            coefs[m_numTabulated] = slopes[i];
+            coefs[2 * m_numTabulated] =
+                    (3 * secant - 2 * slopes[i] - slopes[i + 1]) / h;
+            coefs[3 * m_numTabulated] =
+                    (slopes[i] + slopes[i + 1] - 2 * secant) / (h * h);
+        }
+    }
+}
+
+MultiChannelSpline::MultiChannelSpline(const MultiChannelSpline& other)
+        : m_channels(other.m_channels),
+          m_tabulatedChannels(other.m_tabulatedChannels),
+          m_otherChannels(other.m_otherChannels),
+          m_numTabulated(other.m_numTabulated), m_knots(other.m_knots),
+          m_coefficients(other.m_coefficients),
+          m_lastInterval(other.m_lastInterval.load()) {}
+
+MultiChannelSpline& MultiChannelSpline::operator=(
+        const MultiChannelSpline& other) {
+    if (this == &other) return *this;
+    m_channels = other.m_channels;
+    m_tabulatedChannels = other.m_tabulatedChannels;
+    m_otherChannels = other.m_otherChannels;
+    m_numTabulated = other.m_numTabulated;
+    m_knots = other.m_knots;
+    m_coefficients = other.m_coefficients;
+    m_lastInterval = other.m_lastInterval.load();
+    return *this;
+}
+
+int MultiChannelSpline::findInterval(double x) const {
+    const int numIntervals = (int)m_knots.size() - 1;
+    int i = m_lastInterval.load(std::memory_order_relaxed);
+    if (i < numIntervals && m_knots[i] <= x && x <= m_knots[i + 1]) return i;
+    ++i;
+    if (i < numIntervals && m_knots[i] <= x && x <= m_knots[i + 1]) {
+        m_lastInterval.store(i, std::memory_order_relaxed);
+        return i;
+    }
+    // The caller ensures that x is within the range of the knots.
+    i = (int)(std::upper_bound(m_knots.begin(), m_knots.end(), x) -
+              m_knots.begin()) - 1;
+    i = std::min(std::max(i, 0), numIntervals - 1);
+    m_lastInterval.store(i, std::memory_order_relaxed);
+    return i;
+}
+
+void MultiChannelSpline::calcValues(double x, double* values) const {
+    const int numChannels = getNumChannels();
+    if (!m_numTabulated || x < m_knots.front() || x > m_knots.back()) {
+        SimTK::Vector xAsVector(1, x);
+        for (int ic = 0; ic < numChannels; ++ic) {
+            values[ic] = m_channels[ic] ? m_channels[ic]->calcValue(xAsVector)
+                                        : 0.0;
+        }
+        return;
+    }
+
+    const int i = findInterval(x);
+    const double dx = x - m_knots[i];
+    const int n = m_numTabulated;
+    const double* a = &m_coefficients[4 * i * n];
+    const double* b = a + n;
+    const double* c = b + n;
+    const double* d = c + n;
+    if (m_otherChannels.empty()) {
+        // The tabulated channels are all of the channels, in order.
+        for (int k = 0; k < n; ++k) {
+            values[k] = a[k] + dx * (b[k] + dx * (c[k] + dx * d[k]));
+        }
+        return;
+    }
+
+    for (int k = 0; k < n; ++k) {
+        values[m_tabulatedChannels[k]] =
+                a[k] + dx * (b[k] + dx * (c[k] + dx * d[k]));
+    }
+    SimTK::Vector xAsVector(1, x);
+    for (int ic : m_otherChannels) {
+        values[ic] = m_channels[ic]->calcValue(xAsVector);
+    }
+}
+
+SimTK::Vector MultiChannelSpline::calcValues(double x) const {
+    SimTK::Vector values(getNumChannels());
+    if (values.size()) calcValues(x, &values[0]);
+    return values;
+}
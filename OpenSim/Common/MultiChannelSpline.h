@@ -0,0 +1,93 @@
+#ifndef OPENSIM_MULTI_CHANNEL_SPLINE_H_
+#define OPENSIM_MULTI_CHANNEL_SPLINE_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  MultiChannelSpline.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "Function.h"
+
+#include <atomic>
+#include <vector>
+
+namespace OpenSim {
+
+/** Evaluates several scalar functions of one variable (e.g., the x, y, and z
+components of a force, its point of application, and a torque as functions of
+time) at the same abscissa, sharing the search for the interval that
+contains the abscissa among all channels.
+
+Channels that are Constant functions, PiecewiseLinearFunctions, SimmSplines,
+or GCVSplines of degree 1 or 3 are converted to piecewise polynomial
+coefficients, provided they have the same knots as the first such channel.
+The coefficients are stored interval by interval, so that all of these
+channels are evaluated in a single loop. The interval found by the last
+evaluation is tried first (and then the next interval), which makes the
+search constant-time when the abscissa increases monotonically, as with the
+time during a simulation. All other channels, and all channels for abscissae
+outside the range of the knots, are evaluated with Function::calcValue().
+Results agree with Function::calcValue() up to roundoff.
+
+A null channel always evaluates to 0. This class keeps copies of the
+functions, so the original functions need not outlive it. Evaluation may be
+called from multiple threads concurrently. */
+class OSIMCOMMON_API MultiChannelSpline {
+public:
+    MultiChannelSpline() = default;
+    explicit MultiChannelSpline(const std::vector<const Function*>& channels);
+    MultiChannelSpline(const MultiChannelSpline& other);
+    MultiChannelSpline& operator=(const MultiChannelSpline& other);
+
+    int getNumChannels() const { return (int)m_channels.size(); }
+    /** The number of channels evaluated from piecewise polynomial
+    coefficients (rather than by their Function) within the knot range. */
+    int getNumTabulatedChannels() const { return m_numTabulated; }
+
+    /** Evaluate all channels at x. `values` must have getNumChannels()
+    elements. */
+    void calcValues(double x, double* values) const;
+    /** Evaluate all channels at x. */
+    SimTK::Vector calcValues(double x) const;
+
+private:
+    int findInterval(double x) const;
+
+    // Copies of the functions; null for null channels.
+    std::vector<SimTK::ClonePtr<Function>> m_channels;
+    // For each tabulated channel (in the order of m_coefficients), the index
+    // of the channel.
+    std::vector<int> m_tabulatedChannels;
+    // Channels with a Function that is not tabulated.
+    std::vector<int> m_otherChannels;
+    int m_numTabulated = 0;
+    std::vector<double> m_knots;
+    // For interval i and tabulated channel c, the polynomial
+    // a + b dx + c dx^2 + d dx^3 with dx = x - knots[i] has coefficients
+    // m_coefficients[(4 * i + p) * m_numTabulated + c], p = 0 for a, 1 for b,
+    // and so on.
+    std::vector<double> m_coefficients;
+    // The interval used by the last evaluation.
+    mutable std::atomic<int> m_lastInterval{0};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MULTI_CHANNEL_SPLINE_H_
@@ -38,6 +38,7 @@
 #include "PropertyTransform.h"
 #include "Property_Deprecated.h"
 #include "XMLDocument.h"
+#include <atomic>
 #include <fstream>
 
 using namespace OpenSim;
@@ -55,6 +56,11 @@ std::map<string,string>     Object::_renamedTypesMap;
 bool                        Object::_serializeAllDefaults=false;
 const string                Object::DEFAULT_NAME(ObjectDEFAULT_NAME);
 
+namespace {
+// Incremented by setName() whenever it changes a name.
+std::atomic<unsigned long long> numNameChanges{0};
+}
+
 //=============================================================================
 // CONSTRUCTOR(S)
 //=============================================================================
@@ -303,7 +309,18 @@ operator<(const Object& other) const
 void Object::
 setName(const string &aName)
 {
+    if (aName == _name) return;
     _name = aName;
+    ++numNameChanges;
+}
+//_____________________________________________________________________________
+/**
+ * Get the number of times that setName() changed the name of any object.
+ */
+unsigned long long Object::
+getNumNameChanges()
+{
+    return numNameChanges.load();
 }
 //_____________________________________________________________________________
 /**
@@ -272,6 +272,11 @@ public:
     void setName(const std::string& name);
     /** Get the name of this Object. */
     const std::string& getName() const;
+#ifndef SWIG
+    /** The number of times that setName() changed the name of any Object
+    (e.g., Component uses this to detect renamed subcomponents). */
+    static unsigned long long getNumNameChanges();
+#endif
     /** %Set description, a one-liner summary. */
     void setDescription(const std::string& description);
     /** Get description, a one-liner summary. */
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -200,7 +201,10 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_polyKnots.empty())
+    {
+        yVal = calcPiecewisePolynomial(x, 0);
+    }else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -269,7 +273,9 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(x >= _x0 && x <= _x1 && order <= 2 && !_polyKnots.empty()){
+                yVal = calcPiecewisePolynomial(x, order);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -388,6 +394,212 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
     return yVal;
 }
 
+void SmoothSegmentedFunction::calcValueAndDerivatives(double x, double& y,
+                                    double& dydx, double& d2ydx2) const
+{
+    if(x < _x0 || x > _x1 || !(x == x)){
+        // Linear extrapolation (or NaN).
+        y = calcValue(x);
+        dydx = calcDerivative(x,1);
+        d2ydx2 = 0;
+    }else if(!_polyKnots.empty()){
+        const int i = findPiecewisePolynomialInterval(x);
+        const double* c = &_polyCoefficients[6*i];
+        const double t = x - _polyKnots[i];
+        y      = c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+        dydx   = c[1] + t*(2*c[2] + t*(3*c[3] + t*(4*c[4] + t*5*c[5])));
+        d2ydx2 = 2*c[2] + t*(6*c[3] + t*(12*c[4] + t*20*c[5]));
+    }else{
+        int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+        double u = SegmentedQuinticBezierToolkit::
+                        calcU(x,_mXVec[idx], _arraySplineUX[idx],
+                        UTOL,MAXITER);
+        y = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveVal(u,_mYVec[idx]);
+        dydx = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx],
+                        _mYVec[idx], 1);
+        d2ydx2 = SegmentedQuinticBezierToolkit::
+                        calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx],
+                        _mYVec[idx], 2);
+    }
+}
+
+void SmoothSegmentedFunction::calcValues(int n, const double* x, double* y,
+                                         double* dydx) const
+{
+    if(_polyKnots.empty()){
+        for(int k=0; k < n; k++){
+            y[k] = calcValue(x[k]);
+            if(dydx) dydx[k] = calcDerivative(x[k],1);
+        }
+        return;
+    }
+
+    // Points are processed in chunks: the coefficients of the polynomial of
+    // each point are gathered first (the linear extrapolation is a
+    // polynomial too), and then all polynomials of the chunk are evaluated
+    // in loops without branches.
+    const int chunkSize = 64;
+    double t[chunkSize];
+    double c[6][chunkSize];
+    for(int start=0; start < n; start += chunkSize){
+        const int m = std::min(chunkSize, n - start);
+        for(int k=0; k < m; k++){
+            const double xk = x[start+k];
+            if(xk >= _x0 && xk <= _x1){
+                const int i = findPiecewisePolynomialInterval(xk);
+                const double* ci = &_polyCoefficients[6*i];
+                t[k] = xk - _polyKnots[i];
+                for(int j=0; j < 6; j++) c[j][k] = ci[j];
+            }else{
+                const bool left = !(xk > _x1);
+                t[k] = xk - (left ? _x0 : _x1);
+                c[0][k] = left ? _y0 : _y1;
+                c[1][k] = left ? _dydx0 : _dydx1;
+                for(int j=2; j < 6; j++) c[j][k] = 0;
+            }
+        }
+        double* yk = y + start;
+        for(int k=0; k < m; k++){
+            yk[k] = c[0][k] + t[k]*(c[1][k] + t[k]*(c[2][k] + t[k]*(c[3][k]
+                    + t[k]*(c[4][k] + t[k]*c[5][k]))));
+        }
+        if(dydx){
+            double* dk = dydx + start;
+            for(int k=0; k < m; k++){
+                dk[k] = c[1][k] + t[k]*(2*c[2][k] + t[k]*(3*c[3][k]
+                        + t[k]*(4*c[4][k] + t[k]*5*c[5][k])));
+            }
+        }
+    }
+}
+
+void SmoothSegmentedFunction::buildPiecewisePolynomial(double tolerance)
+{
+    _polyKnots.clear();
+    _polyCoefficients.clear();
+    if(!(tolerance > 0) || _mXVec.empty()){
+        return;
+    }
+
+    const int maxIntervals = 4096;
+    const int numCheckPoints = 10;
+    const double minWidth = (_x1-_x0)*SimTK::SqrtEps;
+
+    // The value and first two derivatives of Bezier section s at x. The
+    // section is given explicitly so that the one-sided derivatives are used
+    // at the ends of sections.
+    auto calcExact = [&](int s, double x, double* f) {
+        const double u = SegmentedQuinticBezierToolkit::
+                calcU(x,_mXVec[s],_arraySplineUX[s],UTOL,MAXITER);
+        f[0] = SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveVal(u,_mYVec[s]);
+        f[1] = SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],_mYVec[s],1);
+        f[2] = SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u,_mXVec[s],_mYVec[s],2);
+    };
+
+    // Intervals (section, start, end) still to be fitted, with the leftmost
+    // interval at the back.
+    struct Interval { int section; double a; double b; };
+    std::vector<Interval> pending;
+    for(int s=_numBezierSections-1; s >= 0; s--){
+        const double a = (s == 0) ? _x0 : _mXVec[s](0);
+        const double b = (s == _numBezierSections-1) ? _x1 : _mXVec[s+1](0);
+        if(b > a) pending.push_back({s, a, b});
+    }
+
+    std::vector<double> knots;
+    std::vector<double> coefficients;
+    while(!pending.empty()){
+        const Interval interval = pending.back();
+        pending.pop_back();
+        const double a = interval.a;
+        const double b = interval.b;
+        const double h = b - a;
+
+        // Quintic Hermite interpolation of the value and first two
+        // derivatives at both ends.
+        double fa[3], fb[3];
+        calcExact(interval.section, a, fa);
+        calcExact(interval.section, b, fb);
+        double c[6];
+        c[0] = fa[0];
+        c[1] = fa[1];
+        c[2] = 0.5*fa[2];
+        const double A = fb[0] - (c[0] + h*(c[1] + h*c[2]));
+        const double B = (fb[1] - (c[1] + 2*h*c[2]))*h;
+        const double C = (fb[2] - 2*c[2])*h*h;
+        c[3] = (10*A - 4*B + 0.5*C)/(h*h*h);
+        c[4] = (-15*A + 7*B - C)/(h*h*h*h);
+        c[5] = (6*A - 3*B + 0.5*C)/(h*h*h*h*h);
+
+        bool accurate = true;
+        for(int k=0; k < numCheckPoints && accurate; k++){
+            const double t = h*(k + 0.5)/numCheckPoints;
+            double f[3];
+            calcExact(interval.section, a + t, f);
+            const double p[3] = {
+                c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5])))),
+                c[1] + t*(2*c[2] + t*(3*c[3] + t*(4*c[4] + t*5*c[5]))),
+                2*c[2] + t*(6*c[3] + t*(12*c[4] + t*20*c[5]))};
+            for(int j=0; j < 3; j++){
+                if(!(abs(p[j] - f[j]) <= tolerance*max(1.0, abs(f[j])))){
+                    accurate = false;
+                }
+            }
+        }
+
+        const int numIntervals = (int)(knots.size() + pending.size());
+        if(accurate || h <= minWidth || numIntervals + 2 > maxIntervals){
+            knots.push_back(a);
+            coefficients.insert(coefficients.end(), c, c + 6);
+        }else{
+            const double mid = a + 0.5*h;
+            pending.push_back({interval.section, mid, b});
+            pending.push_back({interval.section, a, mid});
+        }
+    }
+    if(knots.empty()){
+        return;
+    }
+    knots.push_back(_x1);
+    _polyKnots = std::move(knots);
+    _polyCoefficients = std::move(coefficients);
+}
+
+int SmoothSegmentedFunction::getNumPiecewisePolynomialIntervals() const
+{
+    return _polyKnots.empty() ? 0 : (int)_polyKnots.size() - 1;
+}
+
+int SmoothSegmentedFunction::findPiecewisePolynomialInterval(double x) const
+{
+    const int numIntervals = (int)_polyKnots.size() - 1;
+    const int i = (int)(std::upper_bound(_polyKnots.begin(),
+                                         _polyKnots.end(), x)
+                        - _polyKnots.begin()) - 1;
+    return min(max(i, 0), numIntervals - 1);
+}
+
+double SmoothSegmentedFunction::calcPiecewisePolynomial(double x,
+                                                        int order) const
+{
+    const int i = findPiecewisePolynomialInterval(x);
+    const double* c = &_polyCoefficients[6*i];
+    const double t = x - _polyKnots[i];
+    switch(order){
+        case 0:
+            return c[0] + t*(c[1] + t*(c[2] + t*(c[3] + t*(c[4] + t*c[5]))));
+        case 1:
+            return c[1] + t*(2*c[2] + t*(3*c[3] + t*(4*c[4] + t*5*c[5])));
+        default:
+            return 2*c[2] + t*(6*c[3] + t*(12*c[4] + t*20*c[5]));
+    }
+}
+
 bool SmoothSegmentedFunction::isIntegralAvailable() const
 {
     return _computeIntegral;
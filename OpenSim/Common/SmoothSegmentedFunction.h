@@ -25,6 +25,8 @@
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
 
+#include <vector>
+
 namespace OpenSim { 
 
     /**
@@ -156,6 +158,54 @@ namespace OpenSim {
 
        */
        double calcIntegral(double x) const;
+
+       /**Calculates the value and the first and second derivatives of the
+       curve at x, sharing the search for the Bezier section (or polynomial
+       interval) and Bezier parameter among them.
+
+       @param x      The domain point of interest
+       @param y      The value of the curve at x
+       @param dydx   The first derivative of the curve at x
+       @param d2ydx2 The second derivative of the curve at x */
+       void calcValueAndDerivatives(double x, double& y, double& dydx,
+                                    double& d2ydx2) const;
+
+       /**Calculates the values (and, if dydx is not null, the first
+       derivatives) of the curve at n domain points. With a piecewise
+       polynomial (see buildPiecewisePolynomial()), the interval of each point
+       is found first, and the polynomials of all points are then evaluated
+       in a loop without branches that the compiler can vectorize.
+
+       @param n    The number of domain points
+       @param x    The n domain points
+       @param y    The n values of the curve
+       @param dydx Null, or the n first derivatives of the curve */
+       void calcValues(int n, const double* x, double* y,
+                       double* dydx = nullptr) const;
+
+       /**Approximates the curve within its domain by piecewise quintic
+       polynomials in x, which calcValue(), calcDerivative() (up to the second
+       derivative), calcValueAndDerivatives(), and calcValues() then evaluate
+       instead of finding the Bezier parameter u by Newton's method.
+
+       The polynomials match the value and the first two derivatives of the
+       curve at the ends of their intervals, so the approximation is
+       continuous to the second derivative. The intervals start as the Bezier
+       sections, and are bisected until the value, first derivative, and
+       second derivative of each polynomial are within
+       tolerance*max(1, |exact|) of those of the Bezier curve at 10 points
+       within the interval (or until there are 4096 intervals). Extrapolation
+       outside of the domain is unchanged.
+
+       @param tolerance The tolerance of the approximation; if it is not
+                        positive, the approximation is discarded and the
+                        Bezier curves are evaluated. */
+       void buildPiecewisePolynomial(double tolerance);
+
+       /**@return The number of intervals of the piecewise polynomial
+       approximation of the curve, or 0 if buildPiecewisePolynomial() has not
+       been called (or was given a tolerance that is not positive).*/
+       int getNumPiecewisePolynomialIntervals() const;
        
        /**
         Returns a bool that indicates if the integral curve has been computed.
@@ -312,6 +362,15 @@ namespace OpenSim {
         SimTK::Array_<SimTK::Spline> _arraySplineUX;        
         /**Spline fit of the integral of the curve y(x)*/
         SimTK::Spline _splineYintX;
+
+        /**The boundaries of the intervals of the piecewise polynomial
+        approximation of the curve (see buildPiecewisePolynomial()), or empty
+        if there is no approximation*/
+        std::vector<double> _polyKnots;
+        /**The 6 coefficients c0,...,c5 of the polynomial
+        c0 + c1*t + ... + c5*t^5, with t = x - _polyKnots[i], of each interval
+        i*/
+        std::vector<double> _polyCoefficients;
         
         /**Bezier X1,...,Xn control point locations. Control points are 
         stored in 6x1 vectors in the order above*/
@@ -469,6 +528,14 @@ namespace OpenSim {
        /**@return The maximum order derivative that this object is capable of 
        returning*/
        int getMaxDerivativeOrder() const override;
+
+       /**The index of the polynomial interval that contains x, which must be
+       within the curve domain.*/
+       int findPiecewisePolynomialInterval(double x) const;
+
+       /**The derivative of the given order (0, 1, or 2) of the piecewise
+       polynomial at x, which must be within the curve domain.*/
+       double calcPiecewisePolynomial(double x, int order) const;
                
     };
 
@@ -39,8 +39,10 @@
 #include "SimTKcommon.h"
 #include "SimmMacros.h"
 #include "StateVector.h"
+#include "StorageCursor.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace OpenSim;
@@ -1139,6 +1141,50 @@ getDataAtTime(double aT,int aN,SimTK::Vector& v) const
         v[i] = rData[i];
     return r;
 }
+void Storage::
+getDataAtTimes(const SimTK::Vector& aTimes, SimTK::Matrix& rData,
+        int parallel) const
+{
+    OPENSIM_THROW_IF(parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", parallel);
+    const int nt = aTimes.size();
+    const int ncol = _storage.getSize() ? getSmallestNumberOfStates() : 0;
+    if (rData.nrow() != nt || rData.ncol() != ncol) rData.resize(nt, ncol);
+    if (!nt || !ncol) return;
+
+    // Find the rows to interpolate between for each time.
+    StorageCursor cursor(*this);
+    std::vector<const double*> rows1(nt), rows2(nt);
+    std::vector<double> fractions(nt);
+    for (int it = 0; it < nt; ++it) {
+        int i1, i2;
+        cursor.findInterval(aTimes[it], i1, i2, fractions[it]);
+        rows1[it] = &getStateVector(i1)->getData()[0];
+        rows2[it] = &getStateVector(i2)->getData()[0];
+    }
+
+    // Starting a thread only pays off if it has enough values to compute.
+    const int minValuesPerThread = 20000;
+    const int numThreads = getNumThreadsForParallel(parallel, ncol,
+            (minValuesPerThread + nt - 1) / nt);
+
+    // SimTK::Matrix is stored by column, so each thread writes to contiguous
+    // memory.
+    runInContiguousChunks(ncol, numThreads, [&](int, int begin, int end) {
+        for (int j = begin; j < end; ++j) {
+            for (int it = 0; it < nt; ++it) {
+                // As in getDataAtTime(), a time on a row does not use the
+                // next row, which may contain NaN.
+                const double y1 = rows1[it][j];
+                if (fractions[it] == 0.0) {
+                    rData(it, j) = y1;
+                } else {
+                    rData(it, j) = y1 + fractions[it] * (rows2[it][j] - y1);
+                }
+            }
+        }
+    });
+}
 //_____________________________________________________________________________
 /**
  * Get the data corresponding to a specified state.  This call is equivalent
@@ -1346,6 +1392,7 @@ TimeSeriesTable Storage::exportToTable() const {
                 _columnLabels.get() + _columnLabels.getSize());
     }
 
+    table.reserve(_storage.getSize());
     for(int i = 0; i < _storage.getSize(); ++i) {
         const auto& row = getStateVector(i)->getData();
         const auto time = getStateVector(i)->getTime();
@@ -2611,21 +2658,18 @@ resampleLinear(double aDT)
 
     Storage *newStorage = new Storage(nr);
 
-    // LOOP THROUGH THE DATA
-    int ny=0;
-    double *y=NULL;
-    StateVector vec;
+    // INTERPOLATE THE STATES AT ALL TIMES
+    SimTK::Vector times(nr);
+    for(int i=0; i<nr; i++) times[i] = ti+aDT*(double)i;
+    SimTK::Matrix data;
+    getDataAtTimes(times, data);
     for(int i=0; i<nr; i++) {
-        double t = ti+aDT*(double)i;
-        // INTERPOLATE THE STATES
-        ny = getDataAtTime(t,ny,&y);
-        newStorage->append(t,ny,y);
+        newStorage->append(times[i], SimTK::Vector(~data[i]));
     }
 
     copyData(*newStorage);
 
     delete newStorage;
-    delete[] y;
 
     return aDT;
 }
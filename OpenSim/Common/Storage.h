@@ -198,6 +198,16 @@ public:
     int getDataAtTime(double aTime,int aN,double *rData) const;
     int getDataAtTime(double aTime,int aN,Array<double> &rData) const override;
     int getDataAtTime(double aTime,int aN,SimTK::Vector& v) const;
+    /** Linearly interpolate the first getSmallestNumberOfStates() columns at
+    each of the given times, as getDataAtTime() does. Row i of rData
+    (resized if necessary) is set to the data at aTimes[i]. The interval
+    containing each time is found once for all columns (and in constant
+    time if aTimes increases), and then the columns are interpolated
+    concurrently: set parallel to 0 to interpolate serially, 1 to use all
+    cores, or N > 1 to use N threads. Fewer threads are used for small
+    amounts of data. */
+    void getDataAtTimes(const SimTK::Vector& aTimes, SimTK::Matrix& rData,
+            int parallel = 1) const;
     int getDataColumn(int aStateIndex,double *&rData) const;
     int getDataColumn(int aStateIndex,Array<double> &rData) const;
     // Set entries in a column of the storage to a fixed value, 
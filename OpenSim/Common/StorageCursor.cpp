@@ -0,0 +1,100 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  StorageCursor.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StorageCursor.h"
+
+#include "Storage.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+bool StorageCursor::findInterval(double time, int& index1, int& index2,
+        double& fraction) const {
+    if (!_storage) return false;
+    const Storage& storage = *_storage;
+    const int size = storage.getSize();
+    if (size <= 0) return false;
+    auto getTime = [&storage](int i) {
+        return storage.getStateVector(i)->getTime();
+    };
+
+    // Find the last row whose time is not after the given time (or the first
+    // row, if there is none), as Storage::findIndex() does.
+    int i = _index.load(std::memory_order_relaxed);
+    if (i < 0 || i >= size || getTime(i) > time) i = 0;
+    // Step forward a few rows before falling back to a binary search.
+    int numSteps = 0;
+    while (i + 1 < size && getTime(i + 1) <= time && numSteps < 4) {
+        ++i;
+        ++numSteps;
+    }
+    if (i + 1 < size && getTime(i + 1) <= time) {
+        int lo = i + 1;
+        int hi = size;
+        // Invariant: getTime(lo) <= time, and hi == size or
+        // getTime(hi) > time.
+        while (hi - lo > 1) {
+            const int mid = lo + (hi - lo) / 2;
+            if (getTime(mid) <= time) lo = mid;
+            else hi = mid;
+        }
+        i = lo;
+    }
+    _index.store(i, std::memory_order_relaxed);
+
+    // Interpolate between this row and the next, or extrapolate from the
+    // last two rows.
+    index1 = i;
+    index2 = i + 1;
+    if (index2 == size) {
+        index1 = std::max(index1 - 1, 0);
+        index2 = std::max(index2 - 1, 0);
+    }
+    const double t1 = getTime(index1);
+    const double den = getTime(index2) - t1;
+    fraction = den < SimTK::Eps ? 0.0 : (time - t1) / den;
+    return true;
+}
+
+int StorageCursor::getDataAtTime(double time, int n, double* data) const {
+    int index1, index2;
+    double fraction;
+    if (!data || !findInterval(time, index1, index2, fraction)) return 0;
+
+    const Array<double>& y1 = _storage->getStateVector(index1)->getData();
+    const Array<double>& y2 = _storage->getStateVector(index2)->getData();
+    const int ns = std::min(n, std::min(y1.getSize(), y2.getSize()));
+    if (fraction == 0.0) {
+        for (int i = 0; i < ns; ++i) data[i] = y1[i];
+    } else {
+        for (int i = 0; i < ns; ++i) {
+            data[i] = y1[i] + fraction * (y2[i] - y1[i]);
+        }
+    }
+    return ns;
+}
+
+int StorageCursor::getDataAtTime(double time, SimTK::Vector& data) const {
+    if (data.size() == 0) return 0;
+    return getDataAtTime(time, data.size(), &data[0]);
+}
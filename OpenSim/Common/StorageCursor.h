@@ -0,0 +1,97 @@
+#ifndef OPENSIM_STORAGE_CURSOR_H_
+#define OPENSIM_STORAGE_CURSOR_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  StorageCursor.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <SimTKcommon.h>
+#include <atomic>
+
+namespace OpenSim {
+
+class Storage;
+
+/** Linearly interpolates the rows of a Storage, like
+Storage::getDataAtTime(), but keeps its own position in the Storage instead
+of the Storage's, and writes into buffers provided by the caller without
+allocating memory.
+
+The search for the rows that bracket a time starts at the rows used by the
+previous call, so that it takes constant time when the time increases (or
+stays the same) from one call to the next, as it does when a controller or
+analysis queries the Storage during a simulation; other times use a binary
+search. A cursor can be used from multiple threads concurrently (the
+position is only a hint), and any number of cursors can share a Storage, as
+long as the Storage is not modified while they are in use.
+
+@code
+StorageCursor cursor(desiredStates);
+SimTK::Vector y(desiredStates.getSmallestNumberOfStates());
+cursor.getDataAtTime(state.getTime(), y);
+@endcode */
+class OSIMCOMMON_API StorageCursor {
+public:
+    StorageCursor() = default;
+    /** The Storage must outlive the cursor (or the cursor must be given
+    another Storage with setStorage()). */
+    explicit StorageCursor(const Storage& storage) : _storage(&storage) {}
+    StorageCursor(const StorageCursor& other)
+            : _storage(other._storage), _index(other._index.load()) {}
+    StorageCursor& operator=(const StorageCursor& other) {
+        _storage = other._storage;
+        _index = other._index.load();
+        return *this;
+    }
+
+    /** Use another Storage, and start searching from its first row. */
+    void setStorage(const Storage* storage) {
+        _storage = storage;
+        _index = 0;
+    }
+    const Storage* getStorage() const { return _storage; }
+
+    /** Find the rows to interpolate between to get the data at the given
+    time, and the fraction of the way from the first row to the second,
+    using the same rules as Storage::getDataAtTime() (including linear
+    extrapolation before the first and after the last time). Returns false
+    if the Storage is empty. */
+    bool findInterval(double time, int& index1, int& index2,
+            double& fraction) const;
+
+    /** Set the first n (at most) values of data to the data at the given
+    time, interpolated linearly. Returns the number of values set, which is
+    also limited by the sizes of the two rows that are interpolated. This
+    is equivalent to Storage::getDataAtTime(time, n, data). */
+    int getDataAtTime(double time, int n, double* data) const;
+    /** Same as above, with n = data.size(). */
+    int getDataAtTime(double time, SimTK::Vector& data) const;
+
+private:
+    const Storage* _storage = nullptr;
+    // The first row used by the previous call.
+    mutable std::atomic<int> _index{0};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STORAGE_CURSOR_H_
@@ -250,12 +250,12 @@ TimeSeriesTable TableUtilities::resample(
             createFunctionSet<FunctionType>(in);
     SimTK::Vector curTime(1);
     SimTK::RowVector row(functions->getSize());
+    out.reserve(newTime.size());
     for (int itime = 0; itime < (int)newTime.size(); ++itime) {
         curTime[0] = newTime[itime];
         for (int icol = 0; icol < functions->getSize(); ++icol) {
             row(icol) = functions->get(icol).calcValue(curTime);
         }
-        // Not efficient!
         out.appendRow(curTime[0], row);
     }
     return out;
@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  testBinaryFileAdapter.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/Adapters.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace OpenSim;
+
+namespace {
+    template <typename ETY>
+    void checkEqual(const SimTK::MatrixView_<ETY>& a,
+            const SimTK::MatrixView_<ETY>& b) {
+        REQUIRE(a.nrow() == b.nrow());
+        REQUIRE(a.ncol() == b.ncol());
+        for (int i = 0; i < a.nrow(); ++i)
+            for (int j = 0; j < a.ncol(); ++j)
+                CHECK(a(i, j) == b(i, j));
+    }
+}
+
+TEST_CASE("BinaryFileAdapter round trip of a table of doubles") {
+    SimTK::Matrix data(3, 4);
+    for (int i = 0; i < data.nrow(); ++i)
+        for (int j = 0; j < data.ncol(); ++j) data(i, j) = 1.0 / (1 + i + j);
+    TimeSeriesTable table(std::vector<double>{0, 0.1, 0.2}, data,
+            std::vector<std::string>{"a", "b", "c", "d"});
+    table.addTableMetaData<std::string>("inDegrees", "yes");
+    table.addTableMetaData<double>("DataRate", 100.0);
+    table.addTableMetaData<int>("NumFrames", 3);
+    table.addTableMetaData<bool>("filtered", true);
+
+    BinaryFileAdapter::write(table, "testBinaryFileAdapter.stb");
+    // Read through the extension-based lookup used by the rest of OpenSim.
+    TimeSeriesTable copy("testBinaryFileAdapter.stb");
+
+    CHECK(copy.getColumnLabels() == table.getColumnLabels());
+    CHECK(copy.getIndependentColumn() == table.getIndependentColumn());
+    checkEqual(copy.getMatrix(), table.getMatrix());
+    CHECK(copy.getTableMetaData<std::string>("inDegrees") == "yes");
+    CHECK(copy.getTableMetaData<double>("DataRate") == 100.0);
+    CHECK(copy.getTableMetaData<int>("NumFrames") == 3);
+    CHECK(copy.getTableMetaData<bool>("filtered"));
+    CHECK(copy.getIndependentMetaData().getValueAsString("labels") ==
+            table.getIndependentMetaData().getValueAsString("labels"));
+
+    SECTION("Selected columns") {
+        auto subset = BinaryFileAdapter::readFile<double>(
+                "testBinaryFileAdapter.stb", {"d", "b"});
+        CHECK(subset.getColumnLabels() ==
+                std::vector<std::string>{"d", "b"});
+        for (int i = 0; i < 3; ++i) {
+            CHECK(subset.getMatrix()(i, 0) == data(i, 3));
+            CHECK(subset.getMatrix()(i, 1) == data(i, 1));
+        }
+        CHECK_THROWS_AS(BinaryFileAdapter::readFile<double>(
+                "testBinaryFileAdapter.stb", {"e"}), KeyNotFound);
+    }
+
+    SECTION("Wrong data type") {
+        CHECK(BinaryFileAdapter::readDataTypeName(
+                "testBinaryFileAdapter.stb") == "double");
+        CHECK_THROWS_AS(BinaryFileAdapter::readFile<SimTK::Vec3>(
+                "testBinaryFileAdapter.stb"), IncorrectTableType);
+    }
+
+    SECTION("Truncated file") {
+        {
+            std::ifstream in("testBinaryFileAdapter.stb", std::ios::binary);
+            std::string contents((std::istreambuf_iterator<char>(in)),
+                    std::istreambuf_iterator<char>());
+            std::ofstream out("testBinaryFileAdapter_truncated.stb",
+                    std::ios::binary);
+            out.write(contents.data(), contents.size() - 8);
+        }
+        CHECK_THROWS_AS(TimeSeriesTable("testBinaryFileAdapter_truncated.stb"),
+                IOError);
+    }
+}
+
+TEST_CASE("BinaryFileAdapter round trip of Vec3 and Quaternion tables") {
+    TimeSeriesTableVec3 markers(std::vector<double>{0, 0.5},
+            SimTK::Matrix_<SimTK::Vec3>(2, 2, SimTK::Vec3(1, 2, 3)),
+            std::vector<std::string>{"m1", "m2"});
+    markers.updMatrix()(1, 1) = SimTK::Vec3(4, 5, 6);
+    markers.addTableMetaData<std::string>("Units", "mm");
+    FileAdapter::writeFile({{"table", &markers}}, "testBinaryFileAdapter.stb");
+    TimeSeriesTableVec3 markersCopy("testBinaryFileAdapter.stb");
+    checkEqual(markersCopy.getMatrix(), markers.getMatrix());
+    CHECK(markersCopy.getTableMetaData<std::string>("Units") == "mm");
+
+    TimeSeriesTableQuaternion orientations(std::vector<double>{0},
+            SimTK::Matrix_<SimTK::Quaternion>(1, 1,
+                    SimTK::Quaternion(0.5, 0.5, 0.5, 0.5)),
+            std::vector<std::string>{"pelvis_imu"});
+    BinaryFileAdapter::write(orientations, "testBinaryFileAdapter.stb");
+    auto orientationsCopy = BinaryFileAdapter::readFile<SimTK::Quaternion>(
+            "testBinaryFileAdapter.stb");
+    checkEqual(orientationsCopy.getMatrix(), orientations.getMatrix());
+}
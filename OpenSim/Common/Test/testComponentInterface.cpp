@@ -1205,6 +1205,82 @@ void testTraversePathToComponent() {
     SimTK_TEST(&top.getComponent<Component>("tx/tx") == btx);
 }
 
+void testSubcomponentIndex() {
+    class A : public Component {
+        OpenSim_DECLARE_CONCRETE_OBJECT(A, Component);
+    public:
+        A(const std::string& name) { setName(name); }
+    };
+
+    // findComponent() and getComponent() use an index of the subcomponents,
+    // which must be rebuilt when the tree changes.
+    A top("top");
+    A* a1 = new A("a1");
+    top.addComponent(a1);
+    A* a2 = new A("a2");
+    a1->addComponent(a2);
+    SimTK_TEST(top.findComponent("a2") == a2);
+    SimTK_TEST(&top.getComponent("/a1/a2") == a2);
+    SimTK_TEST(top.findComponent("a3") == nullptr);
+    SimTK_TEST(!top.hasComponent("a1/a3"));
+
+    // Add a component below the root.
+    A* a3 = new A("a3");
+    a2->addComponent(a3);
+    SimTK_TEST(top.findComponent("a3") == a3);
+    SimTK_TEST(&top.getComponent("/a1/a2/a3") == a3);
+    SimTK_TEST(&top.getComponent("a1/a2/a3") == a3);
+
+    // A name that is now ambiguous.
+    A* otherA3 = new A("a3");
+    a1->addComponent(otherA3);
+    SimTK_TEST_MUST_THROW_EXC(top.findComponent("a3"), OpenSim::Exception);
+    SimTK_TEST(&top.getComponent("a1/a3") == otherA3);
+
+    // Rename a component; renaming does not require finalizing the tree.
+    otherA3->setName("a4");
+    SimTK_TEST(top.findComponent("a4") == otherA3);
+    SimTK_TEST(&top.getComponent("/a1/a4") == otherA3);
+    SimTK_TEST(!top.hasComponent("/a1/a3"));
+    SimTK_TEST(top.findComponent("a3") == a3);
+    a2->setName("b2");
+    SimTK_TEST(&top.getComponent("/a1/b2/a3") == a3);
+    SimTK_TEST(!top.hasComponent("/a1/a2/a3"));
+    SimTK_TEST(top.findComponent("a2") == nullptr);
+    a2->setName("a2");
+
+    // Renaming a component to a name that is already indexed makes that name
+    // ambiguous, as for a tree that is not indexed.
+    SimTK_TEST(top.findComponent("a2") == a2);
+    otherA3->setName("a2");
+    SimTK_TEST_MUST_THROW_EXC(top.findComponent("a2"), OpenSim::Exception);
+    otherA3->setName("a4");
+    SimTK_TEST(top.findComponent("a2") == a2);
+    SimTK_TEST(top.findComponent("a4") == otherA3);
+    // A direct child is preferred over deeper components with its name.
+    a3->setName("a1");
+    SimTK_TEST(top.findComponent("a1") == a1);
+    SimTK_TEST(a2->findComponent("a1") == a3);
+    a3->setName("a3");
+
+    // Changing an unrelated tree does not affect this one.
+    {
+        A other("other");
+        other.addComponent(new A("b1"));
+    }
+    SimTK_TEST(&top.getComponent("/a1/a2/a3") == a3);
+
+    // A copy of the tree finds its own components.
+    A copy = top;
+    copy.finalizeFromProperties();
+    const Component* copyA2 = copy.findComponent("a2");
+    SimTK_TEST(copyA2 != nullptr);
+    SimTK_TEST(copyA2 != a2);
+    SimTK_TEST(&copy.getComponent("/a1/a2") == copyA2);
+    SimTK_TEST(&copyA2->getRoot() == &copy);
+    SimTK_TEST(top.findComponent("a2") == a2);
+}
+
 void testGetStateVariableValue() {
 
     TheWorld top;
@@ -1238,6 +1314,50 @@ void testGetStateVariableValue() {
     SimTK_TEST_MUST_THROW_EXC(
             top.getStateVariableValue(s, "typo/b/subState"),
             OpenSim::Exception);
+
+    // Handles and lists of state variables.
+    const auto handle = b->getStateVariableHandle("../subState");
+    SimTK_TEST(handle.isValid());
+    SimTK_TEST(handle.getValue(s) == 20);
+    handle.setValue(s, 25);
+    SimTK_TEST(a->getStateVariableValue(s, "subState") == 25);
+    SimTK_TEST(!Component::StateVariableHandle().isValid());
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+
+    const auto list = top.getStateVariableList(
+            {"a/b/subState", "internalSub/subState", "/a/subState"});
+    SimTK_TEST(list.getSize() == 3);
+    SimTK::Vector values;
+    list.getValues(s, values);
+    SimTK_TEST(values.size() == 3);
+    SimTK_TEST(values[0] == 30);
+    SimTK_TEST(values[1] == 10);
+    SimTK_TEST(values[2] == 25);
+    list.setValues(s, SimTK::Vector(3, 1.5));
+    SimTK_TEST(top.getStateVariableValue(s, "a/b/subState") == 1.5);
+    SimTK_TEST(top.getStateVariableValue(s, "internalSub/subState") == 1.5);
+    SimTK_TEST(top.getStateVariableValue(s, "a/subState") == 1.5);
+    SimTK_TEST_MUST_THROW_EXC(list.setValues(s, SimTK::Vector(2, 0.0)),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            top.getStateVariableList({"a/subState", "typo/b/subState"}),
+            OpenSim::Exception);
+
+    // The handles cannot be used once the System is recreated.
+    top.finalizeFromProperties();
+    SimTK_TEST_MUST_THROW_EXC(handle.getValue(s), ComponentHasNoSystem);
+    MultibodySystem newSystem;
+    top.buildUpSystem(newSystem);
+    State newState = newSystem.realizeTopology();
+    SimTK_TEST_MUST_THROW_EXC(handle.getValue(newState), ComponentHasNoSystem);
+    SimTK_TEST_MUST_THROW_EXC(handle.setValue(newState, 1.0),
+            ComponentHasNoSystem);
+    SimTK_TEST_MUST_THROW_EXC(list.getValues(newState), ComponentHasNoSystem);
+    SimTK_TEST_MUST_THROW_EXC(list.setValues(newState, SimTK::Vector(3, 0.0)),
+            ComponentHasNoSystem);
+    newState.updY()[2] = 35; // "top/a/b/subState"
+    SimTK_TEST(b->getStateVariableHandle("subState").getValue(newState) == 35);
 }
 
 void testGetStateVariableValueComponentPath() {
@@ -2427,6 +2547,12 @@ void testCacheVariableInterface() {
         ASSERT(c.getCacheVariableValue<double>(s, k) == v);
         ASSERT(c.getCacheVariableValue(s, c.cv) == v);
 
+        // a handle obtained by name refers to the same cache variable
+        CacheVariable<double> byName = c.getCacheVariable<double>(k);
+        ASSERT(c.getCacheVariableValue(s, byName) == v);
+        ASSERT_THROW(OpenSim::Exception,
+                c.getCacheVariable<double>("nonexistent"));
+
         // Setting the value via key causes subsequent `get` methods
         // (both string key + CacheVariable ones) to return the new value.
         {
@@ -2554,6 +2680,7 @@ int main() {
         SimTK_SUBTEST(testComponentPathNames);
         SimTK_SUBTEST(testFindComponent);
         SimTK_SUBTEST(testTraversePathToComponent);
+        SimTK_SUBTEST(testSubcomponentIndex);
         SimTK_SUBTEST(testGetStateVariableValue);
         SimTK_SUBTEST(testGetStateVariableValueComponentPath);
         SimTK_SUBTEST(testInputOutputConnections);
@@ -0,0 +1,149 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  testDataQueue.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2022 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Common/DataQueue.h>
+
+using namespace OpenSim;
+
+namespace {
+    SimTK::RowVector makeRow(double value) {
+        return SimTK::RowVector(3, value);
+    }
+}
+
+TEST_CASE("DataQueue basic operations") {
+    DataQueue_<double> queue(4);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getCapacity() == 4);
+
+    double time;
+    SimTK::RowVector row;
+    CHECK(!queue.try_pop_front(time, row));
+    CHECK(!queue.pop_front(time, row, 0.01));
+
+    for (int i = 0; i < 3; ++i) CHECK(queue.push_back(i, makeRow(i)));
+    CHECK(queue.getSize() == 3);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(queue.try_pop_front(time, row));
+        CHECK(time == i);
+        CHECK(row.size() == 3);
+        CHECK(row[2] == i);
+    }
+    CHECK(queue.isEmpty());
+
+    // Out-of-order timestamps are queued but counted as late.
+    queue.push_back(5.0, makeRow(5));
+    queue.push_back(4.0, makeRow(4));
+    CHECK(queue.getNumLateFrames() == 1);
+    CHECK(queue.getSize() == 2);
+}
+
+TEST_CASE("DataQueue overflow policies") {
+    double time;
+    SimTK::RowVector row;
+
+    SECTION("DropOldest") {
+        DataQueue_<double> queue(3, DataQueueOverflowPolicy::DropOldest, 3);
+        for (int i = 0; i < 5; ++i) CHECK(queue.push_back(i, makeRow(i)));
+        CHECK(queue.getSize() == 3);
+        CHECK(queue.getNumDroppedFrames() == 2);
+        for (int i = 2; i < 5; ++i) {
+            CHECK(queue.try_pop_front(time, row));
+            CHECK(time == i);
+        }
+        CHECK(queue.isEmpty());
+    }
+
+    SECTION("Backpressure") {
+        DataQueue_<double> queue(3, DataQueueOverflowPolicy::Backpressure);
+        for (int i = 0; i < 3; ++i) CHECK(queue.try_push_back(i, makeRow(i)));
+        CHECK(!queue.try_push_back(3, makeRow(3)));
+        CHECK(queue.getNumDroppedFrames() == 0);
+        CHECK(queue.try_pop_front(time, row));
+        CHECK(time == 0);
+        CHECK(queue.try_push_back(3, makeRow(3)));
+        CHECK(queue.getSize() == 3);
+    }
+}
+
+TEST_CASE("DataQueue producer and consumer threads") {
+    const int numFrames = 10000;
+    DataQueue_<double> queue(16, DataQueueOverflowPolicy::Backpressure, 3);
+    std::thread producer([&queue]() {
+        for (int i = 0; i < numFrames; ++i) queue.push_back(i, makeRow(i));
+    });
+    double time;
+    SimTK::RowVector row;
+    int numPopped = 0;
+    while (numPopped < numFrames && queue.pop_front(time, row, 10.0)) {
+        CHECK(time == numPopped);
+        CHECK(row[0] == numPopped);
+        ++numPopped;
+    }
+    producer.join();
+    CHECK(numPopped == numFrames);
+    CHECK(queue.getNumDroppedFrames() == 0);
+}
+
+TEST_CASE("DataQueue is unbounded by default") {
+    // Fill the queue on one thread and drain it later.
+    const int numFrames = 5000;
+    DataQueue_<double> queue;
+    CHECK(queue.getCapacity() == 0);
+    for (int i = 0; i < numFrames; ++i) CHECK(queue.push_back(i, makeRow(i)));
+    CHECK(queue.getSize() == numFrames);
+    CHECK(queue.getNumDroppedFrames() == 0);
+
+    // A copy holds the same entries.
+    DataQueue_<double> copy(queue);
+    CHECK(copy.getSize() == numFrames);
+
+    double time;
+    SimTK::RowVector row;
+    for (int i = 0; i < numFrames; ++i) {
+        CHECK(queue.try_pop_front(time, row));
+        CHECK(time == i);
+        CHECK(row[1] == i);
+        CHECK(copy.try_pop_front(time, row));
+        CHECK(time == i);
+    }
+    CHECK(queue.isEmpty());
+    CHECK(!queue.try_pop_front(time, row));
+    CHECK(queue.push_back(numFrames, makeRow(numFrames)));
+    CHECK(queue.try_pop_front(time, row));
+    CHECK(time == numFrames);
+
+    // The consumer follows the producer into new ring buffers.
+    DataQueue_<double> shared;
+    std::thread producer([&shared]() {
+        for (int i = 0; i < numFrames; ++i) shared.push_back(i, makeRow(i));
+    });
+    int numPopped = 0;
+    while (numPopped < numFrames && shared.pop_front(time, row, 10.0)) {
+        CHECK(time == numPopped);
+        ++numPopped;
+    }
+    producer.join();
+    CHECK(numPopped == numFrames);
+}
@@ -785,6 +785,48 @@ TEST_CASE("DataTable") {
     }
 }
 
+TEST_CASE("DataTable appendRow reserves capacity") {
+    TimeSeriesTable_<Vec3> table{};
+    table.setColumnLabels({"0", "1"});
+    CHECK(table.getRowCapacity() == 0);
+
+    const int numRows = 1000;
+    for (int i = 0; i < numRows; ++i) {
+        table.appendRow(0.01 * i, {Vec3(i), Vec3(-i)});
+    }
+    CHECK(table.getNumRows() == numRows);
+    CHECK(table.getRowCapacity() >= table.getNumRows());
+
+    // Views of the table must not include the reserved rows.
+    CHECK(table.getMatrix().nrow() == numRows);
+    CHECK(table.getDependentColumnAtIndex(1).size() == numRows);
+    CHECK(table.getDependentColumn("0")[numRows - 1] == Vec3(numRows - 1));
+    CHECK(table.getRowAtIndex(numRows - 1)[1] == Vec3(-(numRows - 1)));
+
+    table.removeRowAtIndex(0);
+    CHECK(table.getNumRows() == numRows - 1);
+    CHECK(table.getMatrix().nrow() == numRows - 1);
+    CHECK(table.getRowAtIndex(0)[0] == Vec3(1));
+
+    table.shrinkToFit();
+    CHECK(table.getRowCapacity() == table.getNumRows());
+    CHECK(table.getIndependentColumn().back() == Approx(0.01 * (numRows - 1)));
+    CHECK(table.getRowAtIndex(numRows - 2)[0] == Vec3(numRows - 1));
+
+    TimeSeriesTable reserved{};
+    reserved.setColumnLabels({"a", "b", "c"});
+    reserved.reserve(10);
+    CHECK(reserved.getNumRows() == 0);
+    CHECK(reserved.getRowCapacity() == 10);
+    for (int i = 0; i < 10; ++i) {
+        reserved.appendRow(i, {1.0 * i, 2.0 * i, 3.0 * i});
+    }
+    CHECK(reserved.getRowCapacity() == 10);
+    reserved.appendColumn("d", std::vector<double>(10, 4.0));
+    CHECK(reserved.getDependentColumn("c")[9] == 27.0);
+    CHECK(reserved.getDependentColumn("d")[9] == 4.0);
+}
+
 TEST_CASE("TableUtilities::checkNonUniqueLabels") {
     CHECK_THROWS_AS(TableUtilities::checkNonUniqueLabels({"a", "a"}),
                     NonUniqueLabels);
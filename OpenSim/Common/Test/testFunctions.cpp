@@ -24,15 +24,24 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/GCVSpline.h>
+#include <OpenSim/Common/MultiChannelSpline.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
 
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/PolynomialFunction.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 using namespace OpenSim;
 using namespace SimTK;
 
@@ -92,6 +101,68 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("MultiChannelSpline") {
+    const int n = 20;
+    std::vector<double> time(n), y(n);
+    for (int i = 0; i < n; ++i) {
+        time[i] = 0.1 * i + 0.01 * std::sin(i);
+        y[i] = std::cos(3 * time[i]) + 0.1 * i;
+    }
+    std::vector<double> otherTime(time);
+    otherTime.back() += 0.05;
+
+    GCVSpline gcv3(3, n, time.data(), y.data());
+    GCVSpline gcv5(5, n, time.data(), y.data());
+    PiecewiseLinearFunction linear(n, time.data(), y.data());
+    SimmSpline simm(n, time.data(), y.data());
+    SimmSpline simmOtherKnots(n, otherTime.data(), y.data());
+    Constant constant(1.5);
+    Sine sine(2.0, 3.0, 0.1, 0.0);
+    const std::vector<const Function*> functions{&gcv3, &linear, nullptr,
+            &simm, &constant, &gcv5, &simmOtherKnots, &sine};
+
+    auto checkValues = [&](const MultiChannelSpline& spline) {
+        // Increasing and decreasing times, knots, and times outside the
+        // range of the knots.
+        std::vector<double> times{-0.2, time[0], 0.03};
+        for (double t = 0.05; t < 1.9; t += 0.0371) times.push_back(t);
+        for (double t : {time[7], 1.2, 0.4, time[n - 1], 2.3}) {
+            times.push_back(t);
+        }
+        for (double t : times) {
+            const SimTK::Vector values = spline.calcValues(t);
+            REQUIRE(values.size() == (int)functions.size());
+            for (int i = 0; i < (int)functions.size(); ++i) {
+                const double expected = functions[i]
+                        ? functions[i]->calcValue(SimTK::Vector(1, t))
+                        : 0.0;
+                INFO("channel " << i << ", time " << t);
+                CHECK(values[i] == Approx(expected).margin(1e-10));
+            }
+        }
+    };
+
+    MultiChannelSpline spline(functions);
+    CHECK(spline.getNumChannels() == 8);
+    // The quintic spline, the spline with different knots, and the Sine are
+    // evaluated with calcValue().
+    CHECK(spline.getNumTabulatedChannels() == 5);
+    checkValues(spline);
+
+    // Copies do not depend on the original functions.
+    MultiChannelSpline copy;
+    {
+        MultiChannelSpline temp(functions);
+        copy = temp;
+    }
+    checkValues(copy);
+
+    MultiChannelSpline constants({&constant, nullptr});
+    CHECK(constants.getNumTabulatedChannels() == 0);
+    CHECK(constants.calcValues(0.3)[0] == 1.5);
+    CHECK(constants.calcValues(0.3)[1] == 0);
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
@@ -175,3 +246,79 @@ TEST_CASE("solveBisection()") {
         REQUIRE_THROWS_AS(solveBisection(parabola, -5, 5), OpenSim::Exception);
     }
 }
+
+TEST_CASE("ThreadsafeJar creates objects lazily") {
+    std::atomic<int> numCreated{0};
+    // The number of calls to the factory that are in progress.
+    std::atomic<int> numCreating{0};
+    std::atomic<int> maxNumCreating{0};
+    ThreadsafeJar<int> jar(
+            [&]() {
+                const int creating = ++numCreating;
+                if (creating > maxNumCreating) maxNumCreating = creating;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                --numCreating;
+                return std::unique_ptr<int>(new int(numCreated++));
+            },
+            3);
+    CHECK(jar.size() == 3);
+    CHECK(numCreated.load() == 0);
+
+    // Objects are reused before new ones are created.
+    auto first = jar.take();
+    CHECK(numCreated.load() == 1);
+    CHECK(jar.size() == 2);
+    jar.leave(std::move(first));
+    first = jar.take();
+    CHECK(numCreated.load() == 1);
+
+    // Objects are created one at a time, up to the capacity.
+    std::vector<std::unique_ptr<int>> taken(2);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&jar, &taken, i] { taken[i] = jar.take(); });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(numCreated.load() == 3);
+    CHECK(maxNumCreating.load() == 1);
+    CHECK(jar.size() == 0);
+    CHECK(*taken[0] != *taken[1]);
+    for (auto& entry : taken) jar.leave(std::move(entry));
+    jar.leave(std::move(first));
+    CHECK(jar.size() == 3);
+    CHECK(numCreated.load() == 3);
+}
+
+TEST_CASE("getNumThreadsForParallel() and runInContiguousChunks()") {
+    CHECK(getNumThreadsForParallel(0) == 1);
+    CHECK(getNumThreadsForParallel(1) >= 1);
+    CHECK(getNumThreadsForParallel(4) == 4);
+    CHECK(getNumThreadsForParallel(4, 10, 5) == 2);
+    CHECK(getNumThreadsForParallel(4, 3, 5) == 1);
+    CHECK_THROWS_AS(getNumThreadsForParallel(-1), OpenSim::Exception);
+
+    // Each item is visited exactly once, in contiguous chunks.
+    for (int numThreads : {1, 3}) {
+        std::vector<int> chunkOfItem(10, -1);
+        runInContiguousChunks(10, numThreads,
+                [&](int ithread, int begin, int end) {
+                    for (int i = begin; i < end; ++i) chunkOfItem[i] = ithread;
+                });
+        for (int i = 0; i < 10; ++i) {
+            CHECK(chunkOfItem[i] >= 0);
+            if (i) CHECK(chunkOfItem[i] >= chunkOfItem[i - 1]);
+        }
+        CHECK(chunkOfItem.back() == numThreads - 1);
+    }
+
+    // The exception of the first chunk that failed is rethrown.
+    CHECK_THROWS_WITH(runInContiguousChunks(9, 3,
+                              [](int ithread, int, int) {
+                                  if (ithread > 0) {
+                                      throw OpenSim::Exception(
+                                              "chunk " +
+                                              std::to_string(ithread));
+                                  }
+                              }),
+            Catch::Contains("chunk 1"));
+}
@@ -22,6 +22,7 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include <cmath>
 #include <cstdio>
 #include <fstream>
 #include <unordered_set>
@@ -353,3 +354,65 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("Reading large STO files in parallel") {
+    // Large enough that the data section is split across threads.
+    const std::string filename = "testSTOFileAdapter_large.sto";
+    const int nrow = 20000;
+    const int ncol = 12;
+    TimeSeriesTable table;
+    {
+        std::vector<std::string> labels;
+        for (int c = 0; c < ncol; ++c)
+            labels.push_back("col" + std::to_string(c));
+        table.setColumnLabels(labels);
+        SimTK::RowVector row(ncol);
+        for (int r = 0; r < nrow; ++r) {
+            for (int c = 0; c < ncol; ++c)
+                row[c] = std::sin(0.001 * r + c) * std::pow(10.0, c - 6);
+            table.appendRow(0.0005 * r, row);
+        }
+        STOFileAdapter::write(table, filename);
+    }
+    TimeSeriesTable result(filename);
+    REQUIRE(result.getNumRows() == (size_t)nrow);
+    REQUIRE(result.getNumColumns() == (size_t)ncol);
+    const auto& expTime = table.getIndependentColumn();
+    const auto& actTime = result.getIndependentColumn();
+    const auto& exp = table.getMatrix();
+    const auto& act = result.getMatrix();
+    for (int r = 0; r < nrow; ++r) {
+        CHECK(actTime[r] == Approx(expTime[r]).epsilon(1e-12));
+        for (int c = 0; c < ncol; ++c)
+            CHECK(act(r, c) == Approx(exp(r, c)).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("Reading STO files with CRLF line endings") {
+    const std::string filename = "testSTOFileAdapter_crlf.sto";
+    {
+        std::ofstream out(filename, std::ios::binary);
+        out << "version=1\r\nnRows=2\r\nnColumns=3\r\nendheader\r\n"
+            << "time\ta\tb\r\n"
+            << "0.0\t1.5\t-2.25e-3\r\n"
+            << "0.1\t 3 \t4\r\n";
+    }
+    TimeSeriesTable table(filename);
+    REQUIRE(table.getNumRows() == 2);
+    REQUIRE(table.getNumColumns() == 2);
+    CHECK(table.getIndependentColumn()[1] == Approx(0.1));
+    CHECK(table.getMatrix()(0, 1) == Approx(-2.25e-3));
+    CHECK(table.getMatrix()(1, 0) == 3);
+}
+
+TEST_CASE("Reading STO files with mismatched row lengths") {
+    const std::string filename = "testSTOFileAdapter_mismatch.sto";
+    {
+        std::ofstream out(filename);
+        out << "version=1\nnRows=2\nnColumns=3\nendheader\n"
+            << "time\ta\tb\n"
+            << "0.0\t1\t2\n"
+            << "0.1\t3\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable(filename), RowLengthMismatch);
+}
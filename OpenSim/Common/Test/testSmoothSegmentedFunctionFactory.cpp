@@ -1132,6 +1132,48 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/**
+ The piecewise polynomial approximation of a curve must be within (a small
+ multiple of) its tolerance of the Bezier curves between the points where the
+ tolerance is checked, and calcValues() and calcValueAndDerivatives() must
+ agree with calcValue() and calcDerivative().
+*/
+void testPiecewisePolynomial(const SmoothSegmentedFunction& mcf, double tol)
+{
+    SmoothSegmentedFunction approx = mcf;
+    approx.buildPiecewisePolynomial(tol);
+    SimTK_TEST(approx.getNumPiecewisePolynomialIntervals() > 0);
+    SimTK_TEST(mcf.getNumPiecewisePolynomialIntervals() == 0);
+
+    // Sample the curve and its linear extrapolations.
+    SimTK::Vec2 domain = mcf.getCurveDomain();
+    double width = domain(1) - domain(0);
+    const int n = 1001;
+    std::vector<double> x(n), y(n), dydx(n);
+    for(int i=0; i < n; i++){
+        x[i] = domain(0) - 0.1*width + 1.2*width*i/(n-1);
+    }
+    approx.calcValues(n, x.data(), y.data(), dydx.data());
+
+    for(int i=0; i < n; i++){
+        double yi, dydxi, d2ydx2i;
+        approx.calcValueAndDerivatives(x[i], yi, dydxi, d2ydx2i);
+        SimTK_TEST_EQ_TOL(y[i], approx.calcValue(x[i]), 1e-12);
+        SimTK_TEST_EQ_TOL(dydx[i], approx.calcDerivative(x[i],1), 1e-12);
+        SimTK_TEST_EQ_TOL(yi, approx.calcValue(x[i]), 1e-12);
+        SimTK_TEST_EQ_TOL(dydxi, approx.calcDerivative(x[i],1), 1e-12);
+        SimTK_TEST_EQ_TOL(d2ydx2i, approx.calcDerivative(x[i],2), 1e-12);
+        for(int order=0; order <= 2; order++){
+            double exact = mcf.calcDerivative(x[i],order);
+            SimTK_TEST_EQ_TOL(approx.calcDerivative(x[i],order), exact,
+                              10*tol*max(1.0, abs(exact)));
+        }
+    }
+
+    approx.buildPiecewisePolynomial(0);
+    SimTK_TEST(approx.getNumPiecewisePolynomialIntervals() == 0);
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1907,6 +1949,12 @@ int main(int argc, char* argv[])
                 fiberfalCurve.printMuscleCurveToCSVFile("C:/aBadPath",0,2.0));
             //fiberfalCurve.printMuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
             cout << "    passed"<<endl;
+
+            cout <<"**************************************************"<<endl;
+            cout <<"SmoothSegmentedFunction Piecewise Polynomial Testing"<<endl;
+            testPiecewisePolynomial(tendonCurve, 1e-8);
+            testPiecewisePolynomial(fiberfalCurve, 1e-8);
+            cout << "    passed"<<endl;
         SimTK_END_TEST();
 
     }
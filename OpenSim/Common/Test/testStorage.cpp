@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/StorageCursor.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 
@@ -170,6 +171,83 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageCursorAndGetDataAtTimes() {
+    Storage sto;
+    Array<std::string> labels;
+    labels.append("time");
+    // Enough data for getDataAtTimes() to use multiple threads.
+    const int ncol = 120;
+    for (int j = 0; j < ncol; ++j) labels.append("c" + std::to_string(j));
+    sto.setColumnLabels(labels);
+    for (int i = 0; i < 600; ++i) {
+        SimTK::Vector row(ncol);
+        for (int j = 0; j < ncol; ++j) row[j] = std::sin(0.1 * i + j);
+        // Nonuniform times.
+        sto.append(0.01 * i + 0.001 * (i % 3), row);
+    }
+
+    // Increasing, repeated, decreasing, and out-of-range times.
+    std::vector<double> times{-0.5, 0.0, 0.0234, 0.0234, 0.1, 3.3, 0.5,
+            5.99, 6.2, 6.0, 1.7};
+    for (double t = 0; t < 6.0; t += 0.0123) times.push_back(t);
+
+    StorageCursor cursor(sto);
+    SimTK::Vector fromCursor(ncol);
+    Array<double> expected(0.0, ncol);
+    SimTK::Vector timesVec((int)times.size());
+    for (int it = 0; it < (int)times.size(); ++it) {
+        timesVec[it] = times[it];
+        ASSERT(sto.getDataAtTime(times[it], ncol, expected) == ncol);
+        ASSERT(cursor.getDataAtTime(times[it], fromCursor) == ncol);
+        for (int j = 0; j < ncol; ++j) {
+            ASSERT_EQUAL(expected[j], fromCursor[j], 1e-14, __FILE__,
+                    __LINE__, "StorageCursor does not match getDataAtTime().");
+        }
+    }
+
+    SimTK::Matrix serial, parallel;
+    sto.getDataAtTimes(timesVec, serial, 0);
+    sto.getDataAtTimes(timesVec, parallel, 3);
+    ASSERT(serial.nrow() == (int)times.size() && serial.ncol() == ncol);
+    for (int it = 0; it < (int)times.size(); ++it) {
+        sto.getDataAtTime(times[it], ncol, expected);
+        for (int j = 0; j < ncol; ++j) {
+            ASSERT_EQUAL(expected[j], serial(it, j), 1e-14, __FILE__,
+                    __LINE__, "getDataAtTimes() does not match "
+                    "getDataAtTime().");
+            ASSERT(parallel(it, j) == serial(it, j));
+        }
+    }
+
+    // A NaN in a row is not used for times on the row before it.
+    Storage gaps;
+    Array<std::string> gapLabels;
+    gapLabels.append("time");
+    gapLabels.append("x");
+    gapLabels.append("y");
+    gaps.setColumnLabels(gapLabels);
+    const double gapRows[3][2] = {{1.0, 2.0}, {SimTK::NaN, 3.0}, {5.0, 4.0}};
+    for (int i = 0; i < 3; ++i) gaps.append(i, 2, gapRows[i]);
+    SimTK::Vector gapTimes(3);
+    gapTimes[0] = 0.0;
+    gapTimes[1] = 1.0;
+    gapTimes[2] = 0.5;
+    SimTK::Matrix gapData;
+    gaps.getDataAtTimes(gapTimes, gapData, 0);
+    ASSERT(gapData(0, 0) == 1.0 && gapData(0, 1) == 2.0);
+    ASSERT(SimTK::isNaN(gapData(1, 0)) && gapData(1, 1) == 3.0);
+    ASSERT(SimTK::isNaN(gapData(2, 0)) && gapData(2, 1) == 2.5);
+    StorageCursor gapCursor(gaps);
+    SimTK::Vector gapRow(2);
+    gapCursor.getDataAtTime(0.0, gapRow);
+    ASSERT(gapRow[0] == 1.0 && gapRow[1] == 2.0);
+
+    // An empty Storage has no data.
+    Storage empty;
+    StorageCursor emptyCursor(empty);
+    ASSERT(emptyCursor.getDataAtTime(0.1, fromCursor) == 0);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +272,8 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageCursorAndGetDataAtTimes);
     SimTK_END_TEST();
 }
 
@@ -20,6 +20,8 @@
 
 #include "CasOCProblem.h"
 
+#include <algorithm>
+
 using namespace CasOC;
 
 casadi::Sparsity calcJacobianSparsityWithPerturbation(const VectorDM& x0s,
@@ -104,6 +106,85 @@ casadi::Sparsity Function::get_jacobian_sparsity() const {
             x0s, (int)this->nnz_out(), function);
 }
 
+JacobianColoring::JacobianColoring(casadi::Sparsity sparsityIn)
+        : sparsity(std::move(sparsityIn)) {
+    const casadi_int* colind = sparsity.colind();
+    const casadi_int* row = sparsity.row();
+    // For each group, whether a column in the group has a nonzero in each row.
+    std::vector<std::vector<bool>> rowsInGroups;
+    for (int j = 0; j < (int)sparsity.size2(); ++j) {
+        if (colind[j] == colind[j + 1]) continue;
+        int group = 0;
+        for (; group < (int)rowsInGroups.size(); ++group) {
+            const auto& rowsInGroup = rowsInGroups[group];
+            if (std::none_of(row + colind[j], row + colind[j + 1],
+                        [&](casadi_int i) { return rowsInGroup[i]; })) {
+                break;
+            }
+        }
+        if (group == (int)rowsInGroups.size()) {
+            rowsInGroups.emplace_back(sparsity.size1(), false);
+            columnGroups.emplace_back();
+        }
+        for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+            rowsInGroups[group][row[k]] = true;
+        }
+        columnGroups[group].push_back(j);
+    }
+}
+
+casadi::Function Function::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    if (!m_jacobian) {
+        const casadi::Sparsity sparsity =
+                has_jacobian_sparsity()
+                        ? get_jacobian_sparsity()
+                        : casadi::Sparsity::dense(nnz_out(), nnz_in());
+        casadi::Dict jacobianOpts = opts;
+        // Second derivatives, if needed, are computed with finite differences.
+        jacobianOpts["enable_fd"] = true;
+        jacobianOpts["fd_method"] = m_finite_difference_scheme;
+        m_jacobian = OpenSim::make_unique<Jacobian>();
+        m_jacobian->constructFunction(
+                this, name, inames, onames, sparsity, jacobianOpts);
+    }
+    return *m_jacobian;
+}
+
+void Jacobian::constructFunction(const Function* function,
+        const std::string& name, const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames, casadi::Sparsity sparsity,
+        const casadi::Dict& opts) {
+    m_function = function;
+    m_inames = inames;
+    m_onames = onames;
+    m_coloring = JacobianColoring(std::move(sparsity));
+    OPENSIM_THROW_IF(m_inames.size() !=
+                             size_t(function->n_in() + function->n_out()) ||
+                             m_onames.size() != 1,
+            OpenSim::Exception, "Internal error.");
+    this->construct(name, opts);
+}
+
+casadi::Sparsity Jacobian::get_sparsity_in(casadi_int i) {
+    const casadi_int numInputs = m_function->n_in();
+    if (i < numInputs) return m_function->sparsity_in(i);
+    return m_function->sparsity_out(i - numInputs);
+}
+
+VectorDM Jacobian::eval(const VectorDM& args) const {
+    const casadi_int numInputs = m_function->n_in();
+    const VectorDM in(args.begin(), args.begin() + numInputs);
+    const casadi::DM output =
+            casadi::DM::veccat(VectorDM(args.begin() + numInputs, args.end()));
+    casadi::DM jacobian =
+            casadi::DM::zeros(m_function->nnz_out(), m_function->nnz_in());
+    m_function->calcProblemJacobian(in, m_coloring, output, jacobian);
+    return {casadi::DM::project(jacobian, m_coloring.sparsity)};
+}
+
 void Function::constructFunction(const Problem* casProblem,
         const std::string& name, const std::string& finiteDiffScheme,
         std::shared_ptr<const std::vector<VariablesDM>>
@@ -244,6 +325,21 @@ VectorDM MultibodySystemExplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+bool MultibodySystemExplicit<CalcKCErrors>::hasProblemJacobian() const {
+    return m_casProblem->hasMultibodySystemJacobian();
+}
+
+template <bool CalcKCErrors>
+void MultibodySystemExplicit<CalcKCErrors>::calcProblemJacobian(
+        const VectorDM& args, const JacobianColoring& coloring,
+        const casadi::DM& output, casadi::DM& jacobian) const {
+    Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
+            args.at(3), args.at(4), args.at(5)};
+    m_casProblem->calcMultibodySystemJacobian(input, CalcKCErrors,
+            getFiniteDifferenceScheme(), coloring, output, jacobian);
+}
+
 template class CasOC::MultibodySystemExplicit<false>;
 template class CasOC::MultibodySystemExplicit<true>;
 
@@ -330,5 +426,20 @@ VectorDM MultibodySystemImplicit<CalcKCErrors>::eval(
     return out;
 }
 
+template <bool CalcKCErrors>
+bool MultibodySystemImplicit<CalcKCErrors>::hasProblemJacobian() const {
+    return m_casProblem->hasMultibodySystemJacobian();
+}
+
+template <bool CalcKCErrors>
+void MultibodySystemImplicit<CalcKCErrors>::calcProblemJacobian(
+        const VectorDM& args, const JacobianColoring& coloring,
+        const casadi::DM& output, casadi::DM& jacobian) const {
+    Problem::ContinuousInput input{args.at(0).scalar(), args.at(1), args.at(2),
+            args.at(3), args.at(4), args.at(5)};
+    m_casProblem->calcMultibodySystemJacobian(input, CalcKCErrors,
+            getFiniteDifferenceScheme(), coloring, output, jacobian);
+}
+
 template class CasOC::MultibodySystemImplicit<false>;
 template class CasOC::MultibodySystemImplicit<true>;
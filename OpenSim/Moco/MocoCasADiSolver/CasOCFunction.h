@@ -25,9 +25,51 @@
 namespace CasOC {
 
 class Problem;
+class Function;
 
 using VectorDM = std::vector<casadi::DM>;
 
+/// The sparsity of a Jacobian and a partition of its columns into groups in
+/// which no two columns have a nonzero in the same row. Finite differences
+/// that perturb all inputs of a group at once still recover each column of
+/// the group, so they need one evaluation (two if central) per group instead
+/// of per input. Columns without nonzeros are in no group.
+struct JacobianColoring {
+    JacobianColoring() = default;
+    /// Group the columns greedily, in order.
+    explicit JacobianColoring(casadi::Sparsity sparsity);
+    casadi::Sparsity sparsity;
+    std::vector<std::vector<int>> columnGroups;
+};
+
+/// The Jacobian of all outputs of a Function with respect to all of its
+/// inputs, computed by Function::calcProblemJacobian(). CasADi creates this
+/// function through Function::get_jacobian(); its inputs are the inputs and
+/// the (nominal) outputs of the Function.
+class Jacobian : public casadi::Callback {
+public:
+    void constructFunction(const Function* function, const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames, casadi::Sparsity sparsity,
+            const casadi::Dict& opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override { return m_inames.at(i); }
+    std::string get_name_out(casadi_int i) override { return m_onames.at(i); }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override;
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        if (i == 0) return m_coloring.sparsity;
+        return casadi::Sparsity(0, 0);
+    }
+    VectorDM eval(const VectorDM& args) const override;
+
+private:
+    const Function* m_function = nullptr;
+    std::vector<std::string> m_inames;
+    std::vector<std::string> m_onames;
+    JacobianColoring m_coloring;
+};
+
 class Function : public casadi::Callback {
 public:
     virtual ~Function() = default;
@@ -36,13 +78,14 @@ public:
             std::shared_ptr<const std::vector<VariablesDM>>
                     pointsForSparsityDetection);
     void setCommonOptions(casadi::Dict& opts) {
-        // Compute the derivatives of this function using finite differences.
-        opts["enable_fd"] = true;
+        // Compute the derivatives of this function using finite differences,
+        // unless the problem computes the Jacobian.
+        if (!hasProblemJacobian()) opts["enable_fd"] = true;
         opts["fd_method"] = getFiniteDifferenceScheme();
         // Using "forward", iterations are 10x faster but problems are less
         // likely to converge.
     }
-    std::string getFiniteDifferenceScheme() {
+    std::string getFiniteDifferenceScheme() const {
         return m_finite_difference_scheme;
     }
     casadi_int get_n_in() override { return 6; }
@@ -62,6 +105,24 @@ public:
         return !m_fullPointsForSparsityDetection->empty();
     }
     casadi::Sparsity get_jacobian_sparsity() const override;
+    bool has_jacobian() const override { return hasProblemJacobian(); }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+    /// Does the CasOC::Problem compute the Jacobian of this function (with
+    /// calcProblemJacobian())? If not, CasADi computes the derivatives of this
+    /// function with finite differences.
+    virtual bool hasProblemJacobian() const { return false; }
+    /// Compute the dense Jacobian of all outputs (stacked) with respect to all
+    /// inputs (stacked), given the outputs at the inputs. Only the nonzeros
+    /// in the sparsity of `coloring` are computed.
+    virtual void calcProblemJacobian(const VectorDM& /*args*/,
+            const JacobianColoring& /*coloring*/,
+            const casadi::DM& /*output*/, casadi::DM& /*jacobian*/) const {
+        OPENSIM_THROW(OpenSim::Exception, "Internal error.");
+    }
 
 protected:
     const Problem* m_casProblem;
@@ -91,6 +152,10 @@ private:
 
     std::shared_ptr<const std::vector<VariablesDM>>
             m_fullPointsForSparsityDetection;
+
+    // CasADi does not take ownership of callbacks, so we keep the Jacobian
+    // alive for as long as this function.
+    mutable std::unique_ptr<Jacobian> m_jacobian;
 };
 
 class PathConstraint : public Function {
@@ -268,6 +333,10 @@ public:
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    bool hasProblemJacobian() const override;
+    void calcProblemJacobian(const VectorDM& args,
+            const JacobianColoring& coloring, const casadi::DM& output,
+            casadi::DM& jacobian) const override;
 };
 
 /// This function should compute a velocity correction term to make feasible
@@ -311,6 +380,10 @@ class MultibodySystemImplicit : public Function {
     }
     casadi::Sparsity get_sparsity_out(casadi_int i) override final;
     VectorDM eval(const VectorDM& args) const override;
+    bool hasProblemJacobian() const override;
+    void calcProblemJacobian(const VectorDM& args,
+            const JacobianColoring& coloring, const casadi::DM& output,
+            casadi::DM& jacobian) const override;
 };
 
 } // namespace CasOC
@@ -328,6 +328,24 @@ public:
     virtual void calcPathConstraint(int /*constraintIndex*/,
             const ContinuousInput& /*input*/,
             casadi::DM& /*path_constraint*/) const {}
+    /// If this returns true, the derivatives of the multibody system
+    /// functions are computed with calcMultibodySystemJacobian() instead of
+    /// by CasADi's finite differences.
+    virtual bool hasMultibodySystemJacobian() const { return false; }
+    /// Compute the Jacobian of the outputs of calcMultibodySystemExplicit()
+    /// (or calcMultibodySystemImplicit(), if the dynamics mode is implicit)
+    /// with respect to the inputs, using finite differences with the given
+    /// scheme ("central", "forward", or "backward"). Rows are the nonzeros of
+    /// the outputs, stacked in order, and columns are the nonzeros of the
+    /// inputs (time, states, controls, multipliers, derivatives, parameters).
+    /// `output` contains the stacked outputs at `input`, and `jacobian` is a
+    /// dense matrix of the correct size. Only the nonzeros in the sparsity of
+    /// `coloring` are needed, and the inputs in each of its column groups can
+    /// be perturbed together.
+    virtual void calcMultibodySystemJacobian(const ContinuousInput& /*input*/,
+            bool /*calcKCErrors*/, const std::string& /*finiteDiffScheme*/,
+            const JacobianColoring& /*coloring*/,
+            const casadi::DM& /*output*/, casadi::DM& /*jacobian*/) const {}
 
     virtual std::vector<std::string>
     createKinematicConstraintEquationNamesImpl() const;
@@ -68,6 +68,15 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_numThreads = numThreads;
 }
 
+void Solver::setGridEvaluationBackend(std::string backend) {
+    OPENSIM_THROW_IF(backend != "casadi" && backend != "threadpool",
+            OpenSim::Exception,
+            "Expected grid evaluation backend to be 'casadi' or "
+            "'threadpool', but got '{}'.",
+            backend);
+    m_gridEvaluationBackend = std::move(backend);
+}
+
 Solution Solver::solve(const Iterate& guess) const {
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
@@ -153,6 +153,20 @@ public:
     std::pair<std::string, int> getParallelism() const {
         return std::make_pair(m_parallelism, m_numThreads);
     }
+    /// How to evaluate functions across grid points: "casadi" (default) uses
+    /// casadi::Function::map() with the parallelism from setParallelism().
+    /// "threadpool" uses CasOC::TrajectoryFunction, which evaluates the grid
+    /// points directly if the parallelism is "serial", and otherwise on a
+    /// persistent pool of numThreads threads. "threadpool" also records the
+    /// time spent evaluating each function in the "trajectory_evaluation"
+    /// entry of Solution::stats. With "threadpool", second derivatives are
+    /// computed by finite differences of the Jacobian of the whole
+    /// trajectory, so it is best used with a limited-memory Hessian
+    /// approximation.
+    void setGridEvaluationBackend(std::string backend);
+    const std::string& getGridEvaluationBackend() const {
+        return m_gridEvaluationBackend;
+    }
 
     void setPluginOptions(casadi::Dict opts) {
         m_pluginOptions = std::move(opts);
@@ -193,6 +207,7 @@ private:
     int m_sparsity_detection_random_count = 3;
     std::string m_parallelism = "serial";
     int m_numThreads = 1;
+    std::string m_gridEvaluationBackend = "casadi";
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
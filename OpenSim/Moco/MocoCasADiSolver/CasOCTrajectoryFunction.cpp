@@ -0,0 +1,317 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCTrajectoryFunction.cpp                                       *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CasOCTrajectoryFunction.h"
+
+#include <OpenSim/Common/Exception.h>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace CasOC;
+
+namespace {
+// Each thread gets this many chunks on average, so that threads that finish
+// early can take over some of the work of slower threads.
+const int chunksPerThread = 4;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+}
+} // anonymous namespace
+
+ThreadPool::ThreadPool(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 1, OpenSim::Exception,
+            "Expected numThreads >= 1 but got {}.", numThreads);
+    for (int i = 1; i < numThreads; ++i) {
+        m_threads.emplace_back(&ThreadPool::runThread, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCondition.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+void ThreadPool::parallelFor(
+        int numItems, const std::function<void(int, int)>& func) {
+    if (numItems <= 0) return;
+    if (m_threads.empty() || numItems == 1) {
+        func(0, numItems);
+        return;
+    }
+    const int numChunks =
+            std::min(numItems, chunksPerThread * getNumThreads());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = &func;
+        m_numItems = numItems;
+        m_chunkSize = (numItems + numChunks - 1) / numChunks;
+        m_numChunks = (numItems + m_chunkSize - 1) / m_chunkSize;
+        m_nextChunk = 0;
+        m_exception = nullptr;
+        m_numBusyThreads = (int)m_threads.size();
+        ++m_generation;
+    }
+    m_startCondition.notify_all();
+    workOnChunks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishCondition.wait(lock, [this] { return m_numBusyThreads == 0; });
+    m_func = nullptr;
+    if (m_exception) std::rethrow_exception(m_exception);
+}
+
+void ThreadPool::workOnChunks() {
+    int chunk;
+    while ((chunk = m_nextChunk++) < m_numChunks) {
+        const int begin = chunk * m_chunkSize;
+        const int end = std::min(begin + m_chunkSize, m_numItems);
+        try {
+            (*m_func)(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) m_exception = std::current_exception();
+            // Skip the remaining chunks.
+            m_nextChunk = m_numChunks;
+        }
+    }
+}
+
+void ThreadPool::runThread() {
+    long long generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [&] {
+                return m_stop || m_generation != generation;
+            });
+            if (m_stop) return;
+            generation = m_generation;
+        }
+        workOnChunks();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_numBusyThreads;
+        }
+        m_finishCondition.notify_one();
+    }
+}
+
+TrajectoryFunction::TrajectoryFunction(const std::string& name,
+        const casadi::Function& pointFunction, int numPoints,
+        std::shared_ptr<ThreadPool> threadPool,
+        std::shared_ptr<EvaluationTimes> times)
+        : m_pointFunction(pointFunction), m_numPoints(numPoints),
+          m_threadPool(std::move(threadPool)), m_times(std::move(times)) {
+    // The inputs and outputs at point k are read and written at offset
+    // k * nnz, which assumes that they are dense column vectors.
+    for (casadi_int i = 0; i < pointFunction.n_in(); ++i) {
+        OPENSIM_THROW_IF(pointFunction.size2_in(i) > 1 ||
+                                 !pointFunction.sparsity_in(i).is_dense(),
+                OpenSim::Exception,
+                "Internal error: input {} of {} is not a dense column "
+                "vector.", i, pointFunction.name());
+    }
+    for (casadi_int i = 0; i < pointFunction.n_out(); ++i) {
+        OPENSIM_THROW_IF(pointFunction.size2_out(i) > 1 ||
+                                 !pointFunction.sparsity_out(i).is_dense(),
+                OpenSim::Exception,
+                "Internal error: output {} of {} is not a dense column "
+                "vector.", i, pointFunction.name());
+    }
+    construct(name, {});
+}
+
+TrajectoryFunction::~TrajectoryFunction() = default;
+
+void TrajectoryFunction::evalColumns(const casadi::Function& function,
+        const std::vector<std::pair<const double*, casadi_int>>& inputs,
+        const std::vector<std::pair<double*, casadi_int>>& outputs) const {
+    m_threadPool->parallelFor(m_numPoints, [&](int begin, int end) {
+        // Each thread uses its own memory for the function.
+        std::vector<const double*> arg(function.sz_arg(), nullptr);
+        std::vector<double*> res(function.sz_res(), nullptr);
+        std::vector<casadi_int> iw(function.sz_iw());
+        std::vector<double> w(function.sz_w());
+        const casadi_int mem = function.checkout();
+        int flag = 0;
+        for (int k = begin; k < end && !flag; ++k) {
+            for (int i = 0; i < (int)inputs.size(); ++i) {
+                arg[i] = inputs[i].first ? inputs[i].first + k * inputs[i].second
+                                         : nullptr;
+            }
+            for (int i = 0; i < (int)outputs.size(); ++i) {
+                res[i] = outputs[i].first
+                                 ? outputs[i].first + k * outputs[i].second
+                                 : nullptr;
+            }
+            flag = function(arg.data(), res.data(), iw.data(), w.data(), mem);
+        }
+        function.release(mem);
+        OPENSIM_THROW_IF(flag, OpenSim::Exception,
+                "Evaluating {} failed.", function.name());
+    });
+}
+
+std::vector<casadi::DM> TrajectoryFunction::eval(
+        const std::vector<casadi::DM>& args) const {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::pair<const double*, casadi_int>> inputs;
+    for (casadi_int i = 0; i < n_in(); ++i) {
+        inputs.emplace_back(args.at(i).ptr(), m_pointFunction.nnz_in(i));
+    }
+    std::vector<casadi::DM> out;
+    std::vector<std::pair<double*, casadi_int>> outputs;
+    for (casadi_int i = 0; i < n_out(); ++i) {
+        out.emplace_back(sparsity_out(i));
+    }
+    for (casadi_int i = 0; i < n_out(); ++i) {
+        outputs.emplace_back(out[i].ptr(), m_pointFunction.nnz_out(i));
+    }
+    evalColumns(m_pointFunction, inputs, outputs);
+    ++m_times->numEvaluations;
+    m_times->time += secondsSince(start);
+    return out;
+}
+
+void TrajectoryFunction::initializeJacobian() const {
+    if (!m_pointJacobian.is_null()) return;
+    m_pointJacobian = m_pointFunction.jacobian();
+    const casadi::Sparsity& pointSparsity = m_pointJacobian.sparsity_out(0);
+    std::vector<casadi_int> pointRows;
+    std::vector<casadi_int> pointColumns;
+    pointSparsity.get_triplet(pointRows, pointColumns);
+
+    // The rows of the Jacobian of the point function are the stacked outputs
+    // of the point function; row r of output o at point k is row
+    // numPoints * offset(o) + k * nnz_out(o) + r of the Jacobian of this
+    // function. The columns are similar, for the inputs.
+    auto computeIndices = [this](const std::vector<casadi_int>& sizes,
+                                  std::vector<casadi_int>& first,
+                                  std::vector<casadi_int>& stride) {
+        casadi_int offset = 0;
+        for (casadi_int size : sizes) {
+            for (casadi_int r = 0; r < size; ++r) {
+                first.push_back(m_numPoints * offset + r);
+                stride.push_back(size);
+            }
+            offset += size;
+        }
+    };
+    std::vector<casadi_int> outputSizes;
+    for (casadi_int i = 0; i < m_pointFunction.n_out(); ++i) {
+        outputSizes.push_back(m_pointFunction.nnz_out(i));
+    }
+    std::vector<casadi_int> inputSizes;
+    for (casadi_int i = 0; i < m_pointFunction.n_in(); ++i) {
+        inputSizes.push_back(m_pointFunction.nnz_in(i));
+    }
+    std::vector<casadi_int> firstRow, rowStride, firstColumn, columnStride;
+    computeIndices(outputSizes, firstRow, rowStride);
+    computeIndices(inputSizes, firstColumn, columnStride);
+
+    const size_t pointNonzeros = pointRows.size();
+    std::vector<casadi_int> rows(m_numPoints * pointNonzeros);
+    std::vector<casadi_int> columns(m_numPoints * pointNonzeros);
+    for (int k = 0; k < m_numPoints; ++k) {
+        for (size_t e = 0; e < pointNonzeros; ++e) {
+            const casadi_int r = pointRows[e];
+            const casadi_int c = pointColumns[e];
+            rows[k * pointNonzeros + e] = firstRow[r] + k * rowStride[r];
+            columns[k * pointNonzeros + e] =
+                    firstColumn[c] + k * columnStride[c];
+        }
+    }
+    m_jacobianSparsity = casadi::Sparsity::triplet(
+            m_numPoints * m_pointFunction.nnz_out(),
+            m_numPoints * m_pointFunction.nnz_in(), rows, columns);
+    m_jacobianNonzeros = m_jacobianSparsity.get_nz(rows, columns);
+}
+
+casadi::Sparsity TrajectoryFunction::get_jacobian_sparsity() const {
+    initializeJacobian();
+    return m_jacobianSparsity;
+}
+
+casadi::Function TrajectoryFunction::get_jacobian(const std::string& name,
+        const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames,
+        const casadi::Dict& opts) const {
+    initializeJacobian();
+    if (!m_jacobian) {
+        casadi::Dict jacobianOpts = opts;
+        // Second derivatives, if needed, are computed with finite differences.
+        jacobianOpts["enable_fd"] = true;
+        m_jacobian.reset(
+                new TrajectoryJacobian(*this, name, inames, onames, jacobianOpts));
+    }
+    return *m_jacobian;
+}
+
+TrajectoryJacobian::TrajectoryJacobian(const TrajectoryFunction& function,
+        const std::string& name, const std::vector<std::string>& inames,
+        const std::vector<std::string>& onames, const casadi::Dict& opts)
+        : m_function(function), m_inames(inames), m_onames(onames) {
+    OPENSIM_THROW_IF(m_inames.size() !=
+                             size_t(function.n_in() + function.n_out()) ||
+                             m_onames.size() != 1,
+            OpenSim::Exception, "Internal error.");
+    construct(name, opts);
+}
+
+casadi::Sparsity TrajectoryJacobian::get_sparsity_in(casadi_int i) {
+    const casadi_int numInputs = m_function.n_in();
+    if (i < numInputs) return m_function.sparsity_in(i);
+    return m_function.sparsity_out(i - numInputs);
+}
+
+std::vector<casadi::DM> TrajectoryJacobian::eval(
+        const std::vector<casadi::DM>& args) const {
+    const auto start = std::chrono::steady_clock::now();
+    const casadi::Function& pointFunction = m_function.m_pointFunction;
+    // The inputs of the Jacobian of the point function are the inputs and
+    // outputs of the point function.
+    std::vector<std::pair<const double*, casadi_int>> inputs;
+    for (casadi_int i = 0; i < pointFunction.n_in(); ++i) {
+        inputs.emplace_back(args.at(i).ptr(), pointFunction.nnz_in(i));
+    }
+    for (casadi_int i = 0; i < pointFunction.n_out(); ++i) {
+        inputs.emplace_back(args.at(pointFunction.n_in() + i).ptr(),
+                pointFunction.nnz_out(i));
+    }
+    const casadi_int pointNonzeros = m_function.m_pointJacobian.nnz_out(0);
+    std::vector<double> pointJacobians(
+            m_function.m_numPoints * pointNonzeros);
+    m_function.evalColumns(m_function.m_pointJacobian, inputs,
+            {{pointJacobians.data(), pointNonzeros}});
+
+    casadi::DM jacobian(m_function.m_jacobianSparsity);
+    double* nonzeros = jacobian.ptr();
+    const auto& indices = m_function.m_jacobianNonzeros;
+    for (size_t e = 0; e < pointJacobians.size(); ++e) {
+        nonzeros[indices[e]] = pointJacobians[e];
+    }
+    ++m_function.m_times->numJacobianEvaluations;
+    m_function.m_times->jacobianTime += secondsSince(start);
+    return {jacobian};
+}
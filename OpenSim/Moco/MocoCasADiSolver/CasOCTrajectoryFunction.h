@@ -0,0 +1,197 @@
+#ifndef OPENSIM_CASOCTRAJECTORYFUNCTION_H
+#define OPENSIM_CASOCTRAJECTORYFUNCTION_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: CasOCTrajectoryFunction.h                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <atomic>
+#include <casadi/casadi.hpp>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace CasOC {
+
+/// A persistent pool of threads for evaluating functions across grid points.
+/// parallelFor() splits the grid points into contiguous chunks, in order, so
+/// that each thread works on neighboring grid points; a thread that finishes
+/// its chunk takes the next chunk that no thread has claimed yet. The thread
+/// that calls parallelFor() also works on chunks.
+/// tropter has its own ThreadPool (tropter/ThreadPool.h), but tropter is
+/// optional and cannot depend on OpenSim, and its pool hands out one task
+/// index at a time, so CasOC does not share it.
+class ThreadPool {
+public:
+    /// This creates numThreads - 1 threads.
+    explicit ThreadPool(int numThreads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getNumThreads() const { return (int)m_threads.size() + 1; }
+
+    /// Invoke `func(begin, end)` for contiguous ranges of [0, numItems), from
+    /// all threads, and wait for all ranges to finish. If `func` throws an
+    /// exception, the remaining ranges are skipped and the exception is
+    /// rethrown from this function. This function must not be invoked from
+    /// multiple threads at the same time.
+    void parallelFor(
+            int numItems, const std::function<void(int, int)>& func);
+
+private:
+    void workOnChunks();
+    void runThread();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_finishCondition;
+    const std::function<void(int, int)>* m_func = nullptr;
+    int m_numItems = 0;
+    int m_chunkSize = 0;
+    int m_numChunks = 0;
+    std::atomic<int> m_nextChunk{0};
+    // Incremented for each call to parallelFor(), to wake up the threads.
+    long long m_generation = 0;
+    int m_numBusyThreads = 0;
+    bool m_stop = false;
+    std::exception_ptr m_exception;
+};
+
+/// The wall time spent evaluating a function on trajectories, in seconds,
+/// in total and for each iteration of the optimization.
+struct EvaluationTimes {
+    int numEvaluations = 0;
+    double time = 0;
+    int numJacobianEvaluations = 0;
+    double jacobianTime = 0;
+    std::vector<double> iterationTimes;
+    /// Append the time (including Jacobians) since the previous iteration to
+    /// iterationTimes.
+    void endIteration() {
+        iterationTimes.push_back(time + jacobianTime - m_timeAtLastIteration);
+        m_timeAtLastIteration = time + jacobianTime;
+    }
+
+private:
+    double m_timeAtLastIteration = 0;
+};
+
+class TrajectoryJacobian;
+
+/// This function evaluates a point function (e.g., the multibody system) at
+/// each of the columns of its inputs, like casadi::Function::map(), but
+/// without any CasADi expression graph in between. The columns are evaluated
+/// directly in the calling thread if the ThreadPool has only one thread, or
+/// in parallel on the ThreadPool otherwise. The Jacobian is block diagonal,
+/// and its blocks are computed with the Jacobian of the point function at
+/// each column. The inputs and outputs of the point function must be column
+/// vectors (or empty).
+class TrajectoryFunction : public casadi::Callback {
+public:
+    TrajectoryFunction(const std::string& name,
+            const casadi::Function& pointFunction, int numPoints,
+            std::shared_ptr<ThreadPool> threadPool,
+            std::shared_ptr<EvaluationTimes> times);
+    ~TrajectoryFunction() override;
+
+    casadi_int get_n_in() override { return m_pointFunction.n_in(); }
+    casadi_int get_n_out() override { return m_pointFunction.n_out(); }
+    std::string get_name_in(casadi_int i) override {
+        return m_pointFunction.name_in(i);
+    }
+    std::string get_name_out(casadi_int i) override {
+        return m_pointFunction.name_out(i);
+    }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override {
+        return casadi::Sparsity::dense(m_pointFunction.size1_in(i),
+                m_pointFunction.size2_in(i) * m_numPoints);
+    }
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        return casadi::Sparsity::dense(m_pointFunction.size1_out(i),
+                m_pointFunction.size2_out(i) * m_numPoints);
+    }
+    std::vector<casadi::DM> eval(
+            const std::vector<casadi::DM>& args) const override;
+
+    bool has_jacobian_sparsity() const override { return true; }
+    casadi::Sparsity get_jacobian_sparsity() const override;
+    bool has_jacobian() const override { return true; }
+    casadi::Function get_jacobian(const std::string& name,
+            const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames,
+            const casadi::Dict& opts) const override;
+
+private:
+    /// Evaluate `function` at each of the m_numPoints columns. For each input
+    /// (output) of `function`, `inputs` (`outputs`) contains a pointer to the
+    /// nonzeros of all columns and the number of nonzeros per column.
+    void evalColumns(const casadi::Function& function,
+            const std::vector<std::pair<const double*, casadi_int>>& inputs,
+            const std::vector<std::pair<double*, casadi_int>>& outputs) const;
+    /// Create the Jacobian of the point function, the sparsity of the
+    /// Jacobian of this function, and m_jacobianNonzeros.
+    void initializeJacobian() const;
+
+    casadi::Function m_pointFunction;
+    int m_numPoints;
+    std::shared_ptr<ThreadPool> m_threadPool;
+    std::shared_ptr<EvaluationTimes> m_times;
+
+    mutable casadi::Function m_pointJacobian;
+    mutable casadi::Sparsity m_jacobianSparsity;
+    // The index into the nonzeros of the Jacobian of this function for each
+    // nonzero of the Jacobian of the point function at each point (the
+    // latter index varying fastest).
+    mutable std::vector<casadi_int> m_jacobianNonzeros;
+    // CasADi does not take ownership of callbacks, so we keep the Jacobian
+    // alive for as long as this function.
+    mutable std::unique_ptr<TrajectoryJacobian> m_jacobian;
+
+    friend class TrajectoryJacobian;
+};
+
+/// The Jacobian of a TrajectoryFunction with respect to all of its inputs.
+/// Its inputs are the inputs and the (nominal) outputs of the
+/// TrajectoryFunction.
+class TrajectoryJacobian : public casadi::Callback {
+public:
+    TrajectoryJacobian(const TrajectoryFunction& function,
+            const std::string& name, const std::vector<std::string>& inames,
+            const std::vector<std::string>& onames, const casadi::Dict& opts);
+    casadi_int get_n_in() override { return (casadi_int)m_inames.size(); }
+    casadi_int get_n_out() override { return 1; }
+    std::string get_name_in(casadi_int i) override { return m_inames.at(i); }
+    std::string get_name_out(casadi_int i) override { return m_onames.at(i); }
+    casadi::Sparsity get_sparsity_in(casadi_int i) override;
+    casadi::Sparsity get_sparsity_out(casadi_int i) override {
+        if (i == 0) return m_function.m_jacobianSparsity;
+        return casadi::Sparsity(0, 0);
+    }
+    std::vector<casadi::DM> eval(
+            const std::vector<casadi::DM>& args) const override;
+
+private:
+    const TrajectoryFunction& m_function;
+    std::vector<std::string> m_inames;
+    std::vector<std::string> m_onames;
+};
+
+} // namespace CasOC
+
+#endif // OPENSIM_CASOCTRAJECTORYFUNCTION_H
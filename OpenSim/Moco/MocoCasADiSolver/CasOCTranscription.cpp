@@ -67,6 +67,7 @@ public:
             m_problem.intermediateCallbackWithIterate(iterate);
         }
         m_problem.intermediateCallback();
+        m_transcription.recordIterationEvaluationTimes();
         ++evalCount;
         return {0};
     }
@@ -704,6 +705,9 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     solution.times = createTimes(
             solution.variables[initial_time], solution.variables[final_time]);
     solution.stats = nlpFunc.stats();
+    if (!m_evaluationTimes.empty()) {
+        solution.stats["trajectory_evaluation"] = createEvaluationTimesStats();
+    }
 
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
@@ -1180,8 +1184,27 @@ casadi::MXVector Transcription::evalOnTrajectory(
         const casadi::Function& pointFunction, const std::vector<Var>& inputs,
         const casadi::Matrix<casadi_int>& timeIndices) const {
     auto parallelism = m_solver.getParallelism();
-    const auto trajFunc = pointFunction.map(
-            timeIndices.size2(), parallelism.first, parallelism.second);
+    casadi::Function trajFunc;
+    if (m_solver.getGridEvaluationBackend() == "threadpool") {
+        // Avoid the overhead of map(), and evaluate in parallel (if
+        // requested) on threads that persist across evaluations.
+        if (!m_threadPool) {
+            const int numThreads = parallelism.first == "serial"
+                                           ? 1
+                                           : parallelism.second;
+            m_threadPool = std::make_shared<ThreadPool>(numThreads);
+        }
+        auto& times = m_evaluationTimes[pointFunction.name()];
+        if (!times) times = std::make_shared<EvaluationTimes>();
+        m_trajectoryFunctions.push_back(OpenSim::make_unique<TrajectoryFunction>(
+                fmt::format("{}_trajectory{}", pointFunction.name(),
+                        m_trajectoryFunctions.size()),
+                pointFunction, (int)timeIndices.size2(), m_threadPool, times));
+        trajFunc = *m_trajectoryFunctions.back();
+    } else {
+        trajFunc = pointFunction.map(
+                timeIndices.size2(), parallelism.first, parallelism.second);
+    }
 
     // Assemble input.
     // Add 1 for time input and 1 for parameters input.
@@ -1210,17 +1233,20 @@ casadi::MXVector Transcription::evalOnTrajectory(
     MXVector mxOut;
     trajFunc.call(mxIn, mxOut);
     return mxOut;
-    // TODO: Avoid the overhead of map() if not running in parallel.
-    /* } else {
-    casadi::MXVector out(pointFunction.n_out());
-    for (int iout = 0; iout < (int)out.size(); ++iout) {
-    out[iout] = casadi::MX(pointFunction.sparsity_out(iout).rows(),
-    timeIndices.size2());
-    }
-    for (int itime = 0; itime < timeIndices.size2(); ++itime) {
+}
 
+casadi::Dict Transcription::createEvaluationTimesStats() const {
+    casadi::Dict stats;
+    for (const auto& kv : m_evaluationTimes) {
+        const auto& times = *kv.second;
+        stats[kv.first] = casadi::Dict{
+                {"n_eval", times.numEvaluations},
+                {"t_wall", times.time},
+                {"n_eval_jac", times.numJacobianEvaluations},
+                {"t_wall_jac", times.jacobianTime},
+                {"t_wall_per_iteration", times.iterationTimes}};
     }
-    }*/
+    return stats;
 }
 
 } // namespace CasOC
@@ -19,6 +19,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "CasOCSolver.h"
+#include "CasOCTrajectoryFunction.h"
 
 namespace CasOC {
 
@@ -81,6 +82,16 @@ protected:
             const std::vector<Var>& inputs,
             const casadi::Matrix<casadi_int>& timeIndices) const;
 
+    /// Append the time spent evaluating each TrajectoryFunction since the
+    /// previous iteration to its EvaluationTimes. This is invoked for each
+    /// iteration of the optimization.
+    void recordIterationEvaluationTimes() const {
+        for (const auto& kv : m_evaluationTimes) kv.second->endIteration();
+    }
+    /// The EvaluationTimes of each point function evaluated with a
+    /// TrajectoryFunction, in a form suitable for Solution::stats.
+    casadi::Dict createEvaluationTimesStats() const;
+
     template <typename TRow, typename TColumn>
     void setVariableBounds(Var var, const TRow& rowIndices,
             const TColumn& columnIndices, const Bounds& bounds) {
@@ -150,6 +161,14 @@ private:
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    // These are used if the grid evaluation backend is "threadpool". The
+    // TrajectoryFunctions must outlive the NLP that refers to them.
+    mutable std::shared_ptr<ThreadPool> m_threadPool;
+    mutable std::vector<std::unique_ptr<TrajectoryFunction>>
+            m_trajectoryFunctions;
+    mutable std::map<std::string, std::shared_ptr<EvaluationTimes>>
+            m_evaluationTimes;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
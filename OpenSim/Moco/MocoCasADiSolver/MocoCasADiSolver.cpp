@@ -44,7 +44,9 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
     constructProperty_optim_finite_difference_scheme("central");
+    constructProperty_optim_stage_aware_finite_differences(false);
     constructProperty_parallel();
+    constructProperty_grid_evaluation_backend("casadi");
     constructProperty_output_interval(0);
 
     constructProperty_minimize_implicit_multibody_accelerations(false);
@@ -326,6 +328,9 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
     if (casProblem.getJarSize() > 1) {
         casSolver->setParallelism("thread", casProblem.getJarSize());
     }
+    checkPropertyValueIsInSet(getProperty_grid_evaluation_backend(),
+            {"casadi", "threadpool"});
+    casSolver->setGridEvaluationBackend(get_grid_evaluation_backend());
     casSolver->setPluginOptions(pluginOptions);
     casSolver->setSolverOptions(solverOptions);
     return casSolver;
@@ -426,6 +431,22 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
             casSolution.objective_breakdown);
 
     if (get_verbosity()) {
+        if (casSolution.stats.count("trajectory_evaluation")) {
+            log_info(std::string(72, '-'));
+            log_info("Time spent evaluating functions across grid points:");
+            log_info("{:>40} {:>8} {:>10} {:>8} {:>10}", "function",
+                    "n_eval", "t_wall", "n_jac", "t_wall_jac");
+            const casadi::Dict timings =
+                    casSolution.stats.at("trajectory_evaluation").to_dict();
+            for (const auto& kv : timings) {
+                const casadi::Dict function = kv.second.to_dict();
+                log_info("{:>40} {:>8} {:>10.3f} {:>8} {:>10.3f}", kv.first,
+                        function.at("n_eval").to_int(),
+                        function.at("t_wall").to_double(),
+                        function.at("n_eval_jac").to_int(),
+                        function.at("t_wall_jac").to_double());
+            }
+        }
         log_info(std::string(72, '-'));
         log_info("Elapsed real time: {}.", stopwatch.formatNs(elapsed));
         log_info(getFormattedDateTime(false, "%c"));
@@ -137,6 +137,15 @@ public:
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
+    OpenSim_DECLARE_PROPERTY(optim_stage_aware_finite_differences, bool,
+            "Compute the derivatives of the multibody dynamics by perturbing "
+            "each input directly in the model's state, so that only the "
+            "stages the input affects are realized again (e.g., Dynamics for "
+            "controls and auxiliary states), instead of letting CasADi apply "
+            "every perturbed input to the model (default: false). The "
+            "optim_finite_difference_scheme is still used. With "
+            "optim_sparsity_detection, inputs that affect disjoint outputs "
+            "are perturbed together.");
 
     OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
             "Evaluate integral costs and the differential-algebraic "
@@ -144,6 +153,16 @@ public:
             "0: not parallel; 1: use all cores (default); greater than 1: use"
             "this number of parallel jobs. This overrides the OPENSIM_MOCO_PARALLEL "
             "environment variable.");
+    OpenSim_DECLARE_PROPERTY(grid_evaluation_backend, std::string,
+            "How to evaluate the differential-algebraic equations, integral "
+            "costs, and path constraints across grid points: 'casadi' "
+            "(default) to use CasADi's map(), or 'threadpool' to evaluate the "
+            "grid points directly (serially if 'parallel' is 0) or on a "
+            "persistent pool of threads, one per copy of the model. "
+            "'threadpool' also reports the time spent evaluating each "
+            "function (if verbosity is at least 1). Use 'threadpool' with "
+            "optim_hessian_approximation 'limited-memory' (the default); "
+            "an exact Hessian is not sparse across grid points with it.");
     OpenSim_DECLARE_PROPERTY(output_interval, int,
             "Write intermediate trajectories to file. 0, the default, "
             "indicates no intermediate trajectories are saved, 1 indicates "
@@ -22,6 +22,9 @@
 
 #include <OpenSim/Simulation/SimulationUtilities.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace OpenSim;
 
 thread_local SimTK::Vector_<SimTK::SpatialVec>
@@ -36,6 +39,8 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
         : m_jar(std::move(jar)),
           m_paramsRequireInitSystem(
                   mocoCasADiSolver.get_parameters_require_initsystem()),
+          m_stageAwareFiniteDifferences(
+                  mocoCasADiSolver.get_optim_stage_aware_finite_differences()),
           m_formattedTimeString(getFormattedDateTime(true)) {
 
     setDynamicsMode(dynamicsMode);
@@ -253,3 +258,224 @@ MocoCasOCProblem::MocoCasOCProblem(const MocoCasADiSolver& mocoCasADiSolver,
             fmt::format("delete_this_to_stop_optimization_{}_{}.txt",
                     problemRep.getName(), m_formattedTimeString));
 }
+
+void MocoCasOCProblem::calcMultibodySystemJacobian(const ContinuousInput& input,
+        bool calcKCErrors, const std::string& finiteDiffScheme,
+        const CasOC::JacobianColoring& coloring, const casadi::DM& output,
+        casadi::DM& jacobian) const {
+    auto mocoProblemRep = m_jar->take();
+
+    const auto& modelDisabledConstraints =
+            mocoProblemRep->getModelDisabledConstraints();
+    auto& simtkStateDisabledConstraints =
+            mocoProblemRep->updStateDisabledConstraints();
+    const auto& discreteController =
+            mocoProblemRep->getDiscreteControllerDisabledConstraints();
+    const auto& implicitRefs =
+            mocoProblemRep->getImplicitComponentReferencePtrs();
+
+    // Copies of the input, which we perturb one group of elements at a time.
+    double time = input.time;
+    casadi::DM states = input.states;
+    casadi::DM controls = input.controls;
+    casadi::DM multipliers = input.multipliers;
+    casadi::DM derivatives = input.derivatives;
+    casadi::DM parameters = input.parameters;
+
+    // How a perturbed input is set in the state. Coordinates invalidate
+    // Stage::Position, speeds invalidate Stage::Velocity, auxiliary states
+    // and controls invalidate Stage::Dynamics, and the derivatives
+    // invalidate Stage::Acceleration (accelerations) or Stage::Dynamics
+    // (auxiliary derivatives). All other inputs are set with applyInput().
+    enum class Kind {
+        Coordinate,
+        Speed,
+        AuxiliaryState,
+        Control,
+        Acceleration,
+        AuxiliaryDerivative,
+        Other
+    };
+    struct Perturbation {
+        double* value;
+        Kind kind;
+        int index;
+    };
+    // Coordinates and speeds also determine the constraint forces computed
+    // from the multipliers, which requires applyInput().
+    const bool hasMultipliers = getNumMultipliers() > 0;
+    const int numCoordinates = getNumCoordinates();
+    const int numSpeeds = getNumSpeeds();
+    const int numAccelerations = getNumAccelerations();
+    std::vector<Perturbation> perturbations;
+    perturbations.push_back({&time, Kind::Other, 0});
+    for (int i = 0; i < (int)states.numel(); ++i) {
+        if (i < numCoordinates) {
+            perturbations.push_back({states.ptr() + i,
+                    hasMultipliers ? Kind::Other : Kind::Coordinate, i});
+        } else if (i < numCoordinates + numSpeeds) {
+            perturbations.push_back({states.ptr() + i,
+                    hasMultipliers ? Kind::Other : Kind::Speed,
+                    i - numCoordinates});
+        } else {
+            perturbations.push_back({states.ptr() + i, Kind::AuxiliaryState,
+                    i - numCoordinates - numSpeeds});
+        }
+    }
+    for (int i = 0; i < (int)controls.numel(); ++i) {
+        perturbations.push_back({controls.ptr() + i, Kind::Control, i});
+    }
+    for (int i = 0; i < (int)multipliers.numel(); ++i) {
+        perturbations.push_back({multipliers.ptr() + i, Kind::Other, i});
+    }
+    for (int i = 0; i < (int)derivatives.numel(); ++i) {
+        if (i < numAccelerations) {
+            perturbations.push_back(
+                    {derivatives.ptr() + i, Kind::Acceleration, i});
+        } else {
+            perturbations.push_back({derivatives.ptr() + i,
+                    Kind::AuxiliaryDerivative, i - numAccelerations});
+        }
+    }
+    for (int i = 0; i < (int)parameters.numel(); ++i) {
+        perturbations.push_back({parameters.ptr() + i, Kind::Other, i});
+    }
+
+    const int numOutputs = (int)output.numel();
+    OPENSIM_THROW_IF(jacobian.size1() != numOutputs ||
+                             jacobian.size2() != (int)perturbations.size() ||
+                             !jacobian.is_dense() ||
+                             coloring.sparsity.size1() != numOutputs ||
+                             coloring.sparsity.size2() !=
+                                     (int)perturbations.size(),
+            Exception, "Internal error: expected a dense {} x {} Jacobian.",
+            numOutputs, perturbations.size());
+
+    // This view of the derivatives reflects the perturbations.
+    SimTK::Vector udot;
+    if (numAccelerations) {
+        udot = SimTK::Vector(numAccelerations, derivatives.ptr(), true);
+    }
+    auto setInState = [&](const Perturbation& perturbation) {
+        const double value = *perturbation.value;
+        switch (perturbation.kind) {
+        case Kind::Coordinate:
+            simtkStateDisabledConstraints.updQ()[m_yIndexMap.at(
+                    perturbation.index)] = value;
+            modelDisabledConstraints.getSystem().prescribe(
+                    simtkStateDisabledConstraints);
+            break;
+        case Kind::Speed:
+            simtkStateDisabledConstraints.updU()[perturbation.index] = value;
+            modelDisabledConstraints.getSystem().prescribe(
+                    simtkStateDisabledConstraints);
+            break;
+        case Kind::AuxiliaryState:
+            simtkStateDisabledConstraints.updZ()[perturbation.index] = value;
+            break;
+        case Kind::Control:
+            discreteController.updDiscreteControls(
+                    simtkStateDisabledConstraints)
+                    [m_modelControlIndices[perturbation.index]] = value;
+            break;
+        case Kind::Acceleration:
+            mocoProblemRep->getAccelerationMotion().setUDot(
+                    simtkStateDisabledConstraints, udot);
+            break;
+        case Kind::AuxiliaryDerivative: {
+            const auto& ref = implicitRefs[perturbation.index];
+            ref.second.getRef().setDiscreteVariableValue(
+                    simtkStateDisabledConstraints, ref.first, value);
+            break;
+        }
+        default:
+            OPENSIM_THROW(Exception, "Internal error.");
+        }
+    };
+
+    // Outputs of the multibody system function.
+    casadi::DM multibody =
+            casadi::DM::zeros(getNumMultibodyDynamicsEquations(), 1);
+    casadi::DM auxiliaryDerivatives =
+            casadi::DM::zeros(getNumAuxiliaryStates(), 1);
+    casadi::DM auxiliaryResiduals =
+            casadi::DM::zeros(getNumAuxiliaryResidualEquations(), 1);
+    casadi::DM kinematicConstraintErrors = casadi::DM::zeros(
+            calcKCErrors ? getNumKinematicConstraintEquations() : 0, 1);
+
+    // Whether the state matches the copies of the input, except for inputs
+    // that setInState() can restore.
+    bool isStateApplied = false;
+    // Evaluate the outputs with the inputs in the group perturbed.
+    auto calcOutput = [&](const std::vector<int>& group, double* values) {
+        const bool hasOther = std::any_of(group.begin(), group.end(),
+                [&](int j) { return perturbations[j].kind == Kind::Other; });
+        if (isStateApplied && !hasOther) {
+            for (int j : group) setInState(perturbations[j]);
+        } else {
+            applyInput(SimTK::Stage::Acceleration, time, states, controls,
+                    multipliers, derivatives, parameters, mocoProblemRep);
+            isStateApplied = !hasOther;
+        }
+        if (isDynamicsModeImplicit()) {
+            MultibodySystemImplicitOutput out{multibody, auxiliaryDerivatives,
+                    auxiliaryResiduals, kinematicConstraintErrors};
+            calcMultibodySystemImplicitOutput(
+                    *mocoProblemRep, calcKCErrors, out);
+        } else {
+            MultibodySystemExplicitOutput out{multibody, auxiliaryDerivatives,
+                    auxiliaryResiduals, kinematicConstraintErrors};
+            calcMultibodySystemExplicitOutput(
+                    *mocoProblemRep, calcKCErrors, out);
+        }
+        for (const casadi::DM* dm : {&multibody, &auxiliaryDerivatives,
+                     &auxiliaryResiduals, &kinematicConstraintErrors}) {
+            values = std::copy_n(dm->ptr(), dm->nnz(), values);
+        }
+    };
+
+    const bool central = finiteDiffScheme == "central";
+    const double direction = finiteDiffScheme == "backward" ? -1.0 : 1.0;
+    // These step sizes balance truncation and roundoff errors.
+    const double relativeStep =
+            central ? std::cbrt(SimTK::Eps) : std::sqrt(SimTK::Eps);
+    const double* nominal = output.ptr();
+    const casadi_int* colind = coloring.sparsity.colind();
+    const casadi_int* row = coloring.sparsity.row();
+    std::vector<double> plus(numOutputs);
+    std::vector<double> minus(numOutputs);
+    std::vector<double> x0(perturbations.size());
+    std::vector<double> steps(perturbations.size());
+    // No two inputs in a group affect the same output, so each output
+    // difference is assigned to the one input in the group that affects it.
+    for (const auto& group : coloring.columnGroups) {
+        for (int j : group) {
+            x0[j] = *perturbations[j].value;
+            steps[j] = relativeStep * std::max(1.0, std::abs(x0[j]));
+            *perturbations[j].value =
+                    x0[j] + (central ? steps[j] : direction * steps[j]);
+        }
+        calcOutput(group, plus.data());
+        if (central) {
+            for (int j : group) *perturbations[j].value = x0[j] - steps[j];
+            calcOutput(group, minus.data());
+        }
+        for (int j : group) {
+            // Divide by the step that was actually taken.
+            const double h = central ? (x0[j] + steps[j]) - (x0[j] - steps[j])
+                                     : (x0[j] + direction * steps[j]) - x0[j];
+            double* column = jacobian.ptr() + (size_t)j * numOutputs;
+            for (casadi_int k = colind[j]; k < colind[j + 1]; ++k) {
+                const casadi_int i = row[k];
+                column[i] = central ? (plus[i] - minus[i]) / h
+                                    : (plus[i] - nominal[i]) / h;
+            }
+            *perturbations[j].value = x0[j];
+        }
+        if (isStateApplied) {
+            for (int j : group) setInState(perturbations[j]);
+        }
+    }
+
+    m_jar->leave(std::move(mocoProblemRep));
+}
@@ -206,40 +206,12 @@ private:
             MultibodySystemExplicitOutput& output) const override {
         auto mocoProblemRep = m_jar->take();
 
-        const auto& modelBase = mocoProblemRep->getModelBase();
-        auto& simtkStateBase = mocoProblemRep->updStateBase();
-
-        const auto& modelDisabledConstraints =
-                mocoProblemRep->getModelDisabledConstraints();
-        auto& simtkStateDisabledConstraints =
-                mocoProblemRep->updStateDisabledConstraints();
-
         applyInput(SimTK::Stage::Acceleration, input.time, input.states,
                 input.controls, input.multipliers, input.derivatives,
                 input.parameters, mocoProblemRep);
 
-        // Compute the accelerations.
-        modelDisabledConstraints.realizeAcceleration(
-                simtkStateDisabledConstraints);
-
-        // Compute kinematic constraint errors if they exist.
-        if (getNumMultipliers() && calcKCErrors) {
-            calcKinematicConstraintErrors(modelBase, simtkStateBase,
-                    simtkStateDisabledConstraints,
-                    output.kinematic_constraint_errors);
-        }
-
-        // Copy state derivative values to output.
-        const auto& udot = simtkStateDisabledConstraints.getUDot();
-        const auto& zdot = simtkStateDisabledConstraints.getZDot();
-        std::copy_n(udot.getContiguousScalarData(), udot.size(),
-                output.multibody_derivatives.ptr());
-        std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
-                output.auxiliary_derivatives.ptr());
-
-        // Copy auxiliary residuals to output.
-        copyImplicitResidualsToOutput(*mocoProblemRep,
-                simtkStateDisabledConstraints, output.auxiliary_residuals);
+        calcMultibodySystemExplicitOutput(
+                *mocoProblemRep, calcKCErrors, output);
 
         m_jar->leave(std::move(mocoProblemRep));
     }
@@ -248,54 +220,34 @@ private:
             MultibodySystemImplicitOutput& output) const override {
         auto mocoProblemRep = m_jar->take();
 
-        // Original model and its associated state. These are used to calculate
-        // kinematic constraint forces and errors.
-        const auto& modelBase = mocoProblemRep->getModelBase();
-        auto& simtkStateBase = mocoProblemRep->updStateBase();
-
-        // Model with disabled constriants and its associated state. These are
-        // used to compute the accelerations.
-        const auto& modelDisabledConstraints =
-                mocoProblemRep->getModelDisabledConstraints();
-        auto& simtkStateDisabledConstraints =
-                mocoProblemRep->updStateDisabledConstraints();
-
         applyInput(SimTK::Stage::Acceleration, input.time, input.states,
                 input.controls, input.multipliers, input.derivatives,
                 input.parameters, mocoProblemRep);
 
-        modelDisabledConstraints.realizeAcceleration(
-                simtkStateDisabledConstraints);
-
-        // Compute kinematic constraint errors if they exist.
-        // TODO: Do not enforce kinematic constraints if prescribedKinematics,
-        // but must make sure the prescribedKinematics already obey the
-        // constraints. This is simple at the q and u level (using assemble()),
-        // but what do we do for the acceleration level?
-        if (getNumMultipliers() && calcKCErrors) {
-            calcKinematicConstraintErrors(modelBase, simtkStateBase,
-                    simtkStateDisabledConstraints,
-                    output.kinematic_constraint_errors);
-        }
-
-        const SimTK::SimbodyMatterSubsystem& matterDisabledConstraints =
-                modelDisabledConstraints.getMatterSubsystem();
-        SimTK::Vector simtkResidual((int)output.multibody_residuals.rows(),
-                output.multibody_residuals.ptr(), true);
-        matterDisabledConstraints.findMotionForces(
-                simtkStateDisabledConstraints, simtkResidual);
-
-        // Copy auxiliary dynamics to output.
-        const auto& zdot = simtkStateDisabledConstraints.getZDot();
-        std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
-                output.auxiliary_derivatives.ptr());
-
-        // Copy auxiliary residuals to output.
-        copyImplicitResidualsToOutput(*mocoProblemRep,
-                simtkStateDisabledConstraints, output.auxiliary_residuals);
+        calcMultibodySystemImplicitOutput(
+                *mocoProblemRep, calcKCErrors, output);
 
         m_jar->leave(std::move(mocoProblemRep));
     }
+    bool hasMultibodySystemJacobian() const override {
+        return m_stageAwareFiniteDifferences;
+    }
+    /// Perturbs each input directly in the state of a single MocoProblemRep
+    /// from the jar, instead of applying the entire input for every
+    /// perturbation as CasADi's finite differences do. Changing a control or
+    /// an auxiliary state only invalidates Stage::Dynamics, changing a speed
+    /// invalidates Stage::Velocity, and changing a coordinate invalidates
+    /// Stage::Position, so realizing to Acceleration only recomputes the
+    /// stages that the perturbed input affects. Time, parameters, and
+    /// multipliers (and coordinates and speeds if there are kinematic
+    /// constraints, as they also affect the constraint forces) are applied
+    /// with applyInput(). The inputs of each column group of `coloring` are
+    /// perturbed together; with sparsity detection, there are usually far
+    /// fewer groups than inputs, and without it, each input is its own group.
+    void calcMultibodySystemJacobian(const ContinuousInput& input,
+            bool calcKCErrors, const std::string& finiteDiffScheme,
+            const CasOC::JacobianColoring& coloring, const casadi::DM& output,
+            casadi::DM& jacobian) const override;
     void calcVelocityCorrection(const double& time,
             const casadi::DM& multibody_states, const casadi::DM& slacks,
             const casadi::DM& parameters,
@@ -641,6 +593,90 @@ private:
         }
     }
 
+    /// Realize the state of ModelDisabledConstraints, to which the input has
+    /// been applied, and compute the outputs of calcMultibodySystemExplicit().
+    void calcMultibodySystemExplicitOutput(
+            const MocoProblemRep& mocoProblemRep, bool calcKCErrors,
+            MultibodySystemExplicitOutput& output) const {
+        const auto& modelBase = mocoProblemRep.getModelBase();
+        auto& simtkStateBase = mocoProblemRep.updStateBase();
+
+        const auto& modelDisabledConstraints =
+                mocoProblemRep.getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep.updStateDisabledConstraints();
+
+        // Compute the accelerations.
+        modelDisabledConstraints.realizeAcceleration(
+                simtkStateDisabledConstraints);
+
+        // Compute kinematic constraint errors if they exist.
+        if (getNumMultipliers() && calcKCErrors) {
+            calcKinematicConstraintErrors(modelBase, simtkStateBase,
+                    simtkStateDisabledConstraints,
+                    output.kinematic_constraint_errors);
+        }
+
+        // Copy state derivative values to output.
+        const auto& udot = simtkStateDisabledConstraints.getUDot();
+        const auto& zdot = simtkStateDisabledConstraints.getZDot();
+        std::copy_n(udot.getContiguousScalarData(), udot.size(),
+                output.multibody_derivatives.ptr());
+        std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
+                output.auxiliary_derivatives.ptr());
+
+        // Copy auxiliary residuals to output.
+        copyImplicitResidualsToOutput(mocoProblemRep,
+                simtkStateDisabledConstraints, output.auxiliary_residuals);
+    }
+    /// Realize the state of ModelDisabledConstraints, to which the input has
+    /// been applied, and compute the outputs of calcMultibodySystemImplicit().
+    void calcMultibodySystemImplicitOutput(
+            const MocoProblemRep& mocoProblemRep, bool calcKCErrors,
+            MultibodySystemImplicitOutput& output) const {
+        // Original model and its associated state. These are used to calculate
+        // kinematic constraint forces and errors.
+        const auto& modelBase = mocoProblemRep.getModelBase();
+        auto& simtkStateBase = mocoProblemRep.updStateBase();
+
+        // Model with disabled constriants and its associated state. These are
+        // used to compute the accelerations.
+        const auto& modelDisabledConstraints =
+                mocoProblemRep.getModelDisabledConstraints();
+        auto& simtkStateDisabledConstraints =
+                mocoProblemRep.updStateDisabledConstraints();
+
+        modelDisabledConstraints.realizeAcceleration(
+                simtkStateDisabledConstraints);
+
+        // Compute kinematic constraint errors if they exist.
+        // TODO: Do not enforce kinematic constraints if prescribedKinematics,
+        // but must make sure the prescribedKinematics already obey the
+        // constraints. This is simple at the q and u level (using assemble()),
+        // but what do we do for the acceleration level?
+        if (getNumMultipliers() && calcKCErrors) {
+            calcKinematicConstraintErrors(modelBase, simtkStateBase,
+                    simtkStateDisabledConstraints,
+                    output.kinematic_constraint_errors);
+        }
+
+        const SimTK::SimbodyMatterSubsystem& matterDisabledConstraints =
+                modelDisabledConstraints.getMatterSubsystem();
+        SimTK::Vector simtkResidual((int)output.multibody_residuals.rows(),
+                output.multibody_residuals.ptr(), true);
+        matterDisabledConstraints.findMotionForces(
+                simtkStateDisabledConstraints, simtkResidual);
+
+        // Copy auxiliary dynamics to output.
+        const auto& zdot = simtkStateDisabledConstraints.getZDot();
+        std::copy_n(zdot.getContiguousScalarData(), zdot.size(),
+                output.auxiliary_derivatives.ptr());
+
+        // Copy auxiliary residuals to output.
+        copyImplicitResidualsToOutput(mocoProblemRep,
+                simtkStateDisabledConstraints, output.auxiliary_residuals);
+    }
+
     void calcKinematicConstraintForces(const casadi::DM& multipliers,
             const SimTK::State& stateBase, const Model& modelBase,
             const DiscreteForces& constraintForces,
@@ -748,6 +784,7 @@ private:
 
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>> m_jar;
     bool m_paramsRequireInitSystem = true;
+    bool m_stageAwareFiniteDifferences = false;
     std::string m_formattedTimeString;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
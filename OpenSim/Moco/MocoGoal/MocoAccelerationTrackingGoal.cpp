@@ -89,6 +89,7 @@ void MocoAccelerationTrackingGoal::initializeOnModelImpl(
     m_ref_splines = GCVSplineSet(accelerationTable.flatten(
         {"/acceleration_x", "/acceleration_y", "/acceleration_z"}));
 
+    m_ref_cache.initialize(getProblemInfo());
     setRequirements(1, 1);
 }
 
@@ -99,7 +100,7 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
     getModel().realizeAcceleration(state);
     const auto& ground = getModel().getGround();
     const auto& gravity = getModel().getGravity();
-    SimTK::Vector timeVec(1, time);
+    const double* refValues = m_ref_cache.getValues(m_ref_splines, time);
 
     integrand = 0;
     Vec3 acceleration_ref(0.0);
@@ -109,8 +110,7 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
 
         // Spline the acceleration reference data.
         for (int ia = 0; ia < acceleration_ref.size(); ++ia) {
-            acceleration_ref[ia] =
-                    m_ref_splines[3*iframe + ia].calcValue(timeVec);
+            acceleration_ref[ia] = refValues[3*iframe + ia];
         }
 
         // Gravity offset.
@@ -132,6 +132,7 @@ void MocoAngularVelocityTrackingGoal::initializeOnModelImpl(
     m_ref_splines = GCVSplineSet(angularVelocityTable.flatten(
         {"/angular_velocity_x", "/angular_velocity_y", "/angular_velocity_z"}));
 
+    m_ref_cache.initialize(getProblemInfo());
     setRequirements(1, 1, SimTK::Stage::Velocity);
 }
 
@@ -140,7 +141,7 @@ void MocoAngularVelocityTrackingGoal::calcIntegrandImpl(
     const auto& state = input.state;
     const auto& time = state.getTime();
     getModel().realizeVelocity(state);
-    SimTK::Vector timeVec(1, time);
+    const double* refValues = m_ref_cache.getValues(m_ref_splines, time);
 
     integrand = 0;
     Vec3 angular_velocity_ref(0.0);
@@ -150,8 +151,7 @@ void MocoAngularVelocityTrackingGoal::calcIntegrandImpl(
 
         // Compute angular velocity error.
         for (int iw = 0; iw < angular_velocity_ref.size(); ++iw) {
-            angular_velocity_ref[iw] =
-                    m_ref_splines[3 * iframe + iw].calcValue(timeVec);
+            angular_velocity_ref[iw] = refValues[3 * iframe + iw];
         }
         Vec3 error = angular_velocity_model - angular_velocity_ref;
 
@@ -174,6 +174,7 @@ void MocoContactTrackingGoal::initializeOnModelImpl(const Model& model) const {
         groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "x"));
         groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "y"));
         groupInfo.refSplines.cloneAndAppend(allRefSplines.get(forceID + "z"));
+        groupInfo.refCache.initialize(getProblemInfo());
 
         // Check which frame the contact force data is expressed in.
         groupInfo.refExpressedInFrame = nullptr;
@@ -297,14 +298,13 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
     const auto& state = input.state;
     const auto& time = state.getTime();
     getModel().realizeVelocity(state);
-    SimTK::Vector timeVec(1, time);
 
     integrand = 0;
     SimTK::Vec3 force_ref;
     for (int ig = 0; ig < (int)m_groups.size(); ++ig) {
 
         // Get contact groups.
-        const auto& group = m_groups[ig];
+        auto& group = m_groups[ig];
 
         // Model force.
         SimTK::Vec3 force_model(0);
@@ -317,8 +317,10 @@ void MocoContactTrackingGoal::calcIntegrandImpl(
         }
 
         // Reference force.
+        const double* refValues =
+                group.refCache.getValues(group.refSplines, time);
         for (int ir = 0; ir < force_ref.size(); ++ir) {
-            force_ref[ir] = group.refSplines[ir].calcValue(timeVec);
+            force_ref[ir] = refValues[ir];
         }
 
         // Re-express the reference force.
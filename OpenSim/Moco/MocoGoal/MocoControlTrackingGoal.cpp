@@ -182,6 +182,7 @@ void MocoControlTrackingGoal::initializeOnModelImpl(const Model& model) const {
             m_scaleFactorRefs.emplace_back(nullptr);
         }
     }
+    m_ref_cache.initialize(getProblemInfo());
     setRequirements(1, 1, SimTK::Stage::Time);
 }
 
@@ -189,15 +190,14 @@ void MocoControlTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
 
     const auto& time = input.time;
-    SimTK::Vector timeVec(1, time);
+    const double* refValues = m_ref_cache.getValues(m_ref_splines, time);
     const auto& controls = input.controls;
     getModel().getMultibodySystem().realize(input.state, SimTK::Stage::Time);
 
     integrand = 0;
     for (int i = 0; i < (int)m_control_indices.size(); ++i) {
         const auto& modelValue = controls[m_control_indices[i]];
-        const auto& refValue =
-                m_ref_splines[m_ref_indices[i]].calcValue(timeVec);
+        const auto& refValue = refValues[m_ref_indices[i]];
 
         // If a scale factor exists for this control, retrieve its value.
         double scaleFactor = 1.0;
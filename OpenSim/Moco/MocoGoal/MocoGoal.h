@@ -23,6 +23,7 @@
 #include <OpenSim/Common/Object.h>
 #include <OpenSim/Moco/MocoBounds.h>
 #include <OpenSim/Moco/MocoConstraintInfo.h>
+#include <OpenSim/Moco/MocoProblemInfo.h>
 #include <OpenSim/Moco/MocoScaleFactor.h>
 #include <OpenSim/Moco/osimMocoDLL.h>
 
@@ -262,9 +263,12 @@ public:
     /// Perform error checks on user input for this goal, and cache
     /// quantities needed when computing the goal value.
     /// This function must be invoked before invoking calcIntegrand() or
-    /// calcGoal().
-    void initializeOnModel(const Model& model) const {
+    /// calcGoal(). MocoProblemRep passes information about the problem (e.g.,
+    /// whether the final time is fixed) in problemInfo.
+    void initializeOnModel(const Model& model,
+            const MocoProblemInfo& problemInfo = MocoProblemInfo()) const {
         m_model.reset(&model);
+        m_problemInfo = problemInfo;
         if (!get_enabled()) { return; }
 
         // Set mode.
@@ -372,6 +376,8 @@ protected:
                 "Model is not available until the start of initializing.");
         return m_model.getRef();
     }
+    /// The information about the problem passed to initializeOnModel().
+    const MocoProblemInfo& getProblemInfo() const { return m_problemInfo; }
 
     double calcSystemDisplacement(
             const SimTK::State& initial, const SimTK::State& final) const;
@@ -412,6 +418,7 @@ private:
     }
 
     mutable SimTK::ReferencePtr<const Model> m_model;
+    mutable MocoProblemInfo m_problemInfo;
     mutable double m_weightToUse;
     mutable Mode m_modeToUse;
     mutable SimTK::Stage m_stageDependency = SimTK::Stage::Acceleration;
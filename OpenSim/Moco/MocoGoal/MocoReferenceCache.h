@@ -0,0 +1,147 @@
+#ifndef OPENSIM_MOCOREFERENCECACHE_H
+#define OPENSIM_MOCOREFERENCECACHE_H
+/* -------------------------------------------------------------------------- *
+ * OpenSim: MocoReferenceCache.h                                              *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2022 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Moco/MocoProblemInfo.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace OpenSim {
+
+/// This class holds the values of a tracking goal's reference splines at the
+/// times at which the goal is evaluated. Solvers evaluate goals at the same
+/// mesh times on every iteration, so each spline is evaluated only once per
+/// mesh time and later evaluations read the values from a contiguous array.
+/// When the mesh changes (e.g., with mesh refinement), the new times are
+/// sampled as they are encountered, and the cache is cleared once it holds
+/// more than getMaxNumTimes() times. If the initial or final time of the
+/// problem is free, the mesh times change on every iteration, so the cache is
+/// disabled and getValues() evaluates the splines directly.
+///
+/// A goal must call initialize() (or clear()) whenever it rebuilds its
+/// splines. Times are matched exactly, as the solvers compute the same mesh
+/// times in the same way on every iteration. The cache is
+/// not thread-safe; each thread must use its own goal (as is already the case
+/// for the MocoProblemRep copies used by the solvers).
+/// @note This class is an implementation detail of the tracking goals.
+class MocoReferenceCache {
+public:
+    /// Discard all cached values, and enable the cache only if the initial
+    /// and final times of the problem are fixed.
+    void initialize(const MocoProblemInfo& problemInfo) {
+        clear();
+        m_enabled =
+                problemInfo.initialTimeIsFixed && problemInfo.finalTimeIsFixed;
+    }
+
+    /// Discard all cached values.
+    void clear() {
+        m_times.clear();
+        m_values.clear();
+        m_indices.clear();
+        m_lastIndex = 0;
+        m_numSplines = 0;
+    }
+
+    /// Get the values of all splines in the set at the given time, in the
+    /// order of the set. The returned pointer is valid until the next call
+    /// to getValues() or clear().
+    const double* getValues(const GCVSplineSet& splines, double time) {
+        const int numSplines = splines.getSize();
+        if (numSplines != m_numSplines) {
+            clear();
+            m_numSplines = numSplines;
+        }
+        if (!numSplines) return nullptr;
+        if (!m_enabled) return evaluate(splines, time);
+        const int numTimes = (int)m_times.size();
+        if (numTimes) {
+            // The goal is usually evaluated at the mesh times in the same
+            // order as during the previous pass, so try the time after the
+            // one used last before searching.
+            const int next = m_lastIndex + 1 == numTimes ? 0 : m_lastIndex + 1;
+            if (m_times[next] == time) {
+                m_lastIndex = next;
+            } else if (m_times[m_lastIndex] != time) {
+                const auto it = m_indices.find(time);
+                if (it == m_indices.end()) return sample(splines, time);
+                m_lastIndex = it->second;
+            }
+            return &m_values[(size_t)m_lastIndex * numSplines];
+        }
+        return sample(splines, time);
+    }
+
+    /// Whether getValues() uses the cache. If not, it evaluates the splines
+    /// on every call.
+    bool getEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled) {
+        clear();
+        m_enabled = enabled;
+    }
+
+    /// The number of times whose values are currently cached.
+    int getNumTimes() const { return (int)m_times.size(); }
+
+    /// The maximum number of times to hold before the cache is cleared.
+    int getMaxNumTimes() const { return m_maxNumTimes; }
+    void setMaxNumTimes(int maxNumTimes) { m_maxNumTimes = maxNumTimes; }
+
+private:
+    const double* evaluate(const GCVSplineSet& splines, double time) {
+        m_values.resize(m_numSplines);
+        SimTK::Vector timeVec(1, time);
+        for (int i = 0; i < m_numSplines; ++i) {
+            m_values[i] = splines[i].calcValue(timeVec);
+        }
+        return m_values.data();
+    }
+
+    const double* sample(const GCVSplineSet& splines, double time) {
+        if ((int)m_times.size() >= m_maxNumTimes) {
+            const int numSplines = m_numSplines;
+            clear();
+            m_numSplines = numSplines;
+        }
+        m_lastIndex = (int)m_times.size();
+        m_times.push_back(time);
+        m_indices[time] = m_lastIndex;
+        m_values.resize(m_times.size() * m_numSplines);
+        double* values = &m_values[(size_t)m_lastIndex * m_numSplines];
+        SimTK::Vector timeVec(1, time);
+        for (int i = 0; i < m_numSplines; ++i) {
+            values[i] = splines[i].calcValue(timeVec);
+        }
+        return values;
+    }
+
+    std::vector<double> m_times;
+    // Row-major: the values of all splines at m_times[i] start at
+    // m_values[i * m_numSplines].
+    std::vector<double> m_values;
+    std::unordered_map<double, int> m_indices;
+    int m_lastIndex = 0;
+    int m_numSplines = 0;
+    int m_maxNumTimes = 10000;
+    bool m_enabled = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MOCOREFERENCECACHE_H
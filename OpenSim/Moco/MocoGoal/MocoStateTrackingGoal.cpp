@@ -136,6 +136,7 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
         }
     }
 
+    m_refcache.initialize(getProblemInfo());
     setRequirements(1, 1, SimTK::Stage::Time);
 }
 
@@ -143,14 +144,12 @@ void MocoStateTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
     const auto& time = input.time;
 
-    SimTK::Vector timeVec(1, time);
+    const double* refValues = m_refcache.getValues(m_refsplines, time);
 
-    // TODO cache the reference coordinate values at the mesh points, rather
-    // than evaluating the spline.
     integrand = 0;
     for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
         const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const auto& refValue = refValues[iref];
 
         // If a scale factor exists for this state, retrieve its value.
         double scaleFactor = 1.0;
@@ -18,6 +18,8 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <limits>
+
 namespace OpenSim {
 
 /// This class is mostly for internal use for MocoProblemRep to pass select
@@ -25,8 +27,12 @@ namespace OpenSim {
 /// the problem during initializeOnModel().
 class MocoProblemInfo {
 public:
-    double minInitialTime;
-    double maxFinalTime;
+    double minInitialTime = -std::numeric_limits<double>::infinity();
+    double maxFinalTime = std::numeric_limits<double>::infinity();
+    /// Whether the bounds on the initial (final) time are an equality, so that
+    /// the solvers use the same mesh times on every iteration.
+    bool initialTimeIsFixed = true;
+    bool finalTimeIsFixed = true;
 };
 
 } // namespace OpenSim
@@ -544,6 +544,12 @@ void MocoProblemRep::initialize() {
         ++iparam;
     }
 
+    MocoProblemInfo problemInfo;
+    problemInfo.minInitialTime = getTimeInitialBounds().getLower();
+    problemInfo.maxFinalTime = getTimeFinalBounds().getUpper();
+    problemInfo.initialTimeIsFixed = getTimeInitialBounds().isEquality();
+    problemInfo.finalTimeIsFixed = getTimeFinalBounds().isEquality();
+
     // Goals.
     // ------
     std::unordered_set<std::string> goalNames;
@@ -556,7 +562,7 @@ void MocoProblemRep::initialize() {
         goalNames.insert(goal.getName());
         if (goal.getEnabled()) {
             std::unique_ptr<MocoGoal> item(goal.clone());
-            item->initializeOnModel(m_model_disabled_constraints);
+            item->initializeOnModel(m_model_disabled_constraints, problemInfo);
             if (item->getModeIsEndpointConstraint()) {
                 m_endpoint_constraints.push_back(std::move(item));
             } else {
@@ -565,10 +571,6 @@ void MocoProblemRep::initialize() {
         }
     }
 
-    MocoProblemInfo problemInfo;
-    problemInfo.minInitialTime = getTimeInitialBounds().getLower();
-    problemInfo.maxFinalTime = getTimeFinalBounds().getUpper();
-
     // Auxiliary path constraints.
     // ---------------------------
     m_num_path_constraint_equations = 0;
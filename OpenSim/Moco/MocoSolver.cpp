@@ -103,9 +103,13 @@ void MocoSolver::setSolutionStats(MocoSolution& sol, bool success,
 
 std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
         MocoSolver::createProblemRepJar(int size) const {
-    auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>();
-    for (int i = 0; i < size; ++i) {
-        jar->leave(std::unique_ptr<MocoProblemRep>(m_problem->createRepHeap()));
-    }
-    return jar;
+    // The MocoProblemReps are created when a thread first needs one, one at a
+    // time, since processing, copying, and initializing models is not
+    // threadsafe. The problem must not change while the jar is in use.
+    const MocoProblem* problem = m_problem.get();
+    return OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>(
+            [problem]() -> std::unique_ptr<const MocoProblemRep> {
+                return problem->createRepHeap();
+            },
+            size);
 }
@@ -94,6 +94,8 @@ protected:
     }
 
     /// Create a library of MocoProblemRep%s for use in parallelized code.
+    /// The MocoProblemRep%s are created lazily (one at a time) as threads
+    /// take them from the jar, up to `size` of them.
     // TODO SWIG ignore.
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
     createProblemRepJar(int size) const;
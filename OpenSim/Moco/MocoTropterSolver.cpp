@@ -20,6 +20,7 @@
 #include "MocoProblemRep.h"
 #include "MocoUtilities.h"
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Stopwatch.h>
 
 #ifdef OPENSIM_WITH_TROPTER
@@ -34,6 +35,20 @@ void MocoTropterSolver::constructProperties() {
     constructProperty_optim_jacobian_approximation("exact");
     constructProperty_optim_sparsity_detection("random");
     constructProperty_exact_hessian_block_sparsity_mode();
+    constructProperty_parallel();
+}
+
+int MocoTropterSolver::getNumThreads() const {
+    int parallel = 1;
+    const int parallelEV = getMocoParallelEnvironmentVariable();
+    if (getProperty_parallel().size()) {
+        parallel = get_parallel();
+    } else if (parallelEV != -1) {
+        parallel = parallelEV;
+    }
+    OPENSIM_THROW_IF_FRMOBJ(parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", parallel);
+    return getNumThreadsForParallel(parallel);
 }
 
 bool MocoTropterSolver::isAvailable() {
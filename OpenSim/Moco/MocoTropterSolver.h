@@ -58,6 +58,16 @@ property:
 - ipopt
 - snopt
 
+Parallelization
+===============
+By default, the differential-algebraic equations (dynamics and path
+constraints) are evaluated in parallel across collocation points, with each
+thread using its own copy of the model. As with MocoCasADiSolver, you can turn
+off or change the number of threads with the OPENSIM_MOCO_PARALLEL environment
+variable (see getMocoParallelEnvironmentVariable()) or the `parallel` property
+of this class, and custom model components must be threadsafe. Costs are
+evaluated serially.
+
 Using this solver in C++ requires that a tropter shared library is
 available, but tropter header files are not required. No tropter symbols
 are exposed in Moco's interface. */
@@ -84,6 +94,11 @@ public:
             "property must be set. Note: this option only takes effect when "
             "using "
             "IPOPT.");
+    OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
+            "Evaluate the differential-algebraic equations in parallel across "
+            "collocation points? 0: not parallel; 1: use all cores (default); "
+            "greater than 1: use this number of threads. This overrides the "
+            "OPENSIM_MOCO_PARALLEL environment variable.");
 
     MocoTropterSolver();
 
@@ -158,6 +173,11 @@ protected:
 
     MocoSolution solveImpl() const override;
 
+    /// The number of threads to use for evaluating the differential-algebraic
+    /// equations, based on the `parallel` property and the
+    /// OPENSIM_MOCO_PARALLEL environment variable.
+    int getNumThreads() const;
+
     /// Check that the provided guess is compatible with the problem and this
     /// solver.
     void checkGuess(const MocoTrajectory& guess) const;
@@ -64,12 +64,11 @@ class MocoProblem;
 /// @ingroup mocoutil
 template <typename T>
 TimeSeriesTable_<T> analyzeMocoTrajectory(
-        Model model, const MocoTrajectory& trajectory,
+        const Model& model, const MocoTrajectory& trajectory,
         const std::vector<std::string>& outputPaths) {
     const TimeSeriesTable statesTable = trajectory.exportToStatesTable();
     const TimeSeriesTable controlsTable = trajectory.exportToControlsTable();
-    return analyze<T>(
-            std::move(model), statesTable, controlsTable, outputPaths);
+    return analyze<T>(model, statesTable, controlsTable, outputPaths);
 }
 
 /// Given a MocoTrajectory and the associated OpenSim model, return the model
@@ -22,6 +22,7 @@
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Actuators/PointActuator.h>
+#include <OpenSim/Moco/MocoGoal/MocoReferenceCache.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
@@ -571,6 +572,111 @@ TEST_CASE("Test MocoSumSquaredStateGoal") {
     CHECK_THROWS(goal6->initializeOnModel(model));
 }
 
+TEST_CASE("Tracking goal reference cache") {
+    Model model = ModelFactory::createDoublePendulum();
+    SimTK::State state = model.initSystem();
+    state.updY() = 0;
+    const std::vector<std::string> labels{
+            model.getCoordinateSet().get("q0").getAbsolutePathString() +
+                    "/value",
+            model.getCoordinateSet().get("q1").getAbsolutePathString() +
+                    "/value"};
+    auto createReference = [&](double amplitude) {
+        TimeSeriesTable table;
+        table.setColumnLabels(labels);
+        for (int i = 0; i <= 20; ++i) {
+            const double time = 0.05 * i;
+            SimTK::RowVector row(2);
+            row[0] = amplitude * std::sin(3 * time);
+            row[1] = amplitude * std::cos(2 * time);
+            table.appendRow(time, row);
+        }
+        return table;
+    };
+    std::vector<double> coarseMesh;
+    for (int i = 0; i <= 10; ++i) coarseMesh.push_back(0.1 * i);
+    // Mesh refinement keeps the old mesh points and adds new ones.
+    std::vector<double> refinedMesh;
+    for (int i = 0; i <= 20; ++i) refinedMesh.push_back(0.05 * i);
+
+    SECTION("MocoReferenceCache") {
+        auto checkValues = [](MocoReferenceCache& cache,
+                                   const GCVSplineSet& splines,
+                                   const std::vector<double>& times) {
+            // Solvers visit the same times on every iteration.
+            for (int pass = 0; pass < 2; ++pass) {
+                for (const double& time : times) {
+                    const double* values = cache.getValues(splines, time);
+                    SimTK::Vector timeVec(1, time);
+                    for (int i = 0; i < splines.getSize(); ++i) {
+                        CHECK(values[i] == splines[i].calcValue(timeVec));
+                    }
+                }
+            }
+        };
+        GCVSplineSet splines(createReference(1.0));
+        MocoReferenceCache cache;
+        checkValues(cache, splines, coarseMesh);
+        CHECK(cache.getNumTimes() == (int)coarseMesh.size());
+        checkValues(cache, splines, refinedMesh);
+        CHECK(cache.getNumTimes() ==
+                (int)(coarseMesh.size() + refinedMesh.size() / 2));
+
+        // After the splines change, clear() discards the old values.
+        GCVSplineSet newSplines(createReference(2.0));
+        cache.clear();
+        CHECK(cache.getNumTimes() == 0);
+        checkValues(cache, newSplines, coarseMesh);
+
+        // The cache does not grow beyond its maximum size.
+        cache.setMaxNumTimes(5);
+        checkValues(cache, newSplines, refinedMesh);
+        CHECK(cache.getNumTimes() <= 5);
+
+        // With a free final time, the splines are evaluated directly.
+        MocoProblemInfo problemInfo;
+        problemInfo.finalTimeIsFixed = false;
+        cache.initialize(problemInfo);
+        CHECK_FALSE(cache.getEnabled());
+        checkValues(cache, splines, coarseMesh);
+        CHECK(cache.getNumTimes() == 0);
+    }
+
+    SECTION("MocoStateTrackingGoal") {
+        auto checkIntegrand = [&](const MocoStateTrackingGoal& goal,
+                                      const TimeSeriesTable& reference,
+                                      const std::vector<double>& times) {
+            GCVSplineSet splines(reference);
+            for (int pass = 0; pass < 2; ++pass) {
+                for (const double& time : times) {
+                    SimTK::Vector timeVec(1, time);
+                    double expected = 0;
+                    for (int i = 0; i < splines.getSize(); ++i) {
+                        expected += SimTK::square(splines[i].calcValue(timeVec));
+                    }
+                    CHECK(goal.calcIntegrand({time, state, {}}) ==
+                            Approx(expected).margin(1e-12));
+                }
+            }
+        };
+        MocoStateTrackingGoal goal;
+        goal.setReference(TableProcessor(createReference(1.0)));
+        goal.initializeOnModel(model);
+        checkIntegrand(goal, createReference(1.0), coarseMesh);
+        checkIntegrand(goal, createReference(1.0), refinedMesh);
+
+        // Reinitializing with a new reference clears the cache.
+        goal.setReference(TableProcessor(createReference(2.0)));
+        goal.initializeOnModel(model);
+        checkIntegrand(goal, createReference(2.0), coarseMesh);
+
+        MocoProblemInfo problemInfo;
+        problemInfo.finalTimeIsFixed = false;
+        goal.initializeOnModel(model, problemInfo);
+        checkIntegrand(goal, createReference(2.0), refinedMesh);
+    }
+}
+
 class MocoPeriodicish : public MocoGoal {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoPeriodicish, MocoGoal);
 
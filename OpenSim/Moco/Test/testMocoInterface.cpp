@@ -22,10 +22,12 @@
 
 #include <OpenSim/Actuators/BodyActuator.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
 #include <OpenSim/Actuators/ModelFactory.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/SimbodyEngine/CoordinateCouplerConstraint.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 #include <OpenSim/Simulation/SimbodyEngine/ScapulothoracicJoint.h>
@@ -1739,6 +1741,159 @@ TEMPLATE_TEST_CASE("Sliding mass", "", MocoCasADiSolver,
     }
 }
 
+/// A muscle with activation dynamics and implicit tendon compliance dynamics
+/// holds a hanging mass, so the multibody system has auxiliary states and
+/// auxiliary derivatives as inputs.
+MocoStudy createHangingMuscleMocoStudy() {
+    Model model;
+    model.setName("hanging_muscle");
+    model.set_gravity(SimTK::Vec3(9.81, 0, 0));
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("height");
+    model.addComponent(joint);
+
+    auto* actu = new DeGrooteFregly2016Muscle();
+    actu->setName("muscle");
+    actu->set_max_isometric_force(100.0);
+    actu->set_optimal_fiber_length(0.1);
+    actu->set_tendon_slack_length(0.05);
+    actu->set_tendon_strain_at_one_norm_force(0.10);
+    actu->set_ignore_activation_dynamics(false);
+    actu->set_ignore_tendon_compliance(false);
+    actu->set_tendon_compliance_dynamics_mode("implicit");
+    actu->set_fiber_damping(0.01);
+    actu->set_max_contraction_velocity(10);
+    actu->set_pennation_angle_at_optimal(0);
+    actu->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+    actu->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+    model.addForce(actu);
+    model.finalizeConnections();
+
+    MocoStudy study;
+    study.setName("hanging_muscle");
+    study.set_write_solution("false");
+    MocoProblem& problem = study.updProblem();
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 0.5);
+    problem.setStateInfo("/joint/height/value", {0.14, 0.17}, 0.165, 0.155);
+    problem.setStateInfo("/joint/height/speed", {-10, 10}, 0, 0);
+    problem.setControlInfo("/forceset/muscle", {0.02, 1});
+    problem.addGoal<MocoInitialForceEquilibriumDGFGoal>();
+    problem.addGoal<MocoControlGoal>();
+
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(10);
+    solver.set_optim_convergence_tolerance(1e-4);
+    solver.set_optim_constraint_tolerance(1e-4);
+    solver.set_minimize_implicit_auxiliary_derivatives(true);
+    return study;
+}
+
+/// A point mass constrained to the line x = y, so the multibody system has
+/// Lagrange multipliers as inputs.
+MocoStudy createConstrainedPointMassMocoStudy() {
+    Model model = ModelFactory::createPlanarPointMass();
+    model.set_gravity(SimTK::Vec3(0));
+    auto* constraint = new CoordinateCouplerConstraint();
+    Array<std::string> names;
+    names.append("tx");
+    constraint->setIndependentCoordinateNames(names);
+    constraint->setDependentCoordinateName("ty");
+    constraint->setFunction(LinearFunction(1.0, 0.0));
+    model.addConstraint(constraint);
+    model.finalizeConnections();
+
+    MocoStudy study;
+    study.setName("constrained_point_mass");
+    study.set_write_solution("false");
+    MocoProblem& problem = study.updProblem();
+    problem.setModelAsCopy(model);
+    problem.setTimeBounds(0, 1);
+    problem.setStateInfo("/jointset/tx/tx/value", {-5, 5}, 0, 3);
+    problem.setStateInfo("/jointset/tx/tx/speed", {-5, 5}, 0, 0);
+    problem.addGoal<MocoControlGoal>();
+
+    auto& solver = study.initCasADiSolver();
+    solver.set_num_mesh_intervals(10);
+    solver.set_transcription_scheme("hermite-simpson");
+    solver.set_enforce_constraint_derivatives(true);
+    return study;
+}
+
+TEST_CASE("Stage-aware finite differences", "[casadi]") {
+    auto dynamicsMode = GENERATE(as<std::string>{}, "explicit", "implicit");
+    auto scheme = GENERATE(as<std::string>{}, "central", "forward");
+    // With sparsity detection, structurally independent inputs are perturbed
+    // together.
+    auto sparsityDetection = GENERATE(as<std::string>{}, "none", "random");
+    // The sliding mass only has coordinates, speeds, and controls. The muscle
+    // adds auxiliary states and derivatives, and the kinematic constraint
+    // adds multipliers (and makes coordinates and speeds go through
+    // applyInput()).
+    auto problem = GENERATE(as<std::string>{}, "sliding mass", "muscle",
+            "kinematic constraint");
+    CAPTURE(dynamicsMode, scheme, sparsityDetection, problem);
+    MocoStudy study = [&]() {
+        if (problem == "sliding mass") {
+            return createSlidingMassMocoStudy<MocoCasADiSolver>();
+        }
+        if (problem == "muscle") return createHangingMuscleMocoStudy();
+        return createConstrainedPointMassMocoStudy();
+    }();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_multibody_dynamics_mode(dynamicsMode);
+    solver.set_optim_finite_difference_scheme(scheme);
+    solver.set_optim_sparsity_detection(sparsityDetection);
+    MocoSolution expected = study.solve();
+    REQUIRE(expected.success());
+
+    solver.set_optim_stage_aware_finite_differences(true);
+    MocoSolution solution = study.solve();
+    CHECK(solution.success());
+    CHECK(solution.getFinalTime() ==
+            Approx(expected.getFinalTime()).margin(1e-4));
+    OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getStatesTrajectory(),
+            expected.getStatesTrajectory(), 1e-3);
+    OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getControlsTrajectory(),
+            expected.getControlsTrajectory(), 1e-2);
+    if (problem == "kinematic constraint") {
+        OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getMultipliersTrajectory(),
+                expected.getMultipliersTrajectory(), 1e-2);
+    }
+    if (problem == "muscle") {
+        OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getDerivativesTrajectory(),
+                expected.getDerivativesTrajectory(), 1e-2);
+    }
+}
+
+TEST_CASE("Thread pool grid evaluation backend", "[casadi]") {
+    auto transcriptionScheme =
+            GENERATE(as<std::string>{}, "trapezoidal", "hermite-simpson");
+    auto parallel = GENERATE(0, 2);
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_transcription_scheme(transcriptionScheme);
+    solver.set_parallel(parallel);
+    MocoSolution expected = study.solve();
+
+    solver.set_grid_evaluation_backend("threadpool");
+    MocoSolution solution = study.solve();
+    CHECK(solution.success());
+    CHECK(solution.getFinalTime() ==
+            Approx(expected.getFinalTime()).margin(1e-4));
+    OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getStatesTrajectory(),
+            expected.getStatesTrajectory(), 1e-3);
+    OpenSim_REQUIRE_MATRIX_ABSTOL(solution.getControlsTrajectory(),
+            expected.getControlsTrajectory(), 1e-2);
+
+    solver.set_grid_evaluation_backend("openmp");
+    CHECK_THROWS(study.solve());
+}
+
 TEMPLATE_TEST_CASE("Solving an empty MocoProblem", "",
         MocoCasADiSolver, MocoTropterSolver) {
     MocoStudy study;
@@ -46,6 +46,25 @@ inline tropter::FinalBounds convertBounds(const MocoFinalBounds& mb) {
 template <typename T>
 class MocoTropterSolver::TropterProblemBase : public tropter::Problem<T> {
 protected:
+    /// The MocoProblemRep (models and states) and working memory used to
+    /// evaluate the differential-algebraic equations on one thread.
+    struct Workspace {
+        const MocoProblemRep* rep = nullptr;
+        // Null for the first workspace, which uses the solver's
+        // MocoProblemRep.
+        std::unique_ptr<const MocoProblemRep> ownedRep;
+        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces;
+        SimTK::Vector constraintMobilityForces;
+        SimTK::Vector qdot;
+        SimTK::Vector qdotCorr;
+        // This is the output argument of
+        // SimbodyMatterSubsystem::calcConstraintAccelerationErrors(), and
+        // includes the acceleration-level holonomic, non-holonomic constraint
+        // errors and the acceleration-only constraint errors.
+        SimTK::Vector pvaerr;
+        SimTK::Vector residual;
+    };
+
     TropterProblemBase(const MocoTropterSolver& solver, bool implicit = false)
             : tropter::Problem<T>(solver.getProblemRep().getName()),
               m_mocoTropterSolver(solver),
@@ -58,6 +77,21 @@ protected:
                       m_mocoProbRep.updStateDisabledConstraints()),
               m_implicit(implicit) {
 
+        // Each thread evaluates the differential-algebraic equations with its
+        // own MocoProblemRep. The first workspace uses the solver's
+        // MocoProblemRep, which is also used for the costs.
+        const int numThreads = m_mocoTropterSolver.getNumThreads();
+        m_workspaces.resize(numThreads);
+        m_workspaces[0].rep = &m_mocoProbRep;
+        if (numThreads > 1) {
+            auto jar = m_mocoTropterSolver.createProblemRepJar(numThreads - 1);
+            for (int ithread = 1; ithread < numThreads; ++ithread) {
+                m_workspaces[ithread].ownedRep = jar->take();
+                m_workspaces[ithread].rep =
+                        m_workspaces[ithread].ownedRep.get();
+            }
+        }
+
         // It is sufficient to perform this check only on the original model.
         OPENSIM_THROW_IF(!m_modelBase.getMatterSubsystem().getUseEulerAngles(
                                  m_stateBase),
@@ -296,34 +330,37 @@ protected:
         }
     }
 
-    void setSimTKState(const tropter::Input<T>& in) const {
-        setSimTKState(in.time, in.states, in.controls, in.adjuncts, 0);
+    void setSimTKState(
+            Workspace& ws, const tropter::Input<T>& in) const {
+        setSimTKState(ws, in.time, in.states, in.controls, in.adjuncts, 0);
     }
     void setSimTKStateForCostInitial(
             const tropter::CostInput<T>& in) const {
-        setSimTKState(in.initial_time, in.initial_states, in.initial_controls,
-                in.initial_adjuncts, 0);
+        setSimTKState(m_workspaces[0], in.initial_time, in.initial_states,
+                in.initial_controls, in.initial_adjuncts, 0);
     }
     void setSimTKStateForCostFinal(
             const tropter::CostInput<T>& in) const {
-        setSimTKState(in.final_time, in.final_states, in.final_controls,
-                in.final_adjuncts, 1);
+        setSimTKState(m_workspaces[0], in.final_time, in.final_states,
+                in.final_controls, in.final_adjuncts, 1);
     }
     /// Use `stateDisConIndex` to specify which of the two
-    /// stateDisabledConstraints from MocoProblemRep to update.
-    void setSimTKState(const T& time,
+    /// stateDisabledConstraints from the workspace's MocoProblemRep to update.
+    void setSimTKState(Workspace& ws, const T& time,
             const Eigen::Ref<const tropter::VectorX<T>>& states,
             const Eigen::Ref<const tropter::VectorX<T>>& controls,
             const Eigen::Ref<const tropter::VectorX<T>>& adjuncts,
             int stateDisConIndex = 0) const {
 
-        auto& simTKStateBase = this->m_stateBase;
+        const MocoProblemRep& rep = *ws.rep;
+        auto& simTKStateBase = rep.updStateBase();
         auto& simTKStateDisabledConstraints =
-                m_mocoProbRep.updStateDisabledConstraints(stateDisConIndex);
-        auto& modelDisabledConstraints = this->m_modelDisabledConstraints;
+                rep.updStateDisabledConstraints(stateDisConIndex);
+        const auto& modelDisabledConstraints =
+                rep.getModelDisabledConstraints();
 
-        if (m_implicit && !m_mocoProbRep.isPrescribedKinematics()) {
-            const auto& accel = this->m_mocoProbRep.getAccelerationMotion();
+        if (m_implicit && !rep.isPrescribedKinematics()) {
+            const auto& accel = rep.getAccelerationMotion();
             const int NU = simTKStateDisabledConstraints.getNU();
             const auto& w = adjuncts.segment(
                     this->m_numKinematicConstraintEquations, NU);
@@ -339,7 +376,7 @@ protected:
             // constraints. The base model never gets realized past
             // Stage::Velocity, so we don't ever need to set its controls.
             auto& osimControls =
-                    m_mocoProbRep.getDiscreteControllerDisabledConstraints()
+                    rep.getDiscreteControllerDisabledConstraints()
                             .updDiscreteControls(simTKStateDisabledConstraints);
             for (int ic = 0; ic < controls.size(); ++ic) {
                 osimControls[m_modelControlIndices[ic]] = controls[ic];
@@ -351,8 +388,8 @@ protected:
         // discrete variables in the state.
         if (this->m_numKinematicConstraintEquations) {
             this->setSimTKTimeAndStates(time, states, simTKStateBase);
-            this->calcAndApplyKinematicConstraintForces(
-                    adjuncts, simTKStateBase, simTKStateDisabledConstraints);
+            this->calcAndApplyKinematicConstraintForces(ws, adjuncts,
+                    simTKStateBase, simTKStateDisabledConstraints);
         }
     }
 
@@ -373,7 +410,7 @@ protected:
         // Update the state.
         // TODO would it make sense to a vector of States, one for each mesh
         // point, so that each can preserve their cache?
-        this->setSimTKState(in);
+        this->setSimTKState(m_workspaces[0], in);
 
         const auto& discreteController =
                 m_mocoProbRep.getDiscreteControllerDisabledConstraints();
@@ -431,10 +468,8 @@ protected:
     std::vector<std::string> m_svNamesInSysOrder;
     std::unordered_map<int, int> m_yIndexMap;
     std::vector<int> m_modelControlIndices;
-    mutable SimTK::Vector_<SimTK::SpatialVec> m_constraintBodyForces;
-    mutable SimTK::Vector m_constraintMobilityForces;
-    mutable SimTK::Vector qdot;
-    mutable SimTK::Vector qdotCorr;
+    // One workspace per thread; see calcDifferentialAlgebraicEquations().
+    mutable std::vector<Workspace> m_workspaces;
     // The total number of scalar holonomic, non-holonomic, and acceleration
     // constraint equations enabled in the model. This does not count equations
     // for derivatives of holonomic and non-holonomic constraints.
@@ -443,11 +478,6 @@ protected:
     mutable int m_total_ma = 0;
     // This is the sum of m_total_m(p|v|a).
     mutable int m_numMultipliers = 0;
-    // This is the output argument of
-    // SimbodyMatterSubsystem::calcConstraintAccelerationErrors(), and includes
-    // the acceleration-level holonomic, non-holonomic constraint errors and the
-    // acceleration-only constraint errors.
-    mutable SimTK::Vector m_pvaerr;
     // The total number of scalar constraint equations associated with model
     // kinematic constraints that the solver is responsible for enforcing. This
     // number does include equations for constraint derivatives.
@@ -456,8 +486,8 @@ protected:
     // MocoPathConstraints added to the MocoProblem.
     mutable int m_numPathConstraintEquations = 0;
 
-    /// Apply parameters to properties in `m_modelBase` and
-    /// `m_modelDisabledConstraints`.
+    /// Apply parameters to properties in the base model and the model with
+    /// disabled constraints of every workspace.
     void applyParametersToModelProperties(
             const tropter::VectorX<T>& parameters) const {
         if (parameters.size()) {
@@ -466,34 +496,39 @@ protected:
             SimTK::Vector mocoParams(
                     (int)parameters.size(), parameters.data(), true);
 
-            m_mocoProbRep.applyParametersToModelProperties(mocoParams, true);
+            for (const auto& ws : m_workspaces) {
+                ws.rep->applyParametersToModelProperties(mocoParams, true);
+            }
         }
     }
 
-    void calcAndApplyKinematicConstraintForces(
-            const tropter::VectorX<T>& adjuncts, const SimTK::State& stateBase,
+    void calcAndApplyKinematicConstraintForces(Workspace& ws,
+            const Eigen::Ref<const tropter::VectorX<T>>& adjuncts,
+            const SimTK::State& stateBase,
             SimTK::State& stateDisabledConstraints) const {
         // Calculate the constraint forces using the original model and the
         // solver-provided Lagrange multipliers.
-        m_modelBase.realizeVelocity(stateBase);
-        const auto& matter = m_modelBase.getMatterSubsystem();
+        const auto& modelBase = ws.rep->getModelBase();
+        modelBase.realizeVelocity(stateBase);
+        const auto& matter = modelBase.getMatterSubsystem();
         // Multipliers are negated so constraint forces can be used like
         // applied forces.
         SimTK::Vector multipliers(m_numMultipliers, adjuncts.data(), true);
         matter.calcConstraintForcesFromMultipliers(stateBase, -multipliers,
-                m_constraintBodyForces, m_constraintMobilityForces);
+                ws.constraintBodyForces, ws.constraintMobilityForces);
         // Apply the constraint forces on the model with disabled constraints.
-        const auto& constraintForces = m_mocoProbRep.getConstraintForces();
+        const auto& constraintForces = ws.rep->getConstraintForces();
         constraintForces.setAllForces(stateDisabledConstraints,
-                m_constraintMobilityForces, m_constraintBodyForces);
+                ws.constraintMobilityForces, ws.constraintBodyForces);
     }
 
-    void calcKinematicConstraintErrors(
+    void calcKinematicConstraintErrors(Workspace& ws,
             const SimTK::Vector& udot, tropter::Output<T>& out) const {
         // Only compute constraint errors if we're at a time point where path
         // constraints in the optimal control problem are enforced.
         if (out.path.size() != 0 && this->m_numKinematicConstraintEquations) {
-            auto& stateBase = this->m_stateBase;
+            const auto& stateBase = ws.rep->updStateBase();
+            auto& pvaerr = ws.pvaerr;
 
             // Position-level errors.
             std::copy_n(stateBase.getQErr().getContiguousScalarData(),
@@ -508,11 +543,12 @@ protected:
                 // the udot computed from the model with disabled constraints
                 // since we cannot use (nor do we have available) udot computed
                 // from the original model.
-                const auto& matterBase = m_modelBase.getMatterSubsystem();
+                const auto& matterBase =
+                        ws.rep->getModelBase().getMatterSubsystem();
                 matterBase.calcConstraintAccelerationErrors(
-                        stateBase, udot, m_pvaerr);
+                        stateBase, udot, pvaerr);
             } else {
-                m_pvaerr = SimTK::NaN;
+                pvaerr = SimTK::NaN;
             }
 
             if (enforceConstraintDerivatives) {
@@ -520,7 +556,7 @@ protected:
                 std::copy_n(stateBase.getUErr().getContiguousScalarData(),
                         m_total_mp + m_total_mv, out.path.data() + m_total_mp);
                 // Acceleration-level errors.
-                std::copy_n(m_pvaerr.getContiguousScalarData(),
+                std::copy_n(pvaerr.getContiguousScalarData(),
                         m_total_mp + m_total_mv + m_total_ma,
                         out.path.data() + 2 * m_total_mp + m_total_mv);
             } else {
@@ -531,24 +567,43 @@ protected:
                         m_total_mv, out.path.data() + m_total_mp);
                 // Acceleration-level errors. Skip derivatives of velocity-
                 // and position-level constraint equations.
-                std::copy_n(m_pvaerr.getContiguousScalarData() + m_total_mp +
+                std::copy_n(pvaerr.getContiguousScalarData() + m_total_mp +
                                     m_total_mv,
                         m_total_ma, out.path.data() + m_total_mp + m_total_mv);
             }
         }
     }
 
-    void calcPathConstraintErrors(
+    void calcPathConstraintErrors(const Workspace& ws,
             const SimTK::State& state, tropter::Output<T>& out) const {
         if (out.path.size() != 0) {
             // Copy errors from generic path constraints into output struct.
             SimTK::Vector pathConstraintErrors(
                     this->m_numPathConstraintEquations,
                     out.path.data() + m_numKinematicConstraintEquations, true);
-            m_mocoProbRep.calcPathConstraintErrors(state, pathConstraintErrors);
+            ws.rep->calcPathConstraintErrors(state, pathConstraintErrors);
         }
     }
 
+    int get_num_threads() const override { return (int)m_workspaces.size(); }
+
+    void calc_differential_algebraic_equations(const tropter::Input<T>& in,
+            tropter::Output<T> out) const override final {
+        calcDifferentialAlgebraicEquations(m_workspaces[0], in, out);
+    }
+
+    void calc_differential_algebraic_equations_in_thread(int threadIndex,
+            const tropter::Input<T>& in,
+            tropter::Output<T> out) const override final {
+        calcDifferentialAlgebraicEquations(m_workspaces[threadIndex], in, out);
+    }
+
+    /// Compute the differential-algebraic equations using only the models,
+    /// states, and working memory of the provided workspace, so that calls
+    /// with different workspaces can run concurrently.
+    virtual void calcDifferentialAlgebraicEquations(Workspace& ws,
+            const tropter::Input<T>& in, tropter::Output<T>& out) const = 0;
+
 public:
     template <typename MocoTrajectoryType, typename tropIterateType>
     MocoTrajectoryType convertIterateTropterToMoco(
@@ -570,23 +625,27 @@ public:
     ExplicitTropterProblem(const MocoTropterSolver& solver)
             : MocoTropterSolver::TropterProblemBase<T>(solver) {}
     void initialize_on_mesh(const Eigen::VectorXd&) const override {}
-    void calc_differential_algebraic_equations(const tropter::Input<T>& in,
-            tropter::Output<T> out) const override {
+    void calcDifferentialAlgebraicEquations(
+            typename TropterProblemBase<T>::Workspace& ws,
+            const tropter::Input<T>& in,
+            tropter::Output<T>& out) const override {
         // Unpack variables.
         const auto& diffuses = in.diffuses;
 
         // Original model and its associated state. These are used to calculate
         // kinematic constraint forces and errors.
-        const auto& modelBase = this->m_modelBase;
-        auto& simTKStateBase = this->m_stateBase;
+        const auto& modelBase = ws.rep->getModelBase();
+        auto& simTKStateBase = ws.rep->updStateBase();
 
         // Model with disabled constraints and its associated state. These are
         // used to compute the accelerations.
-        const auto& modelDisabledConstraints = this->m_modelDisabledConstraints;
-        auto& simTKStateDisabledConstraints = this->m_stateDisabledConstraints;
+        const auto& modelDisabledConstraints =
+                ws.rep->getModelDisabledConstraints();
+        auto& simTKStateDisabledConstraints =
+                ws.rep->updStateDisabledConstraints();
 
         // Update the state.
-        this->setSimTKState(in);
+        this->setSimTKState(ws, in);
 
         // Compute the accelerations.
         // TODO Antoine and Gil said realizing Dynamics is a lot costlier
@@ -596,7 +655,7 @@ public:
 
         // Compute kinematic constraint errors if they exist.
         this->calcKinematicConstraintErrors(
-                simTKStateDisabledConstraints.getUDot(), out);
+                ws, simTKStateDisabledConstraints.getUDot(), out);
 
         // Apply velocity correction to qdot if at a mesh interval midpoint.
         // This correction modifies the dynamics to enable a projection of
@@ -608,31 +667,31 @@ public:
         if (diffuses.size() != 0) {
             SimTK::Vector gamma((int)diffuses.size(), diffuses.data());
             const auto& matter = modelBase.getMatterSubsystem();
-            matter.multiplyByGTranspose(simTKStateBase, gamma, this->qdotCorr);
+            matter.multiplyByGTranspose(simTKStateBase, gamma, ws.qdotCorr);
             // It doesn't matter what state we use for U since it's U is the
             // same in both states.
-            this->qdot = simTKStateDisabledConstraints.getU() + this->qdotCorr;
+            ws.qdot = simTKStateDisabledConstraints.getU() + ws.qdotCorr;
         } else {
-            this->qdot = simTKStateDisabledConstraints.getU();
+            ws.qdot = simTKStateDisabledConstraints.getU();
         }
 
         // Copy state derivative values to output struct. We cannot simply
         // use getYDot() because we may have applied a velocity correction to
         // qdot.
-        const int nq = this->qdot.size();
+        const int nq = ws.qdot.size();
         const auto& udot = simTKStateDisabledConstraints.getUDot();
         const auto& zdot = simTKStateDisabledConstraints.getZDot();
         const int nu = udot.size();
         const int nz = zdot.size();
         std::copy_n(
-                this->qdot.getContiguousScalarData(), nq, out.dynamics.data());
+                ws.qdot.getContiguousScalarData(), nq, out.dynamics.data());
         std::copy_n(
                 udot.getContiguousScalarData(), nu, out.dynamics.data() + nq);
         std::copy_n(zdot.getContiguousScalarData(), nz,
                 out.dynamics.data() + nq + nu);
 
         // Path constraint errors.
-        this->calcPathConstraintErrors(simTKStateDisabledConstraints, out);
+        this->calcPathConstraintErrors(ws, simTKStateDisabledConstraints, out);
     }
 };
 
@@ -648,8 +707,10 @@ public:
 
         auto& simTKStateDisabledConstraints = this->m_stateDisabledConstraints;
         if (!this->m_mocoProbRep.isPrescribedKinematics()) {
-            const auto& accel = this->m_mocoProbRep.getAccelerationMotion();
-            accel.setEnabled(simTKStateDisabledConstraints, true);
+            for (const auto& ws : this->m_workspaces) {
+                const auto& accel = ws.rep->getAccelerationMotion();
+                accel.setEnabled(ws.rep->updStateDisabledConstraints(), true);
+            }
         }
 
         // Add adjuncts for udot, which we call "w".
@@ -666,14 +727,18 @@ public:
             this->add_path_constraint(name.substr(0, leafpos) + "residual", 0);
         }
     }
-    void calc_differential_algebraic_equations(const tropter::Input<T>& in,
-            tropter::Output<T> out) const override {
+    void calcDifferentialAlgebraicEquations(
+            typename TropterProblemBase<T>::Workspace& ws,
+            const tropter::Input<T>& in,
+            tropter::Output<T>& out) const override {
 
         const auto& states = in.states;
         const auto& adjuncts = in.adjuncts;
 
-        const auto& modelDisabledConstraints = this->m_modelDisabledConstraints;
-        auto& simTKStateDisabledConstraints = this->m_stateDisabledConstraints;
+        const auto& modelDisabledConstraints =
+                ws.rep->getModelDisabledConstraints();
+        auto& simTKStateDisabledConstraints =
+                ws.rep->updStateDisabledConstraints();
 
         const int numEmptySlots =
                 simTKStateDisabledConstraints.getNY() - (int)states.size();
@@ -698,11 +763,11 @@ public:
 
         // Multibody dynamics: "F - ma = 0"
         // --------------------------------
-        this->setSimTKState(in);
+        this->setSimTKState(ws, in);
 
         // TODO: Update to support kinematic constraints, using
         // this->calcKinematicConstraintForces()
-        this->calcPathConstraintErrors(simTKStateDisabledConstraints, out);
+        this->calcPathConstraintErrors(ws, simTKStateDisabledConstraints, out);
 
         if (NZ || out.path.size()) {
             modelDisabledConstraints.realizeAcceleration(
@@ -716,20 +781,17 @@ public:
         }
 
         if (out.path.size() != 0) {
-            const auto& matter =
-                    this->m_modelDisabledConstraints.getMatterSubsystem();
-            matter.findMotionForces(simTKStateDisabledConstraints, m_residual);
+            const auto& matter = modelDisabledConstraints.getMatterSubsystem();
+            auto& residual = ws.residual;
+            matter.findMotionForces(simTKStateDisabledConstraints, residual);
 
             double* residualBegin = out.path.data() +
                                     this->m_numKinematicConstraintEquations +
                                     this->m_numPathConstraintEquations;
-            std::copy_n(m_residual.getContiguousScalarData(), m_residual.size(),
+            std::copy_n(residual.getContiguousScalarData(), residual.size(),
                     residualBegin);
         }
     }
-
-private:
-    mutable SimTK::Vector m_residual;
 };
 
 } // namespace OpenSim
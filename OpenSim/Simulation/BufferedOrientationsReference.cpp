@@ -41,34 +41,38 @@ void BufferedOrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
     auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
 
     if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
+        _nextRow = _orientationData.getRow(time);
     } else {
-        _orientationDataQueue.pop_front(time, nextRow);
+        _orientationDataQueue.pop_front(time, _nextRow);
     }
-    int n = nextRow.size();
+    int n = _nextRow.size();
     values.resize(n);
 
     for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
+        values[i] = _nextRow[i];
     }
 }
 
 void BufferedOrientationsReference::getNextValuesAndTime(
         double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(time, nextRow);
-    int n = nextRow.size();
+    _orientationDataQueue.pop_front(time, _nextRow);
+    int n = _nextRow.size();
     values.resize(n);
 
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
+    for (int i = 0; i < n; ++i) { values[i] = _nextRow[i]; }
 }
 
 void BufferedOrientationsReference::putValues(
         double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow) {
     _orientationDataQueue.push_back(time, dataRow);
 }
+
+void BufferedOrientationsReference::setDataQueueCapacity(
+        size_t capacity, DataQueueOverflowPolicy policy) {
+    _orientationDataQueue = DataQueue_<SimTK::Rotation>(capacity, policy,
+            static_cast<int>(_orientationData.getNumColumns()));
+}
 } // end of namespace OpenSim
\ No newline at end of file
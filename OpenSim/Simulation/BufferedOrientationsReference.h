@@ -89,9 +89,29 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Replace the queue of live data with an empty queue that holds at most
+    `capacity` rows and handles overflow according to `policy`, or with an
+    unbounded queue if `capacity` is 0. Call this before putting values. By
+    default, the queue is unbounded, so putValues() never waits for the
+    solver and no rows are dropped.                                          */
+    void setDataQueueCapacity(size_t capacity,
+            DataQueueOverflowPolicy policy =
+                    DataQueueOverflowPolicy::Backpressure);
+
+#ifndef SWIG
+    /** Access the queue of live data, e.g., to check how many frames were
+    dropped or arrived late.                                                 */
+    const DataQueue_<SimTK::Rotation>& getDataQueue() const {
+        return _orientationDataQueue;
+    }
+#endif
+
 private:
     // Use a specialized data structure for holding the orientation data
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Reused buffer for the rows popped from the queue.
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
@@ -78,6 +78,7 @@ void TrackingController::setNull()
 void TrackingController::setDesiredStatesStorage(const Storage* aYDesStore)
 {
     _desiredStatesStorage = aYDesStore;
+    _desiredStatesCursor.setStorage(aYDesStore);
 }
 
 const Storage& TrackingController:: getDesiredStatesStorage() const
@@ -85,3 +86,12 @@ const Storage& TrackingController:: getDesiredStatesStorage() const
     return *_desiredStatesStorage;
 }
 
+const StorageCursor& TrackingController::getDesiredStatesCursor() const
+{
+    // Copies of this controller do not keep the desired states storage.
+    OPENSIM_THROW_IF_FRMOBJ(
+            _desiredStatesCursor.getStorage() != _desiredStatesStorage.get(),
+            Exception, "The desired states storage has not been set.");
+    return _desiredStatesCursor;
+}
+
@@ -31,6 +31,7 @@
 // INCLUDE
 //============================================================================
 #include "Controller.h"
+#include <OpenSim/Common/StorageCursor.h>
 
 //=============================================================================
 //=============================================================================
@@ -88,6 +89,10 @@ public:
      */
     virtual void setDesiredStatesStorage(const Storage* aYDesStore);
     virtual const Storage& getDesiredStatesStorage() const; 
+    /** A cursor for interpolating the desired states storage, for use in
+    computeControls() (the Storage's own getDataAtTime() is not
+    thread-safe). */
+    const StorageCursor& getDesiredStatesCursor() const;
 
     // ON/OFF
 
@@ -121,6 +126,7 @@ private:
      *   storage object containing the desired trajectory
      */
     mutable SimTK::ReferencePtr<const Storage> _desiredStatesStorage;
+    StorageCursor _desiredStatesCursor;
 
 
     friend class ControllerSet;
@@ -23,6 +23,7 @@
 
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/FunctionSet.h>
 
 using namespace std;
@@ -195,4 +196,52 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 }
 
+void InverseDynamicsSolver::solve(const SimTK::State& s, const Vector& times,
+        const Matrix& q, const Matrix& u, const Matrix& udot,
+        Matrix& genForceTrajectory, int parallel) {
+    const int nt = times.size();
+    const int nq = s.getNQ();
+    const int nu = s.getNU();
+    OPENSIM_THROW_IF(q.nrow() != nt || q.ncol() != nq, Exception,
+            "Expected q to be {} x {}, but it is {} x {}.", nt, nq, q.nrow(),
+            q.ncol());
+    OPENSIM_THROW_IF(u.nrow() != nt || u.ncol() != nu, Exception,
+            "Expected u to be {} x {}, but it is {} x {}.", nt, nu, u.nrow(),
+            u.ncol());
+    OPENSIM_THROW_IF(udot.nrow() != nt || udot.ncol() != nu, Exception,
+            "Expected udot to be {} x {}, but it is {} x {}.", nt, nu,
+            udot.nrow(), udot.ncol());
+
+    if (genForceTrajectory.nrow() != nt || genForceTrajectory.ncol() != nu) {
+        genForceTrajectory.resize(nt, nu);
+    }
+
+    // Each thread copies the State, which only pays off if the thread has
+    // enough frames to solve.
+    const int minFramesPerThread = 20;
+    const int numThreads =
+            getNumThreadsForParallel(parallel, nt, minFramesPerThread);
+
+    const MultibodySystem& system = getModel().getMultibodySystem();
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    runInContiguousChunks(nt, numThreads, [&](int, int begin, int end) {
+        // The workspaces are reused for all of this thread's frames.
+        State state(s);
+        Vector knownUdots(nu);
+        Vector residualMobilityForces(nu);
+        for (int i = begin; i < end; ++i) {
+            state.updTime() = times[i];
+            state.updQ() = ~q[i];
+            state.updU() = ~u[i];
+            knownUdots = ~udot[i];
+            system.realize(state, Stage::Dynamics);
+            matter.calcResidualForceIgnoringConstraints(state,
+                    system.getMobilityForces(state, Stage::Dynamics),
+                    system.getRigidBodyForces(state, Stage::Dynamics),
+                    knownUdots, residualMobilityForces);
+            genForceTrajectory[i] = ~residualMobilityForces;
+        }
+    });
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
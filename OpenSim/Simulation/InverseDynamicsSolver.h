@@ -103,6 +103,28 @@ public:
                                 const std::vector<int>& coordinatesToSpeedsIndexMap,
                                 double time);
 
+    /** Solve the inverse dynamics system of equations for a trajectory.
+        Row i of q (nt x nq), u (nt x nu), and udot (nt x nu) holds the
+        coordinates, speeds, and generalized accelerations at times[i], in
+        the order of the State's q's and u's. Applied loads are computed by
+        the model as in solve(const SimTK::State&, const SimTK::Vector&), with
+        all other state variables (and which forces are disabled) taken from
+        the provided state, which is not modified. Row i of
+        genForceTrajectory (resized to nt x nu if necessary) is set to the
+        generalized forces at times[i]. The model's analyses are not
+        stepped.
+
+        Consecutive blocks of times can be solved concurrently, each with its
+        own copy of the State, which requires that the forces in the model
+        can be computed for different States at the same time (as is the case
+        for the forces in OpenSim). Set parallel to 0 to solve serially, 1 to
+        use all cores, or N > 1 to use N threads. Fewer threads are used for
+        short trajectories. */
+    void solve(const SimTK::State& s, const SimTK::Vector& times,
+            const SimTK::Matrix& q, const SimTK::Matrix& u,
+            const SimTK::Matrix& udot, SimTK::Matrix& genForceTrajectory,
+            int parallel = 0);
+
 #ifndef SWIG
     /** Same as above but for a given time series populate an Array (trajectory)
         of generalized-coordinate forces (Vector). Coordinate functions must be
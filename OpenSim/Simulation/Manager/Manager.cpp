@@ -31,6 +31,9 @@
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
 
+#include <algorithm>
+#include <cmath>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -64,6 +67,7 @@ Manager::Manager(Model& model, bool dummyVar) :
        _model(&model),
        _performAnalyses(true),
        _writeToStorage(true),
+       _writeToTable(false),
        _controllerSet(&model.updControllerSet())
 {
     setNull();
@@ -97,6 +101,7 @@ setNull()
     _dt = 1.0e-4;
     _performAnalyses=true;
     _writeToStorage=true;
+    _writeToTable=false;
     _tArray.setSize(0);
     _dtArray.setSize(0);
 }
@@ -626,7 +631,27 @@ getStateStorage() const
 }
 
 TimeSeriesTable Manager::getStatesTable() const {
-    return getStateStorage().exportToTable();
+    if (!_writeToTable) return getStateStorage().exportToTable();
+
+    const int nrow = (int)_statesTableTimes.size();
+    std::vector<std::string> labels;
+    const Array<std::string> stateNames = _model->getStateVariableNames();
+    for (int i = 0; i < stateNames.getSize(); ++i)
+        labels.push_back(stateNames[i]);
+    TimeSeriesTable table(_statesTableTimes,
+            _statesTableBuffer.block(0, 0, nrow, _statesTableBuffer.ncol()),
+            labels);
+    table.addTableMetaData("header", std::string("states"));
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("nRows", std::to_string(nrow));
+    table.addTableMetaData("nColumns", std::to_string(labels.size() + 1));
+    return table;
+}
+
+void Manager::setWriteToTable(bool writeToTable)
+{
+    _writeToTable = writeToTable;
+    if (_writeToTable) _writeToStorage = false;
 }
 
 //_____________________________________________________________________________
@@ -690,6 +715,8 @@ const SimTK::State& Manager::integrate(double finalTime)
     bool fixedStep = false;
     if (_constantDT || _specifiedDT) fixedStep = true;
 
+    if (_writeToTable) reserveStatesTable(initialTime, finalTime);
+
     auto status = SimTK::Integrator::InvalidSuccessfulStepStatus;
 
     if (!fixedStep) {
@@ -798,6 +825,35 @@ void Manager::initializeStorageAndAnalyses(const SimTK::State& s)
 
     record(s, 0);
 }
+//_____________________________________________________________________________
+/**
+ * Reserve the rows of the states table buffer for an integration from
+ * initialTime to finalTime. The number of rows is only known in advance for
+ * constant or specified time steps; otherwise, record() grows the buffer.
+ */
+void Manager::reserveStatesTable(double initialTime, double finalTime)
+{
+    int numSteps = 0;
+    if (_specifiedDT) {
+        for (int i = 0; i < _tArray.getSize(); ++i) {
+            if (_tArray[i] > initialTime && _tArray[i] <= finalTime)
+                ++numSteps;
+        }
+    } else if (_constantDT) {
+        numSteps = (int)std::ceil((finalTime - initialTime) / _dt);
+    }
+    // Include the initial and final records.
+    const int numRows = (int)_statesTableTimes.size() + numSteps + 2;
+    const int nsv = _model->getNumStateVariables();
+    if (_statesTableBuffer.ncol() != nsv) {
+        _statesTableBuffer.resize(numRows, nsv);
+        _statesTableTimes.clear();
+    } else if (numRows > _statesTableBuffer.nrow()) {
+        _statesTableBuffer.resizeKeep(numRows, nsv);
+    }
+    _statesTableTimes.reserve(_statesTableBuffer.nrow());
+}
+
 //_____________________________________________________________________________
 /**
 * Set and initialize a SimTK::TimeStepper
@@ -852,6 +908,27 @@ void Manager::record(const SimTK::State& s, const int& step)
             _controllerSet->storeControls(s,
                 (step < 0) ? getStateStorage().getSize() : step);
     }
+    if (_writeToTable) {
+        _model->getStateVariableValues(s, _stateValues);
+        const int nsv = _stateValues.size();
+        if (_statesTableBuffer.ncol() != nsv) {
+            _statesTableBuffer.resize(0, nsv);
+            _statesTableTimes.clear();
+        }
+        // As in Storage::append(), a state at the same time as the previous
+        // one replaces it.
+        int row = (int)_statesTableTimes.size();
+        if (row > 0 && _statesTableTimes.back() == s.getTime()) {
+            --row;
+        } else {
+            if (row == _statesTableBuffer.nrow()) {
+                _statesTableBuffer.resizeKeep(std::max(2 * row, 16), nsv);
+            }
+            _statesTableTimes.push_back(s.getTime());
+        }
+        for (int i = 0; i < nsv; ++i)
+            _statesTableBuffer.updElt(row, i) = _stateValues[i];
+    }
 }
 
 //=============================================================================
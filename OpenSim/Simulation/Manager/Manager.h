@@ -115,6 +115,17 @@ private:
     /** flag indicating if manager should write to storage  each step */
     bool _writeToStorage;
 
+    /** flag indicating if manager should write to the states table buffer
+    each step */
+    bool _writeToTable;
+    /** Buffer of state variable values (one row per recorded time). Rows
+    beyond the number of recorded times are reserved capacity. */
+    SimTK::Matrix _statesTableBuffer;
+    /** Times of the rows recorded in _statesTableBuffer. */
+    std::vector<double> _statesTableTimes;
+    /** Reused to get the state variable values without allocating. */
+    SimTK::Vector _stateValues;
+
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
@@ -162,6 +173,15 @@ public:
     { _performAnalyses =  performAnalyses; }
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
+    /** Record the states at each step into a buffer that getStatesTable()
+    converts to a TimeSeriesTable, instead of into the state Storage. The
+    buffer is sized from the final time when a constant or specified time
+    step is used (and grows geometrically otherwise), and recording a step
+    does not allocate memory. Enabling this also disables writing to the
+    state Storage; call setWriteToStorage(true) afterwards if a legacy
+    analysis needs the Storage as well. Call this before integrate(). */
+    void setWriteToTable(bool writeToTable);
+    bool getWriteToTable() const { return _writeToTable; }
 
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
@@ -342,6 +362,9 @@ public:
     ownership of the passed-in Storage. */
     void setStateStorage(Storage& aStorage);
     Storage& getStateStorage() const;
+    /** Get the recorded states. If setWriteToTable(true) was called, the
+    table is created from the states table buffer; otherwise, it is exported
+    from the state Storage. */
     TimeSeriesTable getStatesTable() const;
 
    //--------------------------------------------------------------------------
@@ -358,6 +381,9 @@ private:
 
     // Helper functions during initialization of integration
     void initializeStorageAndAnalyses(const SimTK::State& s);
+    // Reserve rows in the states table buffer for integrating up to
+    // finalTime, if the number of steps is known in advance.
+    void reserveStatesTable(double initialTime, double finalTime);
 
     // Helper to record state and analysis values at integration steps.
     // step = 0 is the beginning, step = -1 used to denote the end/final step
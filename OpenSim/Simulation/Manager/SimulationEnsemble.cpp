@@ -0,0 +1,276 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  SimulationEnsemble.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimulationEnsemble.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/ComponentOutput.h>
+#include <OpenSim/Common/ComponentSocket.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/AnalysisSet.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <simbody/internal/Integrator.h>
+
+using namespace OpenSim;
+
+/// Each worker thread simulates with its own copy of the model.
+struct SimulationEnsemble::Worker {
+    std::unique_ptr<Model> model;
+    SimTK::State defaultState;
+    std::vector<SimTK::ReferencePtr<const Output<double>>> outputs;
+    SimTK::Stage outputStage = SimTK::Stage::Time;
+};
+
+SimulationEnsemble::SimulationEnsemble(const Model& model)
+        : m_model(model.clone()) {}
+
+SimulationEnsemble::~SimulationEnsemble() = default;
+
+void SimulationEnsemble::setParallel(int parallel) {
+    OPENSIM_THROW_IF(parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", parallel);
+    m_parallel = parallel;
+}
+
+void SimulationEnsemble::setReportingInterval(double interval) {
+    OPENSIM_THROW_IF(interval < 0, Exception,
+            "Expected the reporting interval to be non-negative, but got {}.",
+            interval);
+    m_reportingInterval = interval;
+}
+
+void SimulationEnsemble::addOutput(const std::string& outputPath) {
+    OPENSIM_THROW_IF(std::find(m_outputPaths.begin(), m_outputPaths.end(),
+                             outputPath) != m_outputPaths.end(),
+            Exception, "Output '{}' was already added.", outputPath);
+    m_outputPaths.push_back(outputPath);
+}
+
+int SimulationEnsemble::getNumFailedRuns() const {
+    return (int)std::count_if(m_results.begin(), m_results.end(),
+            [](const RunResult& result) {
+                return result.status == RunStatus::Failed;
+            });
+}
+
+int SimulationEnsemble::getNumThreads() const {
+    return getNumThreadsForParallel(m_parallel);
+}
+
+std::vector<double> SimulationEnsemble::createReportingTimes(
+        double initialTime, double finalTime) const {
+    std::vector<double> times{initialTime};
+    if (m_reportingInterval > 0) {
+        // Skip a reporting time that would be within roundoff of the final
+        // time so that the time column stays strictly increasing.
+        const double tol = 1e-10 * m_reportingInterval;
+        for (int k = 1;; ++k) {
+            const double time = initialTime + k * m_reportingInterval;
+            if (time >= finalTime - tol) break;
+            times.push_back(time);
+        }
+    }
+    times.push_back(finalTime);
+    return times;
+}
+
+const std::vector<SimulationEnsemble::RunResult>& SimulationEnsemble::run(
+        const std::vector<SimTK::State>& initialStates, double finalTime) {
+    return runImpl(
+            [&](int irun) -> const SimTK::State& {
+                return initialStates[irun];
+            },
+            (int)initialStates.size(), finalTime);
+}
+
+const std::vector<SimulationEnsemble::RunResult>& SimulationEnsemble::run(
+        const SimTK::State& initialState, int numRuns, double finalTime) {
+    OPENSIM_THROW_IF(numRuns < 0, Exception,
+            "Expected numRuns to be non-negative, but got {}.", numRuns);
+    return runImpl(
+            [&](int) -> const SimTK::State& { return initialState; },
+            numRuns, finalTime);
+}
+
+const std::vector<SimulationEnsemble::RunResult>& SimulationEnsemble::runImpl(
+        const std::function<const SimTK::State&(int)>& getInitialState,
+        int numRuns, double finalTime) {
+    // Allocate the result slots up front; each run writes only its own slot.
+    m_results.clear();
+    m_results.resize(numRuns);
+    if (numRuns == 0) return m_results;
+
+    const int numThreads = std::min(getNumThreads(), numRuns);
+
+    // Copying and initializing models is not thread-safe, so create all
+    // workers before starting any threads.
+    std::vector<Worker> workers(numThreads);
+    for (auto& worker : workers) {
+        worker.model.reset(new Model(*m_model));
+        worker.model->setUseVisualizer(false);
+        // Analyses would be stepped concurrently and are not collected.
+        worker.model->updAnalysisSet().clearAndDestroy();
+        worker.defaultState = worker.model->initSystem();
+        for (const auto& outputPath : m_outputPaths) {
+            std::string componentPath;
+            std::string outputName;
+            std::string channelName;
+            std::string alias;
+            AbstractInput::parseConnecteePath(outputPath, componentPath,
+                    outputName, channelName, alias);
+            const auto& component =
+                    worker.model->getComponent(componentPath);
+            const auto& abstractOutput = component.getOutput(outputName);
+            const auto* output =
+                    dynamic_cast<const Output<double>*>(&abstractOutput);
+            OPENSIM_THROW_IF(!output, Exception,
+                    "Expected output '{}' to have type double, but it has "
+                    "type {}.", outputPath, abstractOutput.getTypeName());
+            worker.outputs.emplace_back(output);
+            worker.outputStage = std::max(
+                    worker.outputStage, output->getDependsOnStage());
+        }
+    }
+
+    const int ny = workers[0].defaultState.getNY();
+    for (int irun = 0; irun < numRuns; ++irun) {
+        OPENSIM_THROW_IF(getInitialState(irun).getNY() != ny, Exception,
+                "Expected the initial state for run {} to have {} "
+                "continuous state variables, but it has {}.",
+                irun, ny, getInitialState(irun).getNY());
+    }
+
+    log_info("Running {} simulation(s) on {} thread(s).", numRuns,
+            numThreads);
+    Stopwatch stopwatch;
+
+    // Workers take the next pending run as soon as they finish one, so that
+    // short and long runs balance out across the threads.
+    std::atomic<int> nextRun(0);
+    auto work = [&](Worker& worker) {
+        int irun;
+        while ((irun = nextRun++) < numRuns) {
+            simulate(worker, getInitialState(irun), irun, finalTime,
+                    m_results[irun]);
+        }
+    };
+    // Each thread gets one worker as its chunk.
+    runInContiguousChunks(numThreads, numThreads,
+            [&](int ithread, int, int) { work(workers[ithread]); });
+
+    const int numFailed = getNumFailedRuns();
+    if (numFailed) {
+        log_warn("{} of {} simulation(s) failed.", numFailed, numRuns);
+    }
+    log_info("Finished {} simulation(s) in {}.", numRuns,
+            stopwatch.getElapsedTimeFormatted());
+    return m_results;
+}
+
+void SimulationEnsemble::simulate(Worker& worker,
+        const SimTK::State& initialState, int runIndex, double finalTime,
+        RunResult& result) const {
+    Stopwatch stopwatch;
+    const Model& model = *worker.model;
+    std::unique_ptr<Manager> manager;
+    std::vector<double> times;
+    SimTK::Matrix outputValues;
+    int numRecorded = 0;
+    bool initialized = false;
+    try {
+        SimTK::State state = worker.defaultState;
+        state.setTime(initialState.getTime());
+        state.updY() = initialState.getY();
+        if (m_runInitializer) m_runInitializer(runIndex, model, state);
+
+        OPENSIM_THROW_IF(finalTime <= state.getTime(), Exception,
+                "Expected the final time ({}) to be after the initial "
+                "time ({}).", finalTime, state.getTime());
+        times = createReportingTimes(state.getTime(), finalTime);
+        outputValues.resize((int)times.size(), (int)worker.outputs.size());
+        outputValues.setToNaN();
+
+        auto record = [&](const SimTK::State& s) {
+            if (!worker.outputs.empty()) {
+                model.getSystem().realize(s, worker.outputStage);
+                for (int iout = 0; iout < (int)worker.outputs.size(); ++iout) {
+                    outputValues(numRecorded, iout) =
+                            worker.outputs[iout]->getValue(s);
+                }
+            }
+            if (m_recordStatesTrajectory) result.statesTrajectory.append(s);
+            ++numRecorded;
+        };
+
+        manager.reset(new Manager(*worker.model));
+        manager->setWriteToStorage(false);
+        manager->setPerformAnalyses(false);
+        manager->setIntegratorMethod(m_integratorMethod);
+        if (m_accuracy >= 0) manager->setIntegratorAccuracy(m_accuracy);
+        if (m_minStepSize >= 0) {
+            manager->setIntegratorMinimumStepSize(m_minStepSize);
+        }
+        if (m_maxStepSize >= 0) {
+            manager->setIntegratorMaximumStepSize(m_maxStepSize);
+        }
+        manager->initialize(state);
+        initialized = true;
+        record(manager->getState());
+
+        const auto& integ = manager->getIntegrator();
+        for (int itime = 1; itime < (int)times.size(); ++itime) {
+            const SimTK::State& s = manager->integrate(times[itime]);
+            OPENSIM_THROW_IF(integ.isSimulationOver() &&
+                            integ.getTerminationReason() !=
+                                    SimTK::Integrator::ReachedFinalTime,
+                    Exception, "Integration failed at time {}: {}.",
+                    s.getTime(),
+                    integ.getTerminationReasonString(
+                            integ.getTerminationReason()));
+            record(s);
+        }
+        result.status = RunStatus::Succeeded;
+    } catch (const std::exception& e) {
+        result.status = RunStatus::Failed;
+        result.message = e.what();
+    } catch (...) {
+        result.status = RunStatus::Failed;
+        result.message = "Unknown exception.";
+    }
+
+    if (initialized) {
+        const auto& integ = manager->getIntegrator();
+        result.stats.numStepsTaken = integ.getNumStepsTaken();
+        result.stats.numStepsAttempted = integ.getNumStepsAttempted();
+        result.stats.numRealizations = integ.getNumRealizations();
+        result.stats.numErrorTestFailures = integ.getNumErrorTestFailures();
+        result.finalState = manager->getState();
+    }
+    if (!times.empty() && !worker.outputs.empty()) {
+        result.outputs = TimeSeriesTable(times, outputValues, m_outputPaths);
+    }
+    result.stats.wallTime = stopwatch.getElapsedTime();
+}
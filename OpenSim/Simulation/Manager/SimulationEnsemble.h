@@ -0,0 +1,204 @@
+#ifndef OPENSIM_SIMULATIONENSEMBLE_H_
+#define OPENSIM_SIMULATIONENSEMBLE_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  SimulationEnsemble.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "Manager.h"
+
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Simulation/StatesTrajectory.h>
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/**
+ * Run many independent forward simulations of the same Model, for example
+ * for Monte Carlo studies in which the initial states, controls or other
+ * state-dependent parameters are perturbed.
+ *
+ * The ensemble keeps its own copy of the model. When run() is called, one
+ * copy of that model is created and initialized for each worker thread, and
+ * the workers repeatedly take the next pending run until all runs are done,
+ * so that runs of different length are balanced across the workers. Each run
+ * integrates with its own Manager, using the integrator settings given to
+ * the ensemble, and writes into a result slot that is allocated before any
+ * run starts.
+ *
+ * A run that throws an exception or whose integrator terminates before the
+ * final time is marked as failed; the remaining runs continue.
+ *
+ * Example:
+ * @code
+ * SimulationEnsemble ensemble(model);
+ * ensemble.setReportingInterval(0.01);
+ * ensemble.addOutput("/forceset/soleus|fiber_length");
+ * ensemble.setRunInitializer(
+ *         [&](int irun, const Model& model, SimTK::State& state) {
+ *             model.getCoordinateSet()[0].setValue(state, angles[irun]);
+ *         });
+ * const auto& results = ensemble.run(model.initSystem(), 1000, 1.0);
+ * @endcode
+ *
+ * @note The initial states are copied into each worker's own SimTK::State by
+ * time and continuous state variables (q, u, z) only. Use the run initializer
+ * to set discrete variables (e.g., overridden actuation).
+ */
+class OSIMSIMULATION_API SimulationEnsemble {
+public:
+    enum class RunStatus {
+        NotRun,    ///< run() has not reached this run.
+        Succeeded, ///< The run reached the final time.
+        Failed     ///< The run threw or its integrator failed.
+    };
+
+    /** Integrator counters and timing for a single run. */
+    struct IntegratorStats {
+        int numStepsTaken = 0;
+        int numStepsAttempted = 0;
+        int numRealizations = 0;
+        int numErrorTestFailures = 0;
+        /** Wall-clock duration of the run in seconds. */
+        double wallTime = 0;
+    };
+
+    /** The result of a single run. */
+    struct RunResult {
+        RunStatus status = RunStatus::NotRun;
+        /** Reason for a failed run. */
+        std::string message;
+        /** The state at the end of the run (or when the run failed). */
+        SimTK::State finalState;
+        /** States at each reporting time; empty unless
+         * setRecordStatesTrajectory(true) was called. */
+        StatesTrajectory statesTrajectory;
+        /** Values of the outputs added with addOutput() at each reporting
+         * time. Rows for reporting times after a failure contain NaN. */
+        TimeSeriesTable outputs;
+        IntegratorStats stats;
+    };
+
+    /** Invoked for each run on the worker's copy of the model and the
+     * worker's state, after the initial state has been copied into it. */
+    using RunInitializer = std::function<void(
+            int runIndex, const Model& model, SimTK::State& state)>;
+
+    /** The ensemble makes its own copy of the model. */
+    explicit SimulationEnsemble(const Model& model);
+    ~SimulationEnsemble();
+
+    SimulationEnsemble(const SimulationEnsemble&) = delete;
+    SimulationEnsemble& operator=(const SimulationEnsemble&) = delete;
+
+    /** @name Settings
+     * @{ */
+    /** Number of worker threads. 0 runs serially, 1 uses all cores, and N
+     * uses N threads. The default is 1. */
+    void setParallel(int parallel);
+    int getParallel() const { return m_parallel; }
+
+    /** See Manager::setIntegratorMethod(). */
+    void setIntegratorMethod(Manager::IntegratorMethod method)
+    {   m_integratorMethod = method; }
+    /** See Manager::setIntegratorAccuracy(). Negative values (the default)
+     * leave the integrator's default accuracy unchanged. */
+    void setIntegratorAccuracy(double accuracy) { m_accuracy = accuracy; }
+    /** See Manager::setIntegratorMinimumStepSize(). Ignored if negative. */
+    void setIntegratorMinimumStepSize(double hmin) { m_minStepSize = hmin; }
+    /** See Manager::setIntegratorMaximumStepSize(). Ignored if negative. */
+    void setIntegratorMaximumStepSize(double hmax) { m_maxStepSize = hmax; }
+
+    /** Time between reported states and outputs. If 0 (the default), only
+     * the initial and final times of each run are reported. */
+    void setReportingInterval(double interval);
+    double getReportingInterval() const { return m_reportingInterval; }
+
+    /** Whether to keep the states of each run at the reporting times
+     * (default: false). Only the final state is kept otherwise. */
+    void setRecordStatesTrajectory(bool tf) { m_recordStatesTrajectory = tf; }
+    bool getRecordStatesTrajectory() const { return m_recordStatesTrajectory; }
+
+    /** Record an Output<double> at each reporting time. The path has the
+     * same form as connectee paths, e.g., "/forceset/soleus|fiber_length". */
+    void addOutput(const std::string& outputPath);
+    const std::vector<std::string>& getOutputPaths() const
+    {   return m_outputPaths; }
+
+    void setRunInitializer(RunInitializer initializer)
+    {   m_runInitializer = std::move(initializer); }
+    /** @} */
+
+    /** @name Running
+     * @{ */
+    /** Run one simulation for each of the initial states, from the time of
+     * that state to finalTime. The initial states must have been created by
+     * the model given to the constructor (or an identical model). */
+    const std::vector<RunResult>& run(
+            const std::vector<SimTK::State>& initialStates, double finalTime);
+
+    /** Run numRuns simulations from the same initial state. Set a run
+     * initializer to perturb each run. */
+    const std::vector<RunResult>& run(
+            const SimTK::State& initialState, int numRuns, double finalTime);
+
+    /** The results of the last call to run(). */
+    const std::vector<RunResult>& getResults() const { return m_results; }
+    int getNumFailedRuns() const;
+    /** @} */
+
+private:
+    struct Worker;
+
+    int getNumThreads() const;
+    std::vector<double> createReportingTimes(
+            double initialTime, double finalTime) const;
+    const std::vector<RunResult>& runImpl(
+            const std::function<const SimTK::State&(int)>& getInitialState,
+            int numRuns, double finalTime);
+    void simulate(Worker& worker, const SimTK::State& initialState,
+            int runIndex, double finalTime, RunResult& result) const;
+
+    std::unique_ptr<Model> m_model;
+
+    int m_parallel = 1;
+    Manager::IntegratorMethod m_integratorMethod =
+            Manager::IntegratorMethod::RungeKuttaMerson;
+    double m_accuracy = -1;
+    double m_minStepSize = -1;
+    double m_maxStepSize = -1;
+    double m_reportingInterval = 0;
+    bool m_recordStatesTrajectory = false;
+    std::vector<std::string> m_outputPaths;
+    RunInitializer m_runInitializer;
+
+    std::vector<RunResult> m_results;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_SIMULATIONENSEMBLE_H_
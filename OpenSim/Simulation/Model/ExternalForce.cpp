@@ -318,6 +318,15 @@ void ExternalForce::extendConnectToModel(Model& model)
             }
         }
     }
+
+    std::vector<const Function*> channels(9, nullptr);
+    for (int i = 0; i < _forceFunctions.size(); ++i)
+        channels[i] = _forceFunctions[i];
+    for (int i = 0; i < _pointFunctions.size(); ++i)
+        channels[3 + i] = _pointFunctions[i];
+    for (int i = 0; i < _torqueFunctions.size(); ++i)
+        channels[6 + i] = _torqueFunctions[i];
+    _loadFunctions = MultiChannelSpline(channels);
 }
 
 
@@ -335,12 +344,13 @@ void ExternalForce::computeForce(const SimTK::State& state,
 
     assert(_appliedToBody!=nullptr);
 
+    Vec3 force, point, torque;
+    getLoadsAtTime(time, force, point, torque);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
-        Vec3 point(0); // Default is body origin.
+        // The point is the body origin if it is not specified.
         if (_specifiesPoint) {
-            point = getPointAtTime(time);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -348,7 +358,6 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
@@ -357,48 +366,38 @@ void ExternalForce::computeForce(const SimTK::State& state,
 /**
  * Convenience methods to access prescribed force functions
  */
-Vec3 ExternalForce::getForceAtTime(double aTime) const  
+void ExternalForce::getLoadsAtTime(double aTime, Vec3& force, Vec3& point,
+        Vec3& torque) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* forceX=NULL;
-    const Function* forceY=NULL;
-    const Function* forceZ=NULL;
-    if (_forceFunctions.size()==3){
-        forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
+    if (_loadFunctions.getNumChannels() != 9) {
+        force = point = torque = Vec3(0);
+        return;
     }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
+    SimTK::Vec<9> values;
+    _loadFunctions.calcValues(aTime, &values[0]);
+    force = Vec3::getAs(&values[0]);
+    point = Vec3::getAs(&values[3]);
+    torque = Vec3::getAs(&values[6]);
+}
+
+Vec3 ExternalForce::getForceAtTime(double aTime) const  
+{
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return force;
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* pointX=NULL;
-    const Function* pointY=NULL;
-    const Function* pointZ=NULL;
-    if (_pointFunctions.size()==3){
-        pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
-    }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return point;
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* torqueX=NULL;
-    const Function* torqueY=NULL;
-    const Function* torqueZ=NULL;
-    if (_torqueFunctions.size()==3){
-        torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
-    }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return torque;
 }
 
@@ -439,14 +438,15 @@ OpenSim::Array<double> ExternalForce::getRecordValues(const SimTK::State& state)
     OpenSim::Array<double>  values(SimTK::NaN);
     double time = state.getTime();
 
+    Vec3 force, point, torque;
+    getLoadsAtTime(time, force, point, torque);
+
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
         for(int i=0; i<3; ++i)
             values.append(force[i]);
     
         if (_specifiesPoint) {
-            Vec3 point = getPointAtTime(time);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
             for(int i=0; i<3; ++i)
@@ -454,7 +454,6 @@ OpenSim::Array<double> ExternalForce::getRecordValues(const SimTK::State& state)
         }
     }
     if (_appliesTorque){
-        Vec3 torque = getTorqueAtTime(time);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         for(int i=0; i<3; ++i)
             values.append(torque[i]);
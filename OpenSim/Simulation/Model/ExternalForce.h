@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
+#include <OpenSim/Common/MultiChannelSpline.h>
 
 namespace OpenSim {
 
@@ -173,6 +174,11 @@ public:
     SimTK::Vec3 getForceAtTime(double aTime) const;
     SimTK::Vec3 getPointAtTime(double aTime) const;
     SimTK::Vec3 getTorqueAtTime(double aTime) const;
+    /** Evaluate the force, point, and torque at a given time together,
+    which is faster than calling the three methods above. Components that
+    are not applied are zero. */
+    void getLoadsAtTime(double aTime, SimTK::Vec3& force, SimTK::Vec3& point,
+            SimTK::Vec3& torque) const;
 
     /**
      * Methods used for reporting.
@@ -258,6 +264,9 @@ private:
     ArrayPtrs<Function> _forceFunctions;
     ArrayPtrs<Function> _torqueFunctions;
     ArrayPtrs<Function> _pointFunctions;
+    /** The force, point, and torque functions (9 channels, in that order),
+    evaluated with a single interval search. */
+    MultiChannelSpline _loadFunctions;
 
     friend class ExternalLoads;
 //==============================================================================
@@ -26,6 +26,8 @@
 //=============================================================================
 #include "ForceAdapter.h"
 
+#include <OpenSim/Common/ComponentProfiler.h>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -46,6 +48,7 @@ void ForceAdapter::calcForce(const SimTK::State& state,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,SimTK::Vector_<SimTK::Vec3>& particleForces,
     SimTK::Vector& mobilityForces) const
 {
+    OPENSIM_PROFILE_COMPONENT(*_force, "computeForce", SimTK::Stage::Dynamics);
     _force->computeForce(state, bodyForces, mobilityForces);
 }
 
@@ -31,6 +31,9 @@
 #include <OpenSim/Simulation/Wrap/PathWrap.h>
 #include "Model.h"
 
+#include <algorithm>
+#include <cmath>
+
 //=============================================================================
 // STATICS
 //=============================================================================
@@ -39,6 +42,146 @@ using namespace OpenSim;
 using namespace SimTK;
 using SimTK::Vec3;
 
+namespace {
+// Limits on the size of the polynomial surrogate.
+const int maxSurrogateDimensions = 6;
+const int maxSurrogateOrder = 8;
+} // anonymous namespace
+
+//=============================================================================
+// POLYNOMIAL SURROGATE
+//=============================================================================
+/* The length of a path as a polynomial of the coordinates it spans. Each
+coordinate q is scaled to x = (2 q - max - min) / (max - min), which is in
+[-1, 1] over the range [min, max] of the coordinate, to keep the fit well
+conditioned. */
+class GeometryPath::PolynomialSurrogate {
+public:
+    struct Dimension {
+        std::string coordinatePath;
+        SimTK::MobilizedBodyIndex mobodIndex;
+        SimTK::MobilizerQIndex qIndex;
+        double min;
+        double max;
+    };
+
+    PolynomialSurrogate(std::vector<Dimension> dimensions, int order) :
+            _dimensions(std::move(dimensions)) {
+        // All terms whose exponents sum to at most the order.
+        const int nd = getNumDimensions();
+        std::vector<int> exponents(nd, 0);
+        while (true) {
+            int sum = 0;
+            for (int e : exponents) sum += e;
+            if (sum <= order) {
+                _exponents.insert(_exponents.end(),
+                        exponents.begin(), exponents.end());
+                ++_numTerms;
+            }
+            int i = 0;
+            while (i < nd && ++exponents[i] > order) exponents[i++] = 0;
+            if (i == nd) break;
+        }
+    }
+
+    int getNumDimensions() const { return (int)_dimensions.size(); }
+    int getNumTerms() const { return _numTerms; }
+    const std::vector<Dimension>& getDimensions() const { return _dimensions; }
+
+    /* Set q of dimension i in the state to the value for the scaled
+    coordinate x. */
+    void setCoordinate(const SimTK::SimbodyMatterSubsystem& matter,
+            SimTK::State& s, int i, double x) const {
+        const Dimension& d = _dimensions[i];
+        matter.getMobilizedBody(d.mobodIndex).setOneQ(s, d.qIndex,
+                0.5 * (d.min + d.max + x * (d.max - d.min)));
+    }
+
+    /* The scaled coordinates of the state, or false if a coordinate is
+    outside its range. */
+    bool calcScaledCoordinates(const SimTK::SimbodyMatterSubsystem& matter,
+            const SimTK::State& s, double* x) const {
+        for (int i = 0; i < getNumDimensions(); ++i) {
+            const Dimension& d = _dimensions[i];
+            const double q =
+                    matter.getMobilizedBody(d.mobodIndex).getOneQ(s, d.qIndex);
+            if (!(q >= d.min && q <= d.max)) return false;
+            x[i] = (2 * q - d.max - d.min) / (d.max - d.min);
+        }
+        return true;
+    }
+
+    /* The value of each term at the scaled coordinates x. */
+    void calcTerms(const double* x, double* terms) const {
+        double powers[maxSurrogateDimensions][maxSurrogateOrder + 1];
+        calcPowers(x, powers);
+        const int nd = getNumDimensions();
+        for (int t = 0; t < _numTerms; ++t) {
+            const int* e = &_exponents[t * nd];
+            double term = 1;
+            for (int i = 0; i < nd; ++i) term *= powers[i][e[i]];
+            terms[t] = term;
+        }
+    }
+
+    /* The length at the scaled coordinates x and, if dLdq is not null, its
+    derivatives with respect to the (unscaled) coordinates. */
+    double calcValue(const double* x, double* dLdq) const {
+        double powers[maxSurrogateDimensions][maxSurrogateOrder + 1];
+        calcPowers(x, powers);
+        const int nd = getNumDimensions();
+        if (dLdq) std::fill(dLdq, dLdq + nd, 0.0);
+        double value = 0;
+        for (int t = 0; t < _numTerms; ++t) {
+            const int* e = &_exponents[t * nd];
+            const double c = _coefficients[t];
+            double term = c;
+            for (int i = 0; i < nd; ++i) term *= powers[i][e[i]];
+            value += term;
+            if (!dLdq) continue;
+            for (int i = 0; i < nd; ++i) {
+                if (e[i] == 0) continue;
+                double derivative = c * e[i] * powers[i][e[i] - 1];
+                for (int j = 0; j < nd; ++j) {
+                    if (j != i) derivative *= powers[j][e[j]];
+                }
+                dLdq[i] += derivative;
+            }
+        }
+        if (dLdq) {
+            for (int i = 0; i < nd; ++i) {
+                dLdq[i] *= 2 / (_dimensions[i].max - _dimensions[i].min);
+            }
+        }
+        return value;
+    }
+
+    void setCoefficients(const SimTK::Vector& coefficients) {
+        _coefficients = coefficients;
+    }
+
+    bool inUse = false;
+    double lengthError = SimTK::NaN;
+    double momentArmError = SimTK::NaN;
+
+private:
+    void calcPowers(const double* x,
+            double (*powers)[maxSurrogateOrder + 1]) const {
+        for (int i = 0; i < getNumDimensions(); ++i) {
+            powers[i][0] = 1;
+            for (int k = 1; k <= maxSurrogateOrder; ++k) {
+                powers[i][k] = powers[i][k - 1] * x[i];
+            }
+        }
+    }
+
+    std::vector<Dimension> _dimensions;
+    // The exponents of dimension i in term t are at t * nd + i.
+    std::vector<int> _exponents;
+    int _numTerms = 0;
+    SimTK::Vector _coefficients;
+};
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -70,6 +213,8 @@ void GeometryPath::extendFinalizeFromProperties()
             upd_PathWrapSet()[i].setName(label.str());
         }
     }
+
+    _surrogate.reset();
 }
 
 void GeometryPath::extendConnectToModel(Model& aModel)
@@ -99,6 +244,8 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // of the path in the cache. Length depends only on q's so will be valid
     // after Position stage, speed requires u's also so valid at Velocity stage.
     this->_lengthCV = addCacheVariable("length", 0.0, SimTK::Stage::Position);
+    this->_surrogateLengthCV = addCacheVariable(
+            "surrogate_length", 0.0, SimTK::Stage::Position);
     this->_speedCV = addCacheVariable("speed", 0.0, SimTK::Stage::Velocity);
 
     // Cache the set of points currently defining this path.
@@ -198,6 +345,10 @@ void GeometryPath::constructProperties()
     Appearance appearance;
     appearance.set_color(SimTK::Gray);
     constructProperty_Appearance(appearance);
+
+    constructProperty_use_polynomial_surrogate(false);
+    constructProperty_polynomial_surrogate_order(5);
+    constructProperty_polynomial_surrogate_tolerance(0.001);
 }
 
 //_____________________________________________________________________________
@@ -305,6 +456,21 @@ void GeometryPath::addInEquivalentForces(const SimTK::State& s,
     SimTK::Vector_<SimTK::SpatialVec>& bodyForces,
     SimTK::Vector& mobilityForces) const
 {
+    double length;
+    double dLdq[maxSurrogateDimensions];
+    if (calcSurrogateLength(s, length, dLdq)) {
+        // The generalized force of the tension is -tension * dL/dq.
+        const SimTK::SimbodyMatterSubsystem& matter =
+                getModel().getMatterSubsystem();
+        const auto& dimensions = _surrogate->getDimensions();
+        for (int i = 0; i < (int)dimensions.size(); ++i) {
+            matter.addInMobilityForce(s, dimensions[i].mobodIndex,
+                    SimTK::MobilizerUIndex(dimensions[i].qIndex),
+                    -tension * dLdq[i], mobilityForces);
+        }
+        return;
+    }
+
     AbstractPathPoint* start = NULL;
     AbstractPathPoint* end = NULL;
     const SimTK::MobilizedBody* bo = NULL;
@@ -448,6 +614,16 @@ void GeometryPath::updateGeometry(const SimTK::State& s) const
  */
 double GeometryPath::getLength( const SimTK::State& s) const
 {
+    if (isPolynomialSurrogateInUse()) {
+        if (isCacheVariableValid(s, _surrogateLengthCV)) {
+            return getCacheVariableValue(s, _surrogateLengthCV);
+        }
+        double length;
+        if (calcSurrogateLength(s, length, nullptr)) {
+            setCacheVariableValue(s, _surrogateLengthCV, length);
+            return length;
+        }
+    }
     computePath(s);  // compute checks if path needs to be recomputed
     return getCacheVariableValue(s, _lengthCV);
 }
@@ -798,6 +974,7 @@ void GeometryPath::
 extendPostScale(const SimTK::State& s, const ScaleSet& scaleSet)
 {
     Super::extendPostScale(s, scaleSet);
+    _surrogate.reset();
     computePath(s);
 }
 
@@ -845,6 +1022,24 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
         return;
     }
 
+    double length;
+    double dLdq[maxSurrogateDimensions];
+    if (calcSurrogateLength(s, length, dLdq)) {
+        // The speeds of the coordinates of the surrogate are their qdots.
+        const SimTK::SimbodyMatterSubsystem& matter =
+                getModel().getMatterSubsystem();
+        const auto& dimensions = _surrogate->getDimensions();
+        double speed = 0.0;
+        for (int i = 0; i < (int)dimensions.size(); ++i) {
+            speed += dLdq[i] *
+                    matter.getMobilizedBody(dimensions[i].mobodIndex)
+                            .getOneU(s, SimTK::MobilizerUIndex(
+                                                dimensions[i].qIndex));
+        }
+        setLengtheningSpeed(s, speed);
+        return;
+    }
+
     const Array<AbstractPathPoint*>& currentPath = getCurrentPath(s);
 
     double speed = 0.0;
@@ -1153,6 +1348,236 @@ computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const
     return _maSolver->solve(s, aCoord,  *this);
 }
 
+void GeometryPath::computeMomentArms(const SimTK::State& s,
+        const SimTK::Array_<const Coordinate*>& coordinates,
+        SimTK::Vector& momentArms) const
+{
+    if (!_maSolver)
+        const_cast<Self*>(this)->_maSolver.reset(new MomentArmSolver(*_model));
+
+    const SimTK::Array_<const GeometryPath*> paths(1, this);
+    SimTK::Matrix result;
+    _maSolver->solve(s, coordinates, paths, result);
+    momentArms = ~result.row(0);
+}
+
+//=============================================================================
+// POLYNOMIAL SURROGATE
+//=============================================================================
+void GeometryPath::fitPolynomialSurrogate(const SimTK::State& s)
+{
+    _surrogate.reset();
+    if (!get_use_polynomial_surrogate()) return;
+
+    const int order = get_polynomial_surrogate_order();
+    OPENSIM_THROW_IF_FRMOBJ(order < 1 || order > maxSurrogateOrder,
+            InvalidPropertyValue,
+            getProperty_polynomial_surrogate_order().getName(),
+            "Expected an order from 1 to " +
+                    std::to_string(maxSurrogateOrder) + ", but got " +
+                    std::to_string(order) + ".");
+    const double tolerance = get_polynomial_surrogate_tolerance();
+
+    const Model& model = getModel();
+    const SimTK::MultibodySystem& system = model.getMultibodySystem();
+    const SimTK::SimbodyMatterSubsystem& matter = model.getMatterSubsystem();
+
+    // Sample the exact length in a copy of the state; the samples are
+    // reproducible.
+    SimTK::State sFit(s);
+    auto calcExactLength = [&]() {
+        system.realize(sFit, SimTK::Stage::Position);
+        computePath(sFit);
+        return getCacheVariableValue(sFit, _lengthCV);
+    };
+    SimTK::Random::Uniform random(0.0, 1.0);
+    random.setSeed(0);
+
+    // Find the coordinates the path spans from the change in length for a
+    // small change in each coordinate, at a few random configurations. The
+    // surrogate can only use coordinates whose qdot is their u.
+    const auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
+    const int nc = (int)coordinates.size();
+    std::vector<bool> spanned(nc, false);
+    std::vector<bool> supported(nc, true);
+    SimTK::Vector u(sFit.getNU(), 0.0);
+    SimTK::Vector qdot(sFit.getNQ());
+    const int numDependencySamples = 3;
+    for (int k = 0; k < numDependencySamples; ++k) {
+        sFit.updQ() = s.getQ();
+        for (const auto& c : coordinates) {
+            const double min = c->getRangeMin();
+            const double max = c->getRangeMax();
+            matter.getMobilizedBody(c->getBodyIndex()).setOneQ(sFit,
+                    SimTK::MobilizerQIndex(c->getMobilizerQIndex()),
+                    min + random.getValue() * (max - min));
+        }
+        const double length = calcExactLength();
+        for (int j = 0; j < nc; ++j) {
+            const Coordinate& c = *coordinates[j];
+            const SimTK::MobilizedBody& mobod =
+                    matter.getMobilizedBody(c.getBodyIndex());
+            const SimTK::MobilizerQIndex qIndex(c.getMobilizerQIndex());
+            if (!spanned[j]) {
+                const double q = mobod.getOneQ(sFit, qIndex);
+                const double h =
+                        1e-4 * std::max(c.getRangeMax() - c.getRangeMin(), 1.0);
+                mobod.setOneQ(sFit, qIndex, q + h);
+                const double dLdq = (calcExactLength() - length) / h;
+                mobod.setOneQ(sFit, qIndex, q);
+                system.realize(sFit, SimTK::Stage::Position);
+                spanned[j] = std::abs(dLdq) > 1e-6;
+            }
+            const int iu = (int)mobod.getFirstUIndex(sFit) + (int)qIndex;
+            const int iq = (int)mobod.getFirstQIndex(sFit) + (int)qIndex;
+            u[iu] = 1;
+            matter.multiplyByN(sFit, false, u, qdot);
+            u[iu] = 0;
+            for (int i = 0; i < qdot.size(); ++i) {
+                if (std::abs(qdot[i] - (i == iq ? 1 : 0)) > 1e-12) {
+                    supported[j] = false;
+                }
+            }
+        }
+    }
+
+    std::vector<PolynomialSurrogate::Dimension> dimensions;
+    bool canFit = true;
+    for (int j = 0; j < nc; ++j) {
+        if (!spanned[j]) continue;
+        const Coordinate& c = *coordinates[j];
+        dimensions.push_back({c.getAbsolutePathString(), c.getBodyIndex(),
+                SimTK::MobilizerQIndex(c.getMobilizerQIndex()),
+                c.getRangeMin(), c.getRangeMax()});
+        if (!supported[j] || !(c.getRangeMax() > c.getRangeMin())) {
+            log_warn("GeometryPath '{}' spans coordinate '{}', which the "
+                     "polynomial surrogate does not support (its range is "
+                     "empty or its speed is not its time derivative); "
+                     "computing the path exactly.",
+                    getAbsolutePathString(), c.getAbsolutePathString());
+            canFit = false;
+        }
+    }
+    if ((int)dimensions.size() > maxSurrogateDimensions) {
+        log_warn("GeometryPath '{}' spans {} coordinates, but the polynomial "
+                 "surrogate supports at most {}; computing the path exactly.",
+                getAbsolutePathString(), dimensions.size(),
+                maxSurrogateDimensions);
+        canFit = false;
+    }
+    if (!canFit) {
+        // Keep the coordinates, to be reported, but no terms.
+        _surrogate = std::make_shared<PolynomialSurrogate>(
+                std::move(dimensions), 0);
+        return;
+    }
+
+    auto surrogate = std::make_shared<PolynomialSurrogate>(
+            std::move(dimensions), order);
+    const int nd = surrogate->getNumDimensions();
+    const int nt = surrogate->getNumTerms();
+    double x[maxSurrogateDimensions];
+    auto setRandomConfiguration = [&]() {
+        sFit.updQ() = s.getQ();
+        for (int i = 0; i < nd; ++i) {
+            x[i] = 2 * random.getValue() - 1;
+            surrogate->setCoordinate(matter, sFit, i, x[i]);
+        }
+    };
+
+    // Fit the coefficients by least squares.
+    const int numFitSamples = 3 * nt + 10;
+    SimTK::Matrix A(numFitSamples, nt);
+    SimTK::Vector b(numFitSamples);
+    std::vector<double> terms(nt);
+    for (int k = 0; k < numFitSamples; ++k) {
+        setRandomConfiguration();
+        b[k] = calcExactLength();
+        surrogate->calcTerms(x, terms.data());
+        for (int t = 0; t < nt; ++t) A(k, t) = terms[t];
+    }
+    SimTK::Vector coefficients;
+    SimTK::FactorQTZ(A).solve(b, coefficients);
+    surrogate->setCoefficients(coefficients);
+
+    // Measure the errors at other configurations. The exact moment arms
+    // (-dL/dq) are computed by central differences.
+    const int numValidationSamples = std::max(50, nt);
+    double lengthError = 0;
+    double momentArmError = 0;
+    double dLdq[maxSurrogateDimensions];
+    for (int k = 0; k < numValidationSamples; ++k) {
+        setRandomConfiguration();
+        const double length = calcExactLength();
+        lengthError = std::max(lengthError,
+                std::abs(surrogate->calcValue(x, dLdq) - length));
+        for (int i = 0; i < nd; ++i) {
+            const auto& d = surrogate->getDimensions()[i];
+            const SimTK::MobilizedBody& mobod =
+                    matter.getMobilizedBody(d.mobodIndex);
+            const double q = mobod.getOneQ(sFit, d.qIndex);
+            const double h = 1e-5 * (d.max - d.min);
+            mobod.setOneQ(sFit, d.qIndex, q + h);
+            const double lengthPlus = calcExactLength();
+            mobod.setOneQ(sFit, d.qIndex, q - h);
+            const double lengthMinus = calcExactLength();
+            mobod.setOneQ(sFit, d.qIndex, q);
+            momentArmError = std::max(momentArmError,
+                    std::abs((lengthPlus - lengthMinus) / (2 * h) - dLdq[i]));
+        }
+    }
+    surrogate->lengthError = lengthError;
+    surrogate->momentArmError = momentArmError;
+    surrogate->inUse = lengthError <= tolerance && momentArmError <= tolerance;
+    if (!surrogate->inUse) {
+        log_warn("The polynomial surrogate of GeometryPath '{}' has errors of "
+                 "{} in length and {} in moment arms, which exceed "
+                 "polynomial_surrogate_tolerance ({}); computing the path "
+                 "exactly.",
+                getAbsolutePathString(), lengthError, momentArmError,
+                tolerance);
+    }
+    _surrogate = surrogate;
+}
+
+bool GeometryPath::isPolynomialSurrogateInUse() const
+{
+    return _surrogate && _surrogate->inUse;
+}
+
+std::vector<std::string> GeometryPath::getPolynomialSurrogateCoordinates() const
+{
+    std::vector<std::string> paths;
+    if (!_surrogate) return paths;
+    for (const auto& dimension : _surrogate->getDimensions()) {
+        paths.push_back(dimension.coordinatePath);
+    }
+    return paths;
+}
+
+double GeometryPath::getPolynomialSurrogateLengthError() const
+{
+    return _surrogate ? _surrogate->lengthError : SimTK::NaN;
+}
+
+double GeometryPath::getPolynomialSurrogateMomentArmError() const
+{
+    return _surrogate ? _surrogate->momentArmError : SimTK::NaN;
+}
+
+bool GeometryPath::calcSurrogateLength(const SimTK::State& s, double& length,
+        double* dLdq) const
+{
+    if (!isPolynomialSurrogateInUse()) return false;
+    double x[maxSurrogateDimensions];
+    if (!_surrogate->calcScaledCoordinates(
+                getModel().getMatterSubsystem(), s, x)) {
+        return false;
+    }
+    length = _surrogate->calcValue(x, dLdq);
+    return true;
+}
+
 //_____________________________________________________________________________
 // Override default implementation by object to intercept and fix the XML node
 // underneath the model to match current version.
@@ -31,6 +31,8 @@
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
 
+#include <memory>
+
 
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
@@ -72,6 +74,23 @@ public:
     OpenSim_DECLARE_UNNAMED_PROPERTY(Appearance,
         "Default appearance attributes for this GeometryPath");
 
+    OpenSim_DECLARE_PROPERTY(use_polynomial_surrogate, bool,
+        "Compute the length, lengthening speed, and moment arms of the path "
+        "from a polynomial of the coordinates the path spans, fitted when the "
+        "model is initialized, instead of from the path points and wrap "
+        "objects (default: false). The path is computed exactly outside the "
+        "ranges of the coordinates, or if the polynomial is not accurate to "
+        "within polynomial_surrogate_tolerance.");
+
+    OpenSim_DECLARE_PROPERTY(polynomial_surrogate_order, int,
+        "The largest sum of exponents in a term of the polynomial surrogate "
+        "(1 to 8; default: 5).");
+
+    OpenSim_DECLARE_PROPERTY(polynomial_surrogate_tolerance, double,
+        "Largest error in length and in moment arms, at configurations not "
+        "used for fitting, for the polynomial surrogate to be used "
+        "(default: 0.001 m).");
+
 private:
     OpenSim_DECLARE_UNNAMED_PROPERTY(PathPointSet,
         "The set of points defining the path");
@@ -88,9 +107,17 @@ private:
     SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
 
     mutable CacheVariable<double> _lengthCV;
+    // The length from the polynomial surrogate. computePath() always stores
+    // the exact length in _lengthCV, so the surrogate cannot share it.
+    mutable CacheVariable<double> _surrogateLengthCV;
     mutable CacheVariable<double> _speedCV;
     mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
     mutable CacheVariable<SimTK::Vec3> _colorCV;
+
+    // Fitted by fitPolynomialSurrogate(); shared by copies of this path, and
+    // cleared when the properties change.
+    class PolynomialSurrogate;
+    std::shared_ptr<const PolynomialSurrogate> _surrogate;
     
 //=============================================================================
 // METHODS
@@ -187,6 +214,49 @@ public:
     //--------------------------------------------------------------------------
     virtual double computeMomentArm(const SimTK::State& s, const Coordinate& aCoord) const;
 
+    /** Compute the path's moment arms about each of the given coordinates.
+    This gives the same result as calling computeMomentArm() for each
+    coordinate, but computes the forces this path applies to the model only
+    once. To compute the moment arms of many paths, use
+    MomentArmSolver::solve() with all of the paths at once.
+    @param[in]  s            current state of the model
+    @param[in]  coordinates  Coordinates about which to compute moment arms
+    @param[out] momentArms   resized to the number of coordinates          */
+    void computeMomentArms(const SimTK::State& s,
+            const SimTK::Array_<const Coordinate*>& coordinates,
+            SimTK::Vector& momentArms) const;
+
+    //--------------------------------------------------------------------------
+    // POLYNOMIAL SURROGATE
+    //--------------------------------------------------------------------------
+    /** Fit the polynomial surrogate of the length of this path, if the
+    use_polynomial_surrogate property is true. Model::initializeState() calls
+    this for you.
+
+    The coordinates the path spans are those whose value changes the length
+    of the path. The length is sampled over the ranges of these coordinates
+    (with other coordinates as in the given state, which must be realized to
+    Stage::Position), and the polynomial is fitted by least squares. Its
+    derivatives give the lengthening speed and the generalized forces the
+    path applies, and thus the moment arms. The errors in length and moment
+    arms are then measured at other samples. If either exceeds
+    polynomial_surrogate_tolerance, or if the path spans more than 6
+    coordinates, the path is computed exactly (the errors can still be
+    queried). */
+    void fitPolynomialSurrogate(const SimTK::State& s);
+    /** Whether the length, lengthening speed, and moment arms are computed
+    from the polynomial surrogate (within the ranges of the coordinates). */
+    bool isPolynomialSurrogateInUse() const;
+    /** The absolute paths of the coordinates of the polynomial surrogate. */
+    std::vector<std::string> getPolynomialSurrogateCoordinates() const;
+    /** The largest error in length of the polynomial surrogate, at the
+    configurations used to validate the fit, or NaN if there is no fit. */
+    double getPolynomialSurrogateLengthError() const;
+    /** The largest error in moment arms (about the coordinates of the
+    surrogate, ignoring constraints) of the polynomial surrogate, at the
+    configurations used to validate the fit, or NaN if there is no fit. */
+    double getPolynomialSurrogateMomentArmError() const;
+
     //--------------------------------------------------------------------------
     // SCALING
     //--------------------------------------------------------------------------
@@ -226,6 +296,8 @@ protected:
 private:
 
     void computePath(const SimTK::State& s ) const;
+    bool calcSurrogateLength(const SimTK::State& s, double& length,
+            double* dLdq) const;
     void computeLengtheningSpeed(const SimTK::State& s) const;
     void applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path ) const;
     double calcPathLengthChange(const SimTK::State& s, const WrapObject& wo, 
@@ -36,6 +36,7 @@
 #include "ControllerSet.h"
 #include "CoordinateSet.h"
 #include "ForceSet.h"
+#include "GeometryPath.h"
 #include "Ligament.h"
 #include "MarkerSet.h"
 #include "ProbeSet.h"
@@ -449,6 +450,15 @@ SimTK::State& Model::initializeState() {
     // Do the assembly
     createAssemblySolver(_workingState);
     assemble(_workingState);
+
+    // Fit the polynomial surrogates of paths that use them, now that the
+    // default configuration is known.
+    for (auto& path : updComponentList<GeometryPath>()) {
+        if (path.get_use_polynomial_surrogate()) {
+            path.fitPolynomialSurrogate(_workingState);
+        }
+    }
+
     // We can now collect up all the fixed geometry, which needs full configuration.
     if (getUseVisualizer())
         _modelViz->collectFixedGeometry(_workingState);
@@ -127,6 +127,21 @@ void PrescribedForce::constructProperties()
     constructProperty_torqueFunctions(FunctionSet());
 }
 
+void PrescribedForce::extendFinalizeFromProperties()
+{
+    Super::extendFinalizeFromProperties();
+
+    std::vector<const Function*> channels(9, nullptr);
+    const FunctionSet* functionSets[] = {&getForceFunctions(),
+            &getPointFunctions(), &getTorqueFunctions()};
+    for (int k = 0; k < 3; ++k) {
+        if (functionSets[k]->getSize() != 3) continue;
+        for (int i = 0; i < 3; ++i)
+            channels[3 * k + i] = &(*functionSets[k])[i];
+    }
+    _loadFunctions = MultiChannelSpline(channels);
+}
+
 void PrescribedForce::setFrameName(const std::string& frameName) {
     updSocket<PhysicalFrame>("frame").setConnecteePath(frameName);
 }
@@ -246,43 +261,28 @@ void PrescribedForce::computeForce(const SimTK::State& state,
 {
     const bool pointIsGlobal = get_pointIsGlobal();
     const bool forceIsGlobal = get_forceIsGlobal();
-    const FunctionSet& forceFunctions = getForceFunctions();
-    const FunctionSet& pointFunctions = getPointFunctions();
-    const FunctionSet& torqueFunctions = getTorqueFunctions();
 
-    double time = state.getTime();
-    SimTK::Vector  timeAsVector(1, time);
+    const bool hasForceFunctions  = getForceFunctions().getSize()==3;
+    const bool hasTorqueFunctions = getTorqueFunctions().getSize()==3;
 
-    const bool hasForceFunctions  = forceFunctions.getSize()==3;
-    const bool hasPointFunctions  = pointFunctions.getSize()==3;
-    const bool hasTorqueFunctions = torqueFunctions.getSize()==3;
+    // The point is the body origin if there are no point functions.
+    Vec3 force, point, torque;
+    getLoadsAtTime(state.getTime(), force, point, torque);
 
     const PhysicalFrame& frame =
         getSocket<PhysicalFrame>("frame").getConnectee();
     const Ground& gnd = getModel().getGround();
     if (hasForceFunctions) {
-        Vec3 force(forceFunctions[0].calcValue(timeAsVector), 
-                   forceFunctions[1].calcValue(timeAsVector), 
-                   forceFunctions[2].calcValue(timeAsVector));
         if (!forceIsGlobal)
             force = frame.expressVectorInAnotherFrame(state, force, gnd);
 
-        Vec3 point(0); // Default is body origin.
-        if (hasPointFunctions) {
+        if (getPointFunctions().getSize()==3 && pointIsGlobal) {
             // Apply force to a specified point on the body.
-            point = Vec3(pointFunctions[0].calcValue(timeAsVector), 
-                         pointFunctions[1].calcValue(timeAsVector), 
-                         pointFunctions[2].calcValue(timeAsVector));
-            if (pointIsGlobal)
-                point = gnd.findStationLocationInAnotherFrame(state, point, frame);
-
+            point = gnd.findStationLocationInAnotherFrame(state, point, frame);
         }
         applyForceToPoint(state, frame, point, force, bodyForces);
     }
     if (hasTorqueFunctions){
-        Vec3 torque(torqueFunctions[0].calcValue(timeAsVector), 
-                    torqueFunctions[1].calcValue(timeAsVector), 
-                    torqueFunctions[2].calcValue(timeAsVector));
         if (!forceIsGlobal)
             torque = frame.expressVectorInAnotherFrame(state, torque, gnd);
 
@@ -293,45 +293,49 @@ void PrescribedForce::computeForce(const SimTK::State& state,
 /**
  * Convenience methods to access prescribed force functions
  */
-Vec3 PrescribedForce::getForceAtTime(double aTime) const    
+void PrescribedForce::getLoadsAtTime(double aTime, Vec3& force, Vec3& point,
+        Vec3& torque) const
 {
-    const FunctionSet& forceFunctions = getForceFunctions();
-
-    if (forceFunctions.getSize() != 3)
-        return Vec3(0);
+    SimTK::Vec<9> values(0);
+    if (isObjectUpToDateWithProperties()) {
+        _loadFunctions.calcValues(aTime, &values[0]);
+    } else {
+        // The functions may have been edited since
+        // extendFinalizeFromProperties().
+        const SimTK::Vector timeAsVector(1, aTime);
+        const FunctionSet* functionSets[] = {&getForceFunctions(),
+                &getPointFunctions(), &getTorqueFunctions()};
+        for (int k = 0; k < 3; ++k) {
+            if (functionSets[k]->getSize() != 3) continue;
+            for (int i = 0; i < 3; ++i) {
+                values[3 * k + i] =
+                        (*functionSets[k])[i].calcValue(timeAsVector);
+            }
+        }
+    }
+    force = Vec3::getAs(&values[0]);
+    point = Vec3::getAs(&values[3]);
+    torque = Vec3::getAs(&values[6]);
+}
 
-    const SimTK::Vector timeAsVector(1, aTime);
-    const Vec3 force(forceFunctions[0].calcValue(timeAsVector), 
-                     forceFunctions[1].calcValue(timeAsVector), 
-                     forceFunctions[2].calcValue(timeAsVector));
+Vec3 PrescribedForce::getForceAtTime(double aTime) const    
+{
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return force;
 }
 
 Vec3 PrescribedForce::getPointAtTime(double aTime) const
 {
-    const FunctionSet& pointFunctions = getPointFunctions();
-
-    if (pointFunctions.getSize() != 3)
-        return Vec3(0);
-
-    const SimTK::Vector timeAsVector(1, aTime);
-    const Vec3 point(pointFunctions[0].calcValue(timeAsVector), 
-                     pointFunctions[1].calcValue(timeAsVector), 
-                     pointFunctions[2].calcValue(timeAsVector));
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return point;
 }
 
 Vec3 PrescribedForce::getTorqueAtTime(double aTime) const
 {
-    const FunctionSet& torqueFunctions = getTorqueFunctions();
-
-    if (torqueFunctions.getSize() != 3)
-        return Vec3(0);
-
-    const SimTK::Vector timeAsVector(1, aTime);
-    const Vec3 torque(torqueFunctions[0].calcValue(timeAsVector), 
-                      torqueFunctions[1].calcValue(timeAsVector), 
-                      torqueFunctions[2].calcValue(timeAsVector));
+    Vec3 force, point, torque;
+    getLoadsAtTime(aTime, force, point, torque);
     return torque;
 }
 
@@ -391,13 +395,12 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
     const bool appliesTorque  = torqueFunctions.getSize()==3;
 
     // This is bad as it duplicates the code in computeForce we'll cleanup after it works!
-    const double time = state.getTime();
-    const SimTK::Vector timeAsVector(1, time);
+    Vec3 force, point, torque;
+    getLoadsAtTime(state.getTime(), force, point, torque);
     const PhysicalFrame& frame =
         getSocket<PhysicalFrame>("frame").getConnectee();
     const Ground& gnd = getModel().getGround();
     if (appliesForce) {
-        Vec3 force = getForceApplied(state);
         if (!forceIsGlobal)
             force = frame.expressVectorInAnotherFrame(state, force, gnd);
 
@@ -405,7 +408,6 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
             //applyForce(*_body, force);
             for (int i=0; i<3; i++) values.append(force[i]);
         } else {
-            Vec3 point = getApplicationPoint(state);
             if (pointIsGlobal)
                 point = gnd.findStationLocationInAnotherFrame(state, point, frame);
 
@@ -415,7 +417,6 @@ OpenSim::Array<double> PrescribedForce::getRecordValues(const SimTK::State& stat
         }
     }
     if (appliesTorque) {
-        Vec3 torque = getTorqueApplied(state);
         if (!forceIsGlobal)
             torque = frame.expressVectorInAnotherFrame(state, torque, gnd);
 
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "OpenSim/Common/FunctionSet.h"
+#include "OpenSim/Common/MultiChannelSpline.h"
 #include "Force.h"
 
 namespace OpenSim {
@@ -241,6 +242,11 @@ public:
     /** Convenience method to evaluate the prescribed torque functions at
     an arbitrary time. Returns zero if there aren't three functions defined. **/
     SimTK::Vec3 getTorqueAtTime(double aTime) const;
+    /** Evaluate the force, point, and torque functions at a given time
+    together, which is faster than calling the three methods above. Each
+    vector is zero if there aren't three functions defined for it. **/
+    void getLoadsAtTime(double aTime, SimTK::Vec3& force, SimTK::Vec3& point,
+            SimTK::Vec3& torque) const;
 
     /**
      * Methods used for reporting
@@ -265,6 +271,7 @@ public:
         return getPointAtTime(state.getTime());
     }
 protected:
+    void extendFinalizeFromProperties() override;
 
     /** Force interface. **/
     void computeForce
@@ -279,6 +286,11 @@ private:
     void setNull();
     void constructProperties();
 
+    /** The force, point, and torque functions (9 channels, in that order),
+    evaluated with a single interval search. Set in
+    extendFinalizeFromProperties(). **/
+    MultiChannelSpline _loadFunctions;
+
 //=============================================================================
 };  // END of class PrescribedForce
 //=============================================================================
@@ -71,13 +71,57 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     // set speeds to zero
     s_ma.updU() = 0;
 
+    computePathGeneralizedForces(s_ma, path);
+
+    // Moment-arm is the effective torque (since tension is 1) at the 
+    // coordinate of interest taking into account the generalized forces also 
+    // acting on other coordinates that are coupled via constraint.
+    return ~_coupling*_generalizedForces;
+}
+
+void MomentArmSolver::solve(const State& state,
+        const SimTK::Array_<const Coordinate*>& coordinates,
+        const SimTK::Array_<const GeometryPath*>& paths,
+        SimTK::Matrix& momentArms) const
+{
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+    momentArms.resize(np, nc);
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // compute the coupling between coordinates due to constraints, once per
+    // coordinate rather than once per path/coordinate pair
+    _couplingMatrix.resize(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        _couplingMatrix.updCol(j) =
+            computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    for (int i = 0; i < np; ++i) {
+        computePathGeneralizedForces(s_ma, *paths[i]);
+        // Moment-arms are the effective torques (since tension is 1) at the
+        // coordinates of interest: r_j = ~C_j * f for every coordinate j.
+        momentArms.updRow(i) = ~_generalizedForces * _couplingMatrix;
+    }
+}
+
+void MomentArmSolver::computePathGeneralizedForces(const SimTK::State& s_ma,
+        const GeometryPath& path) const
+{
     // zero out all the forces
     _bodyForces *= 0;
     _generalizedForces = 0;
 
     // apply a tension of unity to the bodies of the path
-    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
-    path.addInEquivalentForces(s_ma, 1.0, _bodyForces, pathDependentMobilityForces);
+    _pathMobilityForces.resize(s_ma.getNU());
+    _pathMobilityForces = 0;
+    path.addInEquivalentForces(s_ma, 1.0, _bodyForces, _pathMobilityForces);
 
     //_bodyForces.dump("bodyForces from addInEquivalentForcesOnBodies");
 
@@ -86,11 +130,7 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     getModel().getMultibodySystem().getMatterSubsystem()
         .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
 
-    _generalizedForces += pathDependentMobilityForces;
-    // Moment-arm is the effective torque (since tension is 1) at the 
-    // coordinate of interest taking into account the generalized forces also 
-    // acting on other coordinates that are coupled via constraint.
-    return ~_coupling*_generalizedForces;
+    _generalizedForces += _pathMobilityForces;
 }
 
 
@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "Solver.h"
+#include "SimTKcommon/internal/Array.h"
 #include "SimTKcommon/internal/State.h"
 
 namespace OpenSim {
@@ -83,6 +84,24 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of several GeometryPaths about
+        several coordinates in one pass. The constraint coupling vector of each
+        coordinate and the generalized forces of each path are computed only
+        once, so this is much cheaper than calling solve() for every
+        path/coordinate pair.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want the moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @param  momentArms          resulting moment-arms; resized to (number of
+                                paths) x (number of coordinates), with the
+                                moment-arm of paths[i] about coordinates[j] in
+                                row i, column j.
+    */
+    void solve(const SimTK::State& state,
+        const SimTK::Array_<const Coordinate*>& coordinates,
+        const SimTK::Array_<const GeometryPath*>& paths,
+        SimTK::Matrix& momentArms) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -96,6 +115,17 @@ private:
     // Keep preallocated vector of the coupling constraint factors
     mutable SimTK::Vector _coupling;
 
+    // Keep preallocated coupling vectors (as columns) for batched solves
+    mutable SimTK::Matrix _couplingMatrix;
+
+    // Keep preallocated vector of path dependent mobility forces
+    mutable SimTK::Vector _pathMobilityForces;
+
+    // compute the generalized forces due to a unit tension along the path
+    // and store them in _generalizedForces
+    void computePathGeneralizedForces(const SimTK::State& state,
+        const GeometryPath& path) const;
+
     // compute vector of constraint coupling factors
     SimTK::Vector computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const;
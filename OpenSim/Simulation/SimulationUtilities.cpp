@@ -30,6 +30,9 @@
 
 #include <OpenSim/Common/TableUtilities.h>
 
+#include <cctype>
+#include <unordered_set>
+
 using namespace OpenSim;
 
 SimTK::State OpenSim::simulate(Model& model,
@@ -392,6 +395,77 @@ void OpenSim::checkLabelsMatchModelStates(const Model& model,
     }
 }
 
+namespace {
+// If the pattern contains no regular expression syntax other than escaped
+// punctuation (e.g., "\\|"), it matches only one string; store that string in
+// literal and return true.
+bool getLiteralPattern(const std::string& pattern, std::string& literal) {
+    static const std::string special = ".[]{}()*+?^$|";
+    literal.clear();
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const char c = pattern[i];
+        if (c == '\\') {
+            if (++i == pattern.size()) return false;
+            // Escaped letters and digits are character classes or
+            // backreferences (e.g., \d).
+            if (std::isalnum((unsigned char)pattern[i])) return false;
+            literal.push_back(pattern[i]);
+        } else if (special.find(c) != std::string::npos) {
+            return false;
+        } else {
+            literal.push_back(c);
+        }
+    }
+    return true;
+}
+} // anonymous namespace
+
+std::vector<const AbstractOutput*> OpenSim::findOutputsMatchingPatterns(
+        const Model& model, const std::vector<std::string>& patterns) {
+    std::unordered_set<std::string> literals;
+    std::vector<std::regex> regexes;
+    for (const auto& pattern : patterns) {
+        std::string literal;
+        if (getLiteralPattern(pattern, literal)) {
+            literals.insert(literal);
+        } else {
+            regexes.emplace_back(pattern);
+        }
+    }
+
+    std::vector<const AbstractOutput*> outputs;
+    for (const auto& comp : model.getComponentList()) {
+        for (const auto& outputName : comp.getOutputNames()) {
+            const auto& output = comp.getOutput(outputName);
+            const std::string outputPath = output.getPathName();
+            bool matches = literals.count(outputPath) > 0;
+            for (auto it = regexes.begin(); !matches && it != regexes.end();
+                    ++it) {
+                matches = std::regex_match(outputPath, *it);
+            }
+            if (matches) outputs.push_back(&output);
+        }
+    }
+    return outputs;
+}
+
+AnalyzeOutputsResult OpenSim::analyzeOutputs(const Model& model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths, int parallel) {
+    AnalyzeOutputColumns<double> doubles;
+    AnalyzeOutputColumns<SimTK::Vec3> vec3s;
+    AnalyzeOutputColumns<SimTK::SpatialVec> spatialVecs;
+    analyzeOutputsImpl(model, statesTable, controlsTable, outputPaths,
+            parallel, doubles, vec3s, spatialVecs);
+    const auto& times = statesTable.getIndependentColumn();
+    AnalyzeOutputsResult result;
+    result.doubles = doubles.createTable(times);
+    result.vec3s = vec3s.createTable(times);
+    result.spatialVecs = spatialVecs.createTable(times);
+    return result;
+}
+
 TimeSeriesTableVec3 OpenSim::createSyntheticIMUAccelerationSignals(
         const Model& model,
         const TimeSeriesTable& statesTable, const TimeSeriesTable& controlsTable,
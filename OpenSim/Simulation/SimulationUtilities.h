@@ -25,10 +25,12 @@
 
 #include "StatesTrajectory.h"
 #include "osimSimulationDLL.h"
+#include <memory>
 #include <regex>
 
 #include <SimTKcommon/internal/State.h>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -191,6 +193,173 @@ OSIMSIMULATION_API void checkOrderSystemControls(const Model& model);
 OSIMSIMULATION_API void checkLabelsMatchModelStates(
         const Model& model, const std::vector<std::string>& labels);
 
+/// Find the outputs of the model whose paths match any of the provided
+/// patterns. The patterns are regular expressions (see analyze()), but each
+/// pattern is compiled only once, and patterns that contain no regular
+/// expression syntax other than escaped punctuation (e.g.,
+/// "/forceset/soleus\\|activation") are compared as plain strings. Outputs are
+/// returned in the order of Model::getComponentList() and
+/// Component::getOutputNames(), and each output is returned at most once. The
+/// model must have been finalized (e.g., with initSystem()).
+/// @ingroup simulationutil
+OSIMSIMULATION_API std::vector<const AbstractOutput*>
+findOutputsMatchingPatterns(
+        const Model& model, const std::vector<std::string>& patterns);
+
+/// @cond
+#ifndef SWIG
+// The values of the outputs of type T computed by analyzeOutputsImpl().
+template <typename T>
+class AnalyzeOutputColumns {
+public:
+    using Channel = typename Output<T>::Channel;
+    // Add a column for each channel of the output if the output has type T.
+    bool claim(const AbstractOutput& output) {
+        const auto* typed = dynamic_cast<const Output<T>*>(&output);
+        if (!typed) return false;
+        log_debug("Adding output {} of type {}.", output.getPathName(),
+                output.getTypeName());
+        for (const auto& it : typed->getChannels()) {
+            m_labels.push_back(it.second.getPathName());
+        }
+        return true;
+    }
+    // Find the channels in a worker's copy of the model.
+    void resolve(const Model& model) {
+        m_channels.emplace_back();
+        for (const auto& label : m_labels) {
+            std::string componentPath;
+            std::string outputName;
+            std::string channelName;
+            std::string alias;
+            AbstractInput::parseConnecteePath(label, componentPath, outputName,
+                    channelName, alias);
+            const auto& output = dynamic_cast<const Output<T>&>(
+                    model.getComponent(componentPath).getOutput(outputName));
+            m_channels.back().push_back(static_cast<const Channel*>(
+                    &output.getChannel(channelName)));
+        }
+    }
+    void allocate(int numRows) {
+        m_values.resize(numRows, (int)m_labels.size());
+    }
+    // Each worker writes only its own rows.
+    void record(int iworker, int itime, const SimTK::State& state) {
+        const auto& channels = m_channels[iworker];
+        for (int icol = 0; icol < (int)channels.size(); ++icol) {
+            m_values(itime, icol) = channels[icol]->getValue(state);
+        }
+    }
+    TimeSeriesTable_<T> createTable(const std::vector<double>& times) const {
+        if (m_labels.empty()) return TimeSeriesTable_<T>(times);
+        if (times.empty()) {
+            TimeSeriesTable_<T> table;
+            table.setColumnLabels(m_labels);
+            return table;
+        }
+        return TimeSeriesTable_<T>(times, m_values, m_labels);
+    }
+private:
+    std::vector<std::string> m_labels;
+    std::vector<std::vector<const Channel*>> m_channels;
+    SimTK::Matrix_<T> m_values;
+};
+
+// Compute the outputs matching outputPaths for all of the provided output
+// types in a single pass over the trajectory. The rows are split into
+// contiguous chunks, and each chunk is analyzed by its own copy of the model.
+template <typename... Ts>
+void analyzeOutputsImpl(const Model& model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths, int parallel,
+        AnalyzeOutputColumns<Ts>&... columns) {
+    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
+            Exception,
+            "Expected statesTable and controlsTable to contain the "
+            "same number of rows, but statesTable contains {} rows "
+            "and controlsTable contains {} rows.",
+            statesTable.getNumRows(), controlsTable.getNumRows());
+    const int numRows = (int)statesTable.getNumRows();
+    // Each thread initializes its own copy of the model, which only pays off
+    // if the thread has enough rows to analyze.
+    const int minRowsPerThread = 50;
+    const int numThreads =
+            getNumThreadsForParallel(parallel, numRows, minRowsPerThread);
+
+    // Copying and initializing models is not thread-safe, so create all of
+    // the copies before starting any threads.
+    std::vector<std::unique_ptr<Model>> models;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        models.emplace_back(new Model(model));
+        models.back()->initSystem();
+    }
+    for (const auto* output :
+            findOutputsMatchingPatterns(*models[0], outputPaths)) {
+        bool claimed = false;
+        int expand[] = {0, (claimed = claimed || columns.claim(*output), 0)...};
+        (void)expand;
+        if (!claimed) {
+            log_warn("Ignoring output {} of type {}.", output->getPathName(),
+                    output->getTypeName());
+        }
+    }
+    for (const auto& workerModel : models) {
+        int expand[] = {0, (columns.resolve(*workerModel), 0)...};
+        (void)expand;
+    }
+    {
+        int expand[] = {0, (columns.allocate(numRows), 0)...};
+        (void)expand;
+    }
+    if (numRows == 0) return;
+
+    const std::vector<double>& times = statesTable.getIndependentColumn();
+    const std::vector<std::string>& controlNames =
+            controlsTable.getColumnLabels();
+    runInContiguousChunks(numRows, numThreads,
+            [&](int iworker, int begin, int end) {
+        const Model& workerModel = *models[iworker];
+        // Only create the states for this worker's rows.
+        TimeSeriesTable rows(
+                std::vector<double>(times.begin() + begin,
+                        times.begin() + end),
+                statesTable.getMatrixBlock(begin, 0, end - begin,
+                        statesTable.getNumColumns()),
+                statesTable.getColumnLabels());
+        rows.updTableMetaData() = statesTable.getTableMetaData();
+        const auto statesTraj =
+                StatesTrajectory::createFromStatesTable(workerModel, rows);
+
+        const std::unordered_map<std::string, int> controlMap =
+                createSystemControlIndexMap(workerModel);
+        SimTK::Vector controls(workerModel.getNumControls(), 0.0);
+        for (int itime = begin; itime < end; ++itime) {
+            auto state = statesTraj[itime - begin];
+
+            // Enforce any SimTK::Motion's included in the model.
+            workerModel.getSystem().prescribe(state);
+
+            // Set the controls from the current row of the table.
+            const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
+            workerModel.realizeVelocity(state);
+            workerModel.setControls(state, controls);
+
+            workerModel.realizeReport(state);
+            int expand[] = {0, (columns.record(iworker, itime, state),
+                                       0)...};
+            (void)expand;
+        }
+    });
+}
+#endif // SWIG
+/// @endcond
+
 /// Calculate the requested outputs using the model in the problem and the
 /// provided states and controls tables
 /// The controls table is used to set the model's controls vector.
@@ -203,6 +372,11 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 ///
 /// Controls missing from the controls table are given a value of 0.
 ///
+/// Set `parallel` to 1 to analyze the rows of the tables with separate copies
+/// of the model on one thread per core, or N to use N threads; the default, 0,
+/// analyzes serially. Short trajectories use fewer threads. Use
+/// analyzeOutputs() to compute outputs of several types in one pass.
+///
 /// @note The provided trajectory is not modified to satisfy kinematic
 /// constraints, but SimTK::Motions in the Model (e.g., PositionMotion) are
 /// applied. Therefore, this function expects that you've provided a trajectory
@@ -213,83 +387,34 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 /// will be incorrect.
 /// @ingroup simulationutil
 template <typename T>
-TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
+TimeSeriesTable_<T> analyze(const Model& model,
+        const TimeSeriesTable& statesTable,
         const TimeSeriesTable& controlsTable,
-        const std::vector<std::string>& outputPaths) {
-
-    // Initialize the system so we can access the outputs.
-    model.initSystem();
-    // Create the reporter object to which we'll add the output data to create
-    // the report.
-    auto* reporter = new TableReporter_<T>();
-    // Loop through all the outputs for all components in the model, and if
-    // the output path matches one provided in the argument and the output type
-    // agrees with the template argument type, add it to the report.
-    for (const auto& comp : model.getComponentList()) {
-        for (const auto& outputName : comp.getOutputNames()) {
-            const auto& output = comp.getOutput(outputName);
-            auto thisOutputPath = output.getPathName();
-            for (const auto& outputPathArg : outputPaths) {
-                if (std::regex_match(
-                        thisOutputPath, std::regex(outputPathArg))) {
-                    // Make sure the output type agrees with the template.
-                    if (dynamic_cast<const Output<T>*>(&output)) {
-                        log_debug("Adding output {} of type {}.",
-                                output.getPathName(), output.getTypeName());
-                        reporter->addToReport(output);
-                    } else {
-                        log_warn("Ignoring output {} of type {}.",
-                                output.getPathName(), output.getTypeName());
-                    }
-                }
-            }
-        }
-    }
-    model.addComponent(reporter);
-    model.initSystem();
-
-    const auto statesTraj =
-            StatesTrajectory::createFromStatesTable(model, statesTable);
-
-    const std::vector<std::string>& controlNames =
-            controlsTable.getColumnLabels();
-    const std::unordered_map<std::string, int> controlMap =
-            createSystemControlIndexMap(model);
-    SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
-
-    OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
-            Exception,
-            "Expected statesTable and controlsTable to contain the "
-            "same number of rows, but statesTable contains {} rows "
-            "and controlsTable contains {} rows.",
-            statesTable.getNumRows(), controlsTable.getNumRows());
-
-    // Loop through the states trajectory to create the report.
-    for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
-        // Get the current state.
-        auto state = statesTraj[itime];
-
-        // Enforce any SimTK::Motion's included in the model.
-        model.getSystem().prescribe(state);
-
-        // Create a SimTK::Vector of the control values for the current state.
-        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
-        for (int icontrol = 0; icontrol < (int)controlNames.size();
-                ++icontrol) {
-            controls[controlMap.at(controlNames[icontrol])] =
-                    controlsRow[icontrol];
-        }
-
-        // Set the controls on the state object.
-        model.realizeVelocity(state);
-        model.setControls(state, controls);
+        const std::vector<std::string>& outputPaths, int parallel = 0) {
+    AnalyzeOutputColumns<T> columns;
+    analyzeOutputsImpl(model, statesTable, controlsTable, outputPaths,
+            parallel, columns);
+    return columns.createTable(statesTable.getIndependentColumn());
+}
 
-        // Generate report results for the current state.
-        model.realizeReport(state);
-    }
+/// The tables returned by analyzeOutputs(), one per output type.
+/// @ingroup simulationutil
+struct AnalyzeOutputsResult {
+    TimeSeriesTable doubles;
+    TimeSeriesTable_<SimTK::Vec3> vec3s;
+    TimeSeriesTable_<SimTK::SpatialVec> spatialVecs;
+};
 
-    return reporter->getTable();
-}
+/// Calculate the outputs of type double, SimTK::Vec3, and SimTK::SpatialVec
+/// that match the provided output paths in a single pass over the states and
+/// controls tables. This is equivalent to, but faster than, calling
+/// analyze<double>(), analyze<SimTK::Vec3>(), and
+/// analyze<SimTK::SpatialVec>() separately; see analyze() for details.
+/// @ingroup simulationutil
+OSIMSIMULATION_API AnalyzeOutputsResult analyzeOutputs(const Model& model,
+        const TimeSeriesTable& statesTable,
+        const TimeSeriesTable& controlsTable,
+        const std::vector<std::string>& outputPaths, int parallel = 0);
 
 /// Calculate "synthetic" acceleration signals equivalent to signals recorded
 /// from inertial measurement units (IMUs). First, this utility computes the
@@ -139,22 +139,28 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
+    // Look up the requested state variables once, rather than by name for
+    // every state.
+    Component::StateVariableList requestedList;
+    if (!requestedStateVars.empty()) {
+        requestedList = model.getStateVariableList(requestedStateVars);
+    }
+
     // Fill up the table with the data.
+    SimTK::Vector values(static_cast<int>(numDepColumns));
+    TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
-        TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
 
         // Get each state variable's value.
         if (requestedStateVars.empty()) {
             // This is *much* faster than getting the values one-by-one.
-            row = model.getStateVariableValues(state).transpose();
+            model.getStateVariableValues(state, values);
         } else {
-            for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] =
-                    model.getStateVariableValue(state, stateVars[icol]);
-            }
+            requestedList.getValues(state, values);
         }
 
+        row = values.transpose();
         table.appendRow(state.getTime(), row);
     }
 
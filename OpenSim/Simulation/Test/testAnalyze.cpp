@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: testAnalyze.cpp                                                   *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimulationUtilities.h>
+
+using namespace OpenSim;
+
+namespace {
+// States and controls for a double pendulum, with enough rows to use
+// multiple threads.
+void createTables(int numRows,
+        TimeSeriesTable& statesTable, TimeSeriesTable& controlsTable) {
+    std::vector<double> times;
+    SimTK::Matrix states(numRows, 4);
+    SimTK::Matrix controls(numRows, 1);
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 0.01 * i;
+        times.push_back(time);
+        states(i, 0) = std::sin(time);
+        states(i, 1) = std::cos(time);
+        states(i, 2) = 0.5 * time;
+        states(i, 3) = 0.5;
+        controls(i, 0) = 2 * time;
+    }
+    statesTable = TimeSeriesTable(times, states,
+            {"/jointset/j0/q0/value", "/jointset/j0/q0/speed",
+                    "/jointset/j1/q1/value", "/jointset/j1/q1/speed"});
+    controlsTable = TimeSeriesTable(times, controls, {"/tau0"});
+}
+} // anonymous namespace
+
+TEST_CASE("findOutputsMatchingPatterns") {
+    Model model = ModelFactory::createNLinkPendulum(2);
+    model.initSystem();
+
+    // Escaped punctuation is matched literally.
+    auto outputs = findOutputsMatchingPatterns(
+            model, {"/jointset/j0/q0\\|value", "/jointset/j0/q0\\|value"});
+    REQUIRE(outputs.size() == 1);
+    CHECK(outputs[0]->getPathName() == "/jointset/j0/q0|value");
+
+    // Outputs matched by multiple patterns are only returned once.
+    outputs = findOutputsMatchingPatterns(
+            model, {".*q\\d\\|speed", "/jointset/j1/q1\\|speed"});
+    REQUIRE(outputs.size() == 2);
+    CHECK(outputs[0]->getPathName() == "/jointset/j0/q0|speed");
+    CHECK(outputs[1]->getPathName() == "/jointset/j1/q1|speed");
+
+    CHECK(findOutputsMatchingPatterns(model, {"/jointset/j0/q0"}).empty());
+}
+
+TEST_CASE("analyze() in parallel matches serial analysis") {
+    Model model = ModelFactory::createNLinkPendulum(2);
+    TimeSeriesTable statesTable;
+    TimeSeriesTable controlsTable;
+    const int numRows = 250;
+    createTables(numRows, statesTable, controlsTable);
+
+    const std::vector<std::string> paths{
+            "/jointset/j0/q0\\|value", ".*\\|actuation"};
+    const auto serial =
+            analyze<double>(model, statesTable, controlsTable, paths, 0);
+    const auto parallel =
+            analyze<double>(model, statesTable, controlsTable, paths, 4);
+
+    REQUIRE(serial.getNumRows() == numRows);
+    REQUIRE(serial.getColumnLabels() == parallel.getColumnLabels());
+    CHECK(serial.getColumnLabels() == std::vector<std::string>{
+                    "/jointset/j0/q0|value", "/tau0|actuation",
+                    "/tau1|actuation"});
+    const auto& q0 = parallel.getDependentColumn("/jointset/j0/q0|value");
+    const auto& tau0 = parallel.getDependentColumn("/tau0|actuation");
+    const auto& tau1 = parallel.getDependentColumn("/tau1|actuation");
+    for (int i = 0; i < numRows; ++i) {
+        CHECK(q0[i] == Approx(statesTable.getMatrix()(i, 0)));
+        // The optimal force of the actuators is 1.
+        CHECK(tau0[i] == Approx(controlsTable.getMatrix()(i, 0)));
+        // Controls missing from the controls table are 0.
+        CHECK(tau1[i] == 0);
+        for (int j = 0; j < 3; ++j) {
+            CHECK(parallel.getMatrix()(i, j) == serial.getMatrix()(i, j));
+        }
+    }
+
+    TimeSeriesTable shortControls(controlsTable);
+    shortControls.removeRowAtIndex(0);
+    CHECK_THROWS_WITH(
+            analyze<double>(model, statesTable, shortControls, paths),
+            Catch::Contains("same number of rows"));
+}
+
+TEST_CASE("analyzeOutputs() computes outputs of several types") {
+    Model model = ModelFactory::createNLinkPendulum(2);
+    TimeSeriesTable statesTable;
+    TimeSeriesTable controlsTable;
+    createTables(120, statesTable, controlsTable);
+
+    const std::vector<std::string> paths{"/jointset/j1/q1\\|speed",
+            "/bodyset/b1\\|position", "/bodyset/b1\\|velocity"};
+    const auto result =
+            analyzeOutputs(model, statesTable, controlsTable, paths, 2);
+    const auto vec3s =
+            analyze<SimTK::Vec3>(model, statesTable, controlsTable, paths, 0);
+    const auto spatialVecs = analyze<SimTK::SpatialVec>(
+            model, statesTable, controlsTable, paths, 0);
+
+    CHECK(result.doubles.getColumnLabels() ==
+            std::vector<std::string>{"/jointset/j1/q1|speed"});
+    REQUIRE(result.vec3s.getColumnLabels() == vec3s.getColumnLabels());
+    REQUIRE(result.spatialVecs.getColumnLabels() ==
+            spatialVecs.getColumnLabels());
+    REQUIRE(vec3s.getNumColumns() == 1);
+    REQUIRE(spatialVecs.getNumColumns() == 1);
+    for (int i = 0; i < 120; ++i) {
+        CHECK(result.doubles.getMatrix()(i, 0) == Approx(0.5));
+        CHECK(result.vec3s.getMatrix()(i, 0) == vec3s.getMatrix()(i, 0));
+        CHECK(result.spatialVecs.getMatrix()(i, 0) ==
+                spatialVecs.getMatrix()(i, 0));
+    }
+}
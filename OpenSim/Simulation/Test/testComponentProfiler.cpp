@@ -0,0 +1,80 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: testComponentProfiler.cpp                                         *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Common/ComponentProfiler.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+TEST_CASE("ComponentProfiler") {
+    Model model = ModelFactory::createNLinkPendulum(2);
+    SimTK::State state = model.initSystem();
+
+    ComponentProfiler::reset();
+    ComponentProfiler::setEnabled(true);
+    Manager manager(model, state);
+    manager.integrate(0.1);
+    ComponentProfiler::takeSnapshot(0.1);
+    manager.integrate(0.2);
+    ComponentProfiler::takeSnapshot(0.2);
+    ComponentProfiler::setEnabled(false);
+
+    const std::string report = ComponentProfiler::createReport();
+    const TimeSeriesTable table = ComponentProfiler::createSnapshotsTable();
+    CHECK(table.getNumRows() == (ComponentProfiler::isCompiledIn() ? 2 : 0));
+
+    if (!ComponentProfiler::isCompiledIn()) {
+        // Nothing is recorded if the instrumentation is compiled out.
+        CHECK(report.find("(0 entries)") != std::string::npos);
+        CHECK(table.getNumColumns() == 0);
+        return;
+    }
+
+    // The actuators are forces, so their computeForce() calls are timed.
+    const std::string label = "/tau0|computeForce|Dynamics";
+    CHECK(report.find("/tau0") != std::string::npos);
+    CHECK(report.find("computeForce [Dynamics]") != std::string::npos);
+    const auto elapsed = table.getDependentColumn(label);
+    CHECK(elapsed[0] > 0);
+    CHECK(elapsed[1] >= elapsed[0]);
+
+    // Nothing is recorded while profiling is disabled.
+    const TimeSeriesTable before = ComponentProfiler::createSnapshotsTable();
+    Manager manager2(model, state);
+    manager2.integrate(0.1);
+    ComponentProfiler::takeSnapshot(0.3);
+    const auto after = ComponentProfiler::createSnapshotsTable();
+    CHECK(after.getDependentColumn(label)[2] == elapsed[1]);
+    CHECK(before.getNumColumns() == after.getNumColumns());
+
+    ComponentProfiler::reset();
+    CHECK(ComponentProfiler::createSnapshotsTable().getNumRows() == 0);
+
+    // Each call site forgets the entries it used before reset().
+    ComponentProfiler::setEnabled(true);
+    Manager manager3(model, state);
+    manager3.integrate(0.1);
+    ComponentProfiler::takeSnapshot(0.1);
+    ComponentProfiler::setEnabled(false);
+    const auto afterReset = ComponentProfiler::createSnapshotsTable();
+    CHECK(afterReset.getNumRows() == 1);
+    CHECK(afterReset.getDependentColumn(label)[0] > 0);
+    ComponentProfiler::reset();
+}
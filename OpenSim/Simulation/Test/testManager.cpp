@@ -37,6 +37,8 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testWriteToTable: Ensure the states table buffer records the same states
+   as the state Storage.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -56,6 +58,7 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testWriteToTable();
 
 int main()
 {
@@ -97,6 +100,12 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testWriteToTable(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testWriteToTable");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +487,50 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testWriteToTable()
+{
+    cout << "Running testWriteToTable" << endl;
+
+    using SimTK::Vec3;
+
+    Model model;
+    model.setGravity(Vec3(0, -9.81, 0));
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    SimTK::State state = model.initSystem();
+    freeJoint->updCoordinate(FreeJoint::Coord::TranslationX)
+            .setSpeedValue(state, 1.0);
+
+    for (bool constantDT : {false, true}) {
+        Manager storageManager(model);
+        storageManager.setUseConstantDT(constantDT);
+        storageManager.initialize(state);
+        // Integrate in two intervals so that records at the same time are
+        // replaced rather than duplicated.
+        storageManager.integrate(0.5);
+        storageManager.integrate(1.0);
+        TimeSeriesTable expected = storageManager.getStatesTable();
+
+        Manager tableManager(model);
+        tableManager.setUseConstantDT(constantDT);
+        tableManager.setWriteToTable(true);
+        SimTK_TEST(tableManager.getWriteToTable());
+        tableManager.initialize(state);
+        tableManager.integrate(0.5);
+        tableManager.integrate(1.0);
+        TimeSeriesTable actual = tableManager.getStatesTable();
+
+        // The states are only recorded in the buffer.
+        SimTK_TEST(tableManager.getStateStorage().getSize() == 0);
+        SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+        SimTK_TEST(actual.getNumRows() == expected.getNumRows());
+        for (size_t i = 0; i < actual.getNumRows(); ++i) {
+            SimTK_TEST_EQ(actual.getIndependentColumn()[i],
+                          expected.getIndependentColumn()[i]);
+            SimTK_TEST_EQ(actual.getRowAtIndex(i), expected.getRowAtIndex(i));
+        }
+    }
+}
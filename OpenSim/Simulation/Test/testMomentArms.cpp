@@ -55,6 +55,8 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testBatchedMomentArms(const string& filename);
+void testPolynomialSurrogate();
 
 int main()
 {
@@ -128,6 +130,12 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testBatchedMomentArms("gait2354_simbody.osim");
+        testBatchedMomentArms("testMomentArmsConstraintB.osim");
+
+        testPolynomialSurrogate();
+        cout << "Batched moment arms of all muscles about all coordinates: PASSED\n" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -166,6 +174,130 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+// The moment-arm matrix of all muscles about all coordinates must match the
+// moment-arms computed one muscle/coordinate pair at a time.
+void testBatchedMomentArms(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    MomentArmSolver maSolver(model);
+
+    SimTK::Array_<const Coordinate*> coordinates;
+    for (const auto& coord : model.getComponentList<Coordinate>())
+        coordinates.push_back(&coord);
+    SimTK::Array_<const GeometryPath*> paths;
+    for (const auto& muscle : model.getComponentList<Muscle>())
+        paths.push_back(&muscle.getGeometryPath());
+
+    SimTK::Matrix momentArms;
+    for (double frac : {0.25, 0.5, 0.75}) {
+        for (const auto* coord : coordinates) {
+            if (!coord->isConstrained(s) && !coord->getLocked(s))
+                coord->setValue(s, coord->getRangeMin() +
+                        frac * (coord->getRangeMax() - coord->getRangeMin()),
+                        false);
+        }
+        model.assemble(s);
+        model.realizePosition(s);
+
+        maSolver.solve(s, coordinates, paths, momentArms);
+        ASSERT(momentArms.nrow() == (int)paths.size());
+        ASSERT(momentArms.ncol() == (int)coordinates.size());
+        for (int i = 0; i < (int)paths.size(); ++i) {
+            for (int j = 0; j < (int)coordinates.size(); ++j) {
+                ASSERT_EQUAL(maSolver.solve(s, *coordinates[j], *paths[i]),
+                        momentArms(i, j), 1e-10);
+            }
+        }
+
+        SimTK::Vector pathMomentArms;
+        paths[0]->computeMomentArms(s, coordinates, pathMomentArms);
+        ASSERT(pathMomentArms.size() == (int)coordinates.size());
+        for (int j = 0; j < (int)coordinates.size(); ++j)
+            ASSERT_EQUAL(momentArms(0, j), pathMomentArms[j], 1e-10);
+    }
+}
+
+// The length, lengthening speed, and moment arm of a path with a polynomial
+// surrogate must match those of the exact path within the tolerance of the
+// surrogate, and match exactly outside the range of the coordinates.
+void testPolynomialSurrogate()
+{
+    const double tol = 2e-3;
+    Model exactModel("gait2354_simbody.osim");
+    Model model("gait2354_simbody.osim");
+    GeometryPath& path =
+        model.updComponent<Muscle>("forceset/vas_int_r").updGeometryPath();
+    path.set_use_polynomial_surrogate(true);
+    path.set_polynomial_surrogate_order(6);
+    path.set_polynomial_surrogate_tolerance(tol);
+    GeometryPath& multiJointPath =
+        model.updComponent<Muscle>("forceset/rect_fem_r").updGeometryPath();
+    multiJointPath.set_use_polynomial_surrogate(true);
+
+    SimTK::State& s = model.initSystem();
+    SimTK::State& sExact = exactModel.initSystem();
+    const GeometryPath& exactPath =
+        exactModel.getComponent<Muscle>("forceset/vas_int_r").getGeometryPath();
+    ASSERT(!exactPath.isPolynomialSurrogateInUse());
+    ASSERT(SimTK::isNaN(exactPath.getPolynomialSurrogateLengthError()));
+
+    ASSERT(path.isPolynomialSurrogateInUse());
+    ASSERT(path.getPolynomialSurrogateCoordinates() ==
+            std::vector<std::string>{"/jointset/knee_r/knee_angle_r"});
+    ASSERT(path.getPolynomialSurrogateLengthError() <= tol);
+    ASSERT(path.getPolynomialSurrogateMomentArmError() <= tol);
+
+    const Coordinate& knee = model.getCoordinateSet().get("knee_angle_r");
+    const Coordinate& exactKnee =
+        exactModel.getCoordinateSet().get("knee_angle_r");
+    auto setKnee = [&](double angle) {
+        knee.setValue(s, angle, false);
+        knee.setSpeedValue(s, 1.5);
+        model.realizeVelocity(s);
+        exactKnee.setValue(sExact, angle, false);
+        exactKnee.setSpeedValue(sExact, 1.5);
+        exactModel.realizeVelocity(sExact);
+    };
+    const double min = knee.getRangeMin();
+    const double max = knee.getRangeMax();
+    for (double frac : {0.1, 0.37, 0.5, 0.82}) {
+        setKnee(min + frac * (max - min));
+        ASSERT_EQUAL(exactPath.getLength(sExact), path.getLength(s), tol);
+        ASSERT_EQUAL(exactPath.getLengtheningSpeed(sExact),
+                path.getLengtheningSpeed(s), 1.5 * tol);
+        ASSERT_EQUAL(exactPath.computeMomentArm(sExact, exactKnee),
+                path.computeMomentArm(s, knee), tol);
+    }
+
+    // The length from the surrogate does not depend on whether the exact
+    // path was computed first (e.g., for the path points).
+    setKnee(min + 0.6 * (max - min));
+    const double surrogateLength = path.getLength(s);
+    path.getCurrentPath(s);
+    ASSERT(path.getLength(s) == surrogateLength);
+    setKnee(min + 0.6 * (max - min));
+    path.getCurrentPath(s);
+    ASSERT(path.getLength(s) == surrogateLength);
+
+    // Outside the range of the knee angle, the path is computed exactly.
+    setKnee(max + 0.1);
+    ASSERT_EQUAL(exactPath.getLength(sExact), path.getLength(s), 1e-10);
+    ASSERT_EQUAL(exactPath.getLengtheningSpeed(sExact),
+            path.getLengtheningSpeed(s), 1e-10);
+    ASSERT_EQUAL(exactPath.computeMomentArm(sExact, exactKnee),
+            path.computeMomentArm(s, knee), 1e-10);
+
+    // The rectus femoris spans the hip and the knee. Whether or not its
+    // surrogate is accurate enough to be used, the errors are recorded.
+    const auto coordinates = multiJointPath.getPolynomialSurrogateCoordinates();
+    ASSERT(std::find(coordinates.begin(), coordinates.end(),
+            "/jointset/knee_r/knee_angle_r") != coordinates.end());
+    ASSERT(!SimTK::isNaN(multiJointPath.getPolynomialSurrogateLengthError()));
+    ASSERT(!SimTK::isNaN(
+            multiJointPath.getPolynomialSurrogateMomentArmError()));
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
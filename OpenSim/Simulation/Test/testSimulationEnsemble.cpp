@@ -0,0 +1,93 @@
+/* -------------------------------------------------------------------------- *
+ * OpenSim: testSimulationEnsemble.cpp                                        *
+ * -------------------------------------------------------------------------- *
+ * Copyright (c) 2023 Stanford University and the Authors                     *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0          *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+#include <OpenSim/Actuators/ModelFactory.h>
+#include <OpenSim/Simulation/Manager/SimulationEnsemble.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+using namespace OpenSim;
+
+TEST_CASE("SimulationEnsemble matches individual simulations") {
+    Model model = ModelFactory::createNLinkPendulum(2);
+    SimTK::State state = model.initSystem();
+
+    const int numRuns = 7;
+    const double finalTime = 0.5;
+    std::vector<SimTK::State> initialStates;
+    for (int irun = 0; irun < numRuns; ++irun) {
+        initialStates.push_back(state);
+        model.getCoordinateSet()[0].setValue(
+                initialStates.back(), 0.1 * irun);
+    }
+
+    SimulationEnsemble ensemble(model);
+    ensemble.setParallel(3);
+    ensemble.setIntegratorAccuracy(1e-6);
+    ensemble.setReportingInterval(0.1);
+    ensemble.setRecordStatesTrajectory(true);
+    ensemble.addOutput("/jointset/j1/q1|value");
+    const auto& results = ensemble.run(initialStates, finalTime);
+
+    REQUIRE(results.size() == numRuns);
+    CHECK(ensemble.getNumFailedRuns() == 0);
+    for (int irun = 0; irun < numRuns; ++irun) {
+        const auto& result = results[irun];
+        REQUIRE(result.status == SimulationEnsemble::RunStatus::Succeeded);
+        CHECK(result.stats.numStepsTaken > 0);
+        CHECK(result.statesTrajectory.getSize() == 6);
+        REQUIRE(result.outputs.getNumRows() == 6);
+        CHECK(result.outputs.getIndependentColumn().back() ==
+                Approx(finalTime));
+
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-6);
+        manager.initialize(initialStates[irun]);
+        const SimTK::State& expected = manager.integrate(finalTime);
+        for (int iy = 0; iy < expected.getNY(); ++iy) {
+            CHECK(result.finalState.getY()[iy] ==
+                    Approx(expected.getY()[iy]).margin(1e-5));
+        }
+        CHECK(result.outputs.getMatrix()(5, 0) ==
+                Approx(expected.getQ()[1]).margin(1e-5));
+    }
+}
+
+TEST_CASE("SimulationEnsemble continues after a failed run") {
+    Model model = ModelFactory::createPendulum();
+    SimTK::State state = model.initSystem();
+
+    SimulationEnsemble ensemble(model);
+    ensemble.setRunInitializer(
+            [](int irun, const Model& model, SimTK::State& state) {
+                if (irun == 2) {
+                    throw Exception("Run 2 is invalid.");
+                }
+                model.getCoordinateSet()[0].setValue(state, 0.1 * irun);
+            });
+    const auto& results = ensemble.run(state, 5, 0.2);
+
+    REQUIRE(results.size() == 5);
+    CHECK(ensemble.getNumFailedRuns() == 1);
+    CHECK(results[2].status == SimulationEnsemble::RunStatus::Failed);
+    CHECK(results[2].message.find("Run 2 is invalid.") != std::string::npos);
+    for (int irun : {0, 1, 3, 4}) {
+        CHECK(results[irun].status ==
+                SimulationEnsemble::RunStatus::Succeeded);
+        CHECK(results[irun].finalState.getTime() == Approx(0.2));
+    }
+}
@@ -218,8 +218,8 @@ void CorrectionController::computeControls(const SimTK::State& s, SimTK::Vector&
     // GET CURRENT DESIRED COORDINATES AND SPEEDS
     // Note: yDesired[0..nq-1] will contain the generalized coordinates
     // and yDesired[nq..nq+nu-1] will contain the generalized speeds.
-    Array<double> yDesired(0.0,nq+nu);
-    getDesiredStatesStorage().getDataAtTime(t, nq+nu,yDesired);
+    SimTK::Vector yDesired(nq+nu, 0.0);
+    getDesiredStatesCursor().getDataAtTime(t, yDesired);
     
     SimTK::Vector actControls(1, 0.0);
 
@@ -63,7 +63,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
 }
@@ -82,7 +83,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -104,7 +106,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -156,6 +159,13 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _parallelProp.setComment("Number of threads used to solve for the "
+        "generalized forces: 0 (default) to solve serially, 1 to use all "
+        "cores, or N > 1 to use N threads.");
+    _parallelProp.setName("parallel");
+    _parallelProp.setValue(0);
+    _propertySet.append(&_parallelProp);
 }
 
 //_____________________________________________________________________________
@@ -187,6 +197,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _parallel = aTool._parallel;
     _coordinateValues = NULL;
 
     return(*this);
@@ -411,18 +422,44 @@ bool InverseDynamicsTool::run()
 
         int nt = final_index-start_index+1;
         
-        Array_<double> times(nt, 0.0);
+        Vector times(nt, 0.0);
         for(int i=0; i<nt; i++){
             times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
         }
 
-        // Preallocate results
-        Array_<Vector> genForceTraj(nt, Vector(nCoords, 0.0));
+        // Evaluate the coordinate functions at all times. Account for cases
+        // where qdot != u with coordinatesToSpeedsIndexMap.
+        Matrix qTraj(nt, nq), uTraj(nt, nu), udotTraj(nt, nu);
+        for (int j = 0; j < nq; ++j) {
+            for (int i = 0; i < nt; ++i) {
+                qTraj(i, j) = coordFunctions.evaluate(j, 0, times[i]);
+            }
+        }
+        for (int j = 0; j < nu; ++j) {
+            const int ifunc = coordinatesToSpeedsIndexMap[j];
+            for (int i = 0; i < nt; ++i) {
+                uTraj(i, j) = coordFunctions.evaluate(ifunc, 1, times[i]);
+                udotTraj(i, j) = coordFunctions.evaluate(ifunc, 2, times[i]);
+            }
+        }
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        Matrix genForceTraj(nt, nu);
+        ivdSolver.solve(s, times, qTraj, uTraj, udotTraj, genForceTraj,
+                _parallel);
+
+        AnalysisSet& analysisSet = _model->updAnalysisSet();
+        if (analysisSet.getSize()) {
+            for (int i = 0; i < nt; ++i) {
+                s.updTime() = times[i];
+                s.updQ() = ~qTraj[i];
+                s.updU() = ~uTraj[i];
+                s.updUDot() = ~udotTraj[i];
+                _model->getMultibodySystem().realize(s, Stage::Dynamics);
+                analysisSet.step(s, i);
+            }
+        }
         success = true;
 
         log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
@@ -459,7 +496,7 @@ bool InverseDynamicsTool::run()
 
         for(int i=0; i<nt; i++){
             StateVector
-                genForceVec(times[i], genForceTraj[i]);
+                genForceVec(times[i], Vector(~genForceTraj[i]));
             genForceResults.append(genForceVec);
 
             // if there are joints requested for equivalent body forces then calculate them
@@ -470,21 +507,12 @@ bool InverseDynamicsTool::run()
                                                                  &forces[0]));
 
                 s.updTime() = times[i];
-                Vector &q = s.updQ();
-                Vector &u = s.updU();
-
-                // Account for cases where qdot != u with coordinatesToSpeedsIndexMap
-                for( int j = 0; j < nq; ++j) {
-                    q[j] = coordFunctions.evaluate(j, 0, times[i]);
-                }
-                for (int j = 0; j < nu; ++j) {
-                    u[j] = coordFunctions.evaluate(
-                            coordinatesToSpeedsIndexMap[j], 1, times[i]);
-                }
+                s.updQ() = ~qTraj[i];
+                s.updU() = ~uTraj[i];
+                const Vector genForces(~genForceTraj[i]);
 
-            
                 for(int j=0; j<nj; ++j){
-                    equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForceTraj[i]);
+                    equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForces);
                     for(int k=0; k<3; ++k){
                         // body force components
                         bodyForcesVec.setDataValue(6*j+k, equivalentBodyForceAtJoint[1][k]); 
@@ -88,6 +88,12 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads used to solve for the generalized forces: 0 (the
+        default) to solve serially, 1 to use all cores, or N > 1 to use N
+        threads. */
+    PropertyInt _parallelProp;
+    int &_parallel;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +162,8 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    int getParallel() const { return _parallel; }
+    void setParallel(int parallel) { _parallel = parallel; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
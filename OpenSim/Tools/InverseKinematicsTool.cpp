@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -40,10 +41,24 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+    // Results of tracking a single frame, stored so that frames solved out of
+    // order (in parallel) can be reported in time order.
+    struct IKFrameSolution {
+        SimTK::Vector q;
+        SimTK::Vector u;
+        SimTK::Array_<double> squaredMarkerErrors;
+        SimTK::Array_<Vec3> markerLocations;
+    };
+}
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +101,7 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_parallel(0);
 }
 
 //=============================================================================
@@ -190,19 +206,14 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
-        for (int i = start_ix; i <= final_ix; ++i) {
-            s.updTime() = times[i];
-            ikSolver.track(s);
-            // show progress line every 1000 frames so users see progress
-            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
-                log_info("Solved {} frame(s)...", i - start_ix);
+        // Report the solution for frame i, which must already be in s.
+        auto reportFrame = [&](int i) {
             if(get_report_errors()){
                 Array<double> markerErrors(0.0, 3);
                 double totalSquaredMarkerError = 0.0;
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -225,7 +236,6 @@ bool InverseKinematicsTool::run()
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
@@ -238,6 +248,90 @@ bool InverseKinematicsTool::run()
 
             kinematicsReporter->step(s, i);
             analysisSet.step(s, i);
+        };
+
+        const int numThreads = std::min(getNumThreads(), Nframes);
+        if (numThreads <= 1) {
+            for (int i = start_ix; i <= final_ix; ++i) {
+                s.updTime() = times[i];
+                ikSolver.track(s);
+                // show progress line every 1000 frames so users see progress
+                if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
+                    log_info("Solved {} frame(s)...", i - start_ix);
+                if (get_report_errors())
+                    ikSolver.computeCurrentSquaredMarkerErrors(
+                            squaredMarkerErrors);
+                if (get_report_marker_locations())
+                    ikSolver.computeCurrentMarkerLocations(markerLocations);
+                reportFrame(i);
+            }
+        } else {
+            log_info("Solving {} frames in {} parallel chunks.", Nframes,
+                    numThreads);
+            // Each chunk gets its own copy of the model, state, and solver.
+            // Copying and initializing models is not thread-safe, so do it
+            // here rather than in the worker threads.
+            std::vector<std::unique_ptr<Model>> models;
+            std::vector<SimTK::State> states;
+            std::vector<std::unique_ptr<InverseKinematicsSolver>> solvers;
+            for (int ithread = 0; ithread < numThreads; ++ithread) {
+                models.emplace_back(new Model(*_model));
+                // Analyses are stepped on the tool's model only.
+                models.back()->updAnalysisSet().clearAndDestroy();
+                states.push_back(models.back()->initSystem());
+                // Start from the pose assembled at the first frame.
+                states.back().updQ() = s.getQ();
+                states.back().updU() = s.getU();
+                solvers.emplace_back(new InverseKinematicsSolver(
+                        *models.back(),
+                        make_shared<MarkersReference>(markersReference),
+                        coordinateReferences, get_constraint_weight()));
+                solvers.back()->setAccuracy(get_accuracy());
+            }
+
+            std::vector<IKFrameSolution> solutions(Nframes);
+            std::atomic<int> numSolved(0);
+            runInContiguousChunks(Nframes, numThreads,
+                    [&](int ithread, int begin, int end) {
+                SimTK::State& state = states[ithread];
+                InverseKinematicsSolver& chunkSolver = *solvers[ithread];
+                for (int i = start_ix + begin; i < start_ix + end; ++i) {
+                    state.updTime() = times[i];
+                    // Warm start each chunk with a full assembly at its
+                    // first frame; the remaining frames are tracked.
+                    if (i == start_ix + begin)
+                        chunkSolver.assemble(state);
+                    else
+                        chunkSolver.track(state);
+                    auto& solution = solutions[i - start_ix];
+                    solution.q = state.getQ();
+                    solution.u = state.getU();
+                    if (get_report_errors())
+                        chunkSolver.computeCurrentSquaredMarkerErrors(
+                                solution.squaredMarkerErrors);
+                    if (get_report_marker_locations())
+                        chunkSolver.computeCurrentMarkerLocations(
+                                solution.markerLocations);
+                    const int n = ++numSolved;
+                    if (n % 1000 == 0)
+                        log_info("Solved {} frame(s)...", n);
+                }
+            });
+
+            // Report the frames in time order using the tool's model.
+            for (int i = start_ix; i <= final_ix; ++i) {
+                auto& solution = solutions[i - start_ix];
+                s.updTime() = times[i];
+                s.updQ() = solution.q;
+                s.updU() = solution.u;
+                if (get_report_errors())
+                    squaredMarkerErrors = solution.squaredMarkerErrors;
+                if (get_report_marker_locations())
+                    markerLocations = solution.markerLocations;
+                reportFrame(i);
+                // Release the memory for this frame.
+                solution = IKFrameSolution();
+            }
         }
 
         // Do the maneuver to change then restore working directory 
@@ -309,6 +403,14 @@ bool InverseKinematicsTool::run()
     return success;
 }
 
+int InverseKinematicsTool::getNumThreads() const
+{
+    OPENSIM_THROW_IF_FRMOBJ(get_parallel() < 0, Exception,
+            "Expected the 'parallel' property to be non-negative, but got "
+            "{}.", get_parallel());
+    return getNumThreadsForParallel(get_parallel());
+}
+
 // Handle conversion from older format
 void InverseKinematicsTool::updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber)
 {
@@ -71,6 +71,13 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(parallel, int,
+            "Solve frames in parallel? 0: not parallel (default); 1: use all "
+            "cores; greater than 1: use this number of parallel jobs. The time "
+            "range is split into one contiguous chunk per job, and each chunk "
+            "is assembled at its first frame. Results are reported in time "
+            "order.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,6 +109,11 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    /// Set the number of parallel jobs used to solve the frames; see the
+    /// `parallel` property.
+    void setParallel(int parallel) { upd_parallel() = parallel; }
+    int getParallel() const { return get_parallel(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -119,6 +131,8 @@ public:
 #endif
 private:
     void constructProperties();
+    /// The number of threads to use given the `parallel` property.
+    int getNumThreads() const;
 
     //=============================================================================
 };  // END of class InverseKinematicsTool
@@ -21,6 +21,8 @@
 
 #include "testing_optimalcontrol.h"
 
+#include <atomic>
+
 using Eigen::Ref;
 using Eigen::VectorXd;
 using Eigen::RowVectorXd;
@@ -189,6 +191,58 @@ TEST_CASE("IPOPT") {
     }
 }
 
+// Evaluates the dynamics on multiple threads, and checks that no two threads
+// use the same thread index at the same time.
+class ParallelSlidingMass : public SlidingMass<double> {
+public:
+    static const int num_threads = 3;
+    int get_num_threads() const override { return num_threads; }
+    void calc_differential_algebraic_equations_in_thread(int thread_index,
+            const Input<double>& in, Output<double> out) const override {
+        // Catch assertions are not threadsafe, so only count problems here.
+        if (thread_index < 0 || thread_index >= num_threads) {
+            m_num_conflicts++;
+            return;
+        }
+        if (m_in_use[thread_index].exchange(true)) m_num_conflicts++;
+        calc_differential_algebraic_equations(in, out);
+        m_num_calls[thread_index]++;
+        m_in_use[thread_index] = false;
+    }
+    mutable std::atomic<bool> m_in_use[num_threads] = {};
+    mutable std::atomic<int> m_num_calls[num_threads] = {};
+    mutable std::atomic<int> m_num_conflicts{0};
+};
+
+TEST_CASE("Parallel evaluation of the dynamics") {
+    for (const std::string transcription : {"trapezoidal", "hermite-simpson"}) {
+        DYNAMIC_SECTION(transcription) {
+            auto serial_ocp = std::make_shared<SlidingMass<double>>();
+            auto ocp = std::make_shared<ParallelSlidingMass>();
+            Solution expected;
+            Solution solution;
+            for (auto problem : std::vector<std::shared_ptr<
+                         const tropter::Problem<double>>>{serial_ocp, ocp}) {
+                DirectCollocationSolver<double> dircol(
+                        problem, transcription, "ipopt");
+                dircol.get_opt_solver().set_findiff_hessian_step_size(1e-3);
+                dircol.get_opt_solver().set_hessian_approximation(
+                        "limited-memory");
+                (problem == ocp ? solution : expected) = dircol.solve();
+            }
+            REQUIRE(solution.success);
+            // Each collocation point is evaluated identically regardless of
+            // the thread, so the solutions are the same.
+            TROPTER_REQUIRE_EIGEN(solution.states, expected.states, 1e-10);
+            TROPTER_REQUIRE_EIGEN(solution.controls, expected.controls, 1e-10);
+            CHECK(ocp->m_num_conflicts == 0);
+            int num_calls = 0;
+            for (const auto& count : ocp->m_num_calls) num_calls += count;
+            CHECK(num_calls > 0);
+        }
+    }
+}
+
 #if defined(TROPTER_WITH_SNOPT)
 TEST_CASE("SNOPT, trapezoidal") {
 
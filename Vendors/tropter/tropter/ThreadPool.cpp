@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// tropter: ThreadPool.cpp
+// ----------------------------------------------------------------------------
+// Copyright (c) 2023 tropter authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain a
+// copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
+
+#include "ThreadPool.h"
+
+#include "Exception.hpp"
+
+using namespace tropter;
+
+ThreadPool::ThreadPool(int num_threads) : m_num_threads(num_threads) {
+    TROPTER_THROW_IF(num_threads < 1,
+            "Expected num_threads to be at least 1, but got %i.",
+            num_threads);
+    for (int ithread = 1; ithread < num_threads; ++ithread) {
+        m_threads.emplace_back(&ThreadPool::work, this, ithread);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+void ThreadPool::run(int num_tasks, const Task& task) {
+    if (num_tasks <= 0) return;
+    if (m_threads.empty() || num_tasks == 1) {
+        for (int itask = 0; itask < num_tasks; ++itask) task(0, itask);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_num_tasks = num_tasks;
+        m_next_task = 0;
+        m_exception = nullptr;
+        m_num_busy_workers = (int)m_threads.size();
+        ++m_batch;
+    }
+    m_start.notify_all();
+    execute_tasks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_num_busy_workers == 0; });
+    m_task = nullptr;
+    std::exception_ptr exception = m_exception;
+    m_exception = nullptr;
+    lock.unlock();
+    if (exception) std::rethrow_exception(exception);
+}
+
+void ThreadPool::work(int thread_index) {
+    int batch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&] { return m_stop || m_batch != batch; });
+            if (m_stop) return;
+            batch = m_batch;
+        }
+        execute_tasks(thread_index);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_num_busy_workers;
+        }
+        m_done.notify_one();
+    }
+}
+
+void ThreadPool::execute_tasks(int thread_index) {
+    int itask;
+    while ((itask = m_next_task++) < m_num_tasks) {
+        try {
+            (*m_task)(thread_index, itask);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) m_exception = std::current_exception();
+            m_next_task = m_num_tasks;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef TROPTER_THREADPOOL_H
+#define TROPTER_THREADPOOL_H
+// ----------------------------------------------------------------------------
+// tropter: ThreadPool.h
+// ----------------------------------------------------------------------------
+// Copyright (c) 2023 tropter authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may
+// not use this file except in compliance with the License. You may obtain a
+// copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tropter {
+
+/// A fixed set of threads that repeatedly execute batches of tasks, so that
+/// threads are not created and destroyed for every batch. The thread that
+/// calls run() also executes tasks, so a pool with N threads starts N - 1
+/// worker threads. Each task is given the index (in [0, N)) of the thread
+/// executing it; tasks that run at the same time always have different thread
+/// indices, so the index can be used to select per-thread working memory.
+class ThreadPool {
+public:
+    /// The task receives the thread index and the task index.
+    typedef std::function<void(int, int)> Task;
+
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int get_num_threads() const { return m_num_threads; }
+
+    /// Invoke task(thread_index, task_index) for each task_index in
+    /// [0, num_tasks), and return once all tasks are done. If a task throws an
+    /// exception, the remaining tasks are skipped and the first exception is
+    /// rethrown here. Only one thread may call run() at a time.
+    void run(int num_tasks, const Task& task);
+
+private:
+    void work(int thread_index);
+    void execute_tasks(int thread_index);
+
+    const int m_num_threads;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const Task* m_task = nullptr;
+    int m_num_tasks = 0;
+    std::atomic<int> m_next_task{0};
+    // Incremented for each batch; workers wait for it to change.
+    int m_batch = 0;
+    int m_num_busy_workers = 0;
+    bool m_stop = false;
+    std::exception_ptr m_exception;
+};
+
+} // namespace tropter
+
+#endif // TROPTER_THREADPOOL_H
@@ -388,6 +388,21 @@ public:
     /// constraints exist in your problem.
     virtual void calc_differential_algebraic_equations(
             const Input<T>& in, Output<T> out) const;
+    /// The number of threads with which the transcription may evaluate the
+    /// differential-algebraic equations at different collocation points
+    /// concurrently (default: 1, meaning the equations are evaluated
+    /// serially). Problems that return a larger number must override
+    /// calc_differential_algebraic_equations_in_thread() so that concurrent
+    /// calls do not share working memory. Concurrent evaluation is only used
+    /// with T = double, since ADOL-C records all operations on one tape.
+    virtual int get_num_threads() const { return 1; }
+    /// The transcription calls this function instead of
+    /// calc_differential_algebraic_equations() to evaluate the equations at
+    /// each collocation point. Calls that run at the same time have different
+    /// values of `thread_index`, which is in [0, get_num_threads()). The
+    /// default implementation calls calc_differential_algebraic_equations().
+    virtual void calc_differential_algebraic_equations_in_thread(
+            int thread_index, const Input<T>& in, Output<T> out) const;
     // TODO alternate form that takes a matrix; state at every time.
     //virtual void continuous(const MatrixX<T>& x, MatrixX<T>& xdot) const = 0;
     // TODO Maybe this one signature could be used for both the "continuous,
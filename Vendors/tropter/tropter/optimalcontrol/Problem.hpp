@@ -149,6 +149,11 @@ void Problem<T>::
 calc_differential_algebraic_equations(const Input<T>&, Output<T>) const
 {}
 
+template<typename T>
+void Problem<T>::calc_differential_algebraic_equations_in_thread(
+        int /*thread_index*/, const Input<T>& in, Output<T> out) const
+{   calc_differential_algebraic_equations(in, out); }
+
 template<typename T>
 void Problem<T>::calc_cost(int /*cost_index*/, const CostInput<T>&, T&) const
 { TROPTER_THROW("calc_cost() not implemented."); }
@@ -17,10 +17,14 @@
 // ----------------------------------------------------------------------------
 
 #include <tropter/common.h>
+#include <tropter/ThreadPool.h>
 #include <tropter/optimization/ProblemDecorator_double.h>
 #include <tropter/optimization/ProblemDecorator_adouble.h>
 #include <tropter/optimalcontrol/Iterate.h>
 
+#include <memory>
+#include <type_traits>
+
 //namespace transcription {
 //
 //class Trapezoidal;
@@ -96,8 +100,26 @@ public:
     std::string get_exact_hessian_block_sparsity_mode () const
     {   return m_exact_hessian_block_sparsity_mode; }
 
+protected:
+    /// Invoke task(thread_index, i) for each i in [0, num_tasks), using
+    /// num_threads threads if num_threads > 1 and T is double. Otherwise, the
+    /// tasks are run serially with a thread index of 0.
+    void run_tasks(int num_threads, int num_tasks,
+            const ThreadPool::Task& task) const {
+        if (num_threads > 1 && std::is_same<T, double>::value) {
+            if (!m_thread_pool ||
+                    m_thread_pool->get_num_threads() != num_threads) {
+                m_thread_pool.reset(new ThreadPool(num_threads));
+            }
+            m_thread_pool->run(num_tasks, task);
+        } else {
+            for (int itask = 0; itask < num_tasks; ++itask) task(0, itask);
+        }
+    }
+
 private:
     std::string m_exact_hessian_block_sparsity_mode{"dense"};
+    mutable std::unique_ptr<ThreadPool> m_thread_pool;
 
 };
 
@@ -394,7 +394,6 @@ void HermiteSimpson<T>::calc_objective(
 template <typename T>
 void HermiteSimpson<T>::calc_constraints(
         const VectorX<T>& x, Eigen::Ref<VectorX<T>> constraints) const {
-    // TODO parallelize.
     const T& initial_time = x[0];
     const T& final_time = x[1];
     const T duration = final_time - initial_time;
@@ -418,29 +417,36 @@ void HermiteSimpson<T>::calc_constraints(
 
     // Obtain state derivatives at each mesh point.
     // --------------------------------------------
-    // Evaluate points on the mesh.
-    int i_mesh = 0;
-    for (int i_col = 0; i_col < m_num_col_points; i_col += 2) {
-        const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), m_empty_diffuse_col, parameters},
-                {m_derivs_mesh.col(i_mesh),
-                        constr_view.path_constraints.col(i_mesh)});
-        i_mesh++;
-    }
-    // Evaluate points on the mesh interval interior.
-    int i_mid = 0;
-    for (int i_col = 1; i_col < m_num_col_points; i_col += 2) {
-        const T time = duration * m_mesh_and_midpoints[i_col] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_col, time, states.col(i_col), controls.col(i_col),
-                        adjuncts.col(i_col), diffuses.col(i_mid), parameters},
-                {m_derivs_mid.col(i_mid), m_empty_path_constraint_col});
-        TROPTER_THROW_IF(m_empty_path_constraint_col.size() != 0,
-                "Invalid resize of empty path constraint output.");
-        i_mid++;
-    }
+    // Collocation points with even indices are on the mesh, and those with odd
+    // indices are on the mesh interval interior. Each point writes to its own
+    // columns, so the points can be evaluated concurrently if the problem
+    // supports it.
+    this->run_tasks(m_ocproblem->get_num_threads(), m_num_col_points,
+            [&](int i_thread, int i_col) {
+                const T time =
+                        duration * m_mesh_and_midpoints[i_col] + initial_time;
+                if (i_col % 2 == 0) {
+                    const int i_mesh = i_col / 2;
+                    m_ocproblem->calc_differential_algebraic_equations_in_thread(
+                            i_thread,
+                            {i_col, time, states.col(i_col),
+                                    controls.col(i_col), adjuncts.col(i_col),
+                                    m_empty_diffuse_col, parameters},
+                            {m_derivs_mesh.col(i_mesh),
+                                    constr_view.path_constraints.col(i_mesh)});
+                } else {
+                    const int i_mid = i_col / 2;
+                    m_ocproblem->calc_differential_algebraic_equations_in_thread(
+                            i_thread,
+                            {i_col, time, states.col(i_col),
+                                    controls.col(i_col), adjuncts.col(i_col),
+                                    diffuses.col(i_mid), parameters},
+                            {m_derivs_mid.col(i_mid),
+                                    m_empty_path_constraint_col});
+                }
+            });
+    TROPTER_THROW_IF(m_empty_path_constraint_col.size() != 0,
+            "Invalid resize of empty path constraint output.");
 
     // Compute constraint defects.
     // ---------------------------
@@ -276,7 +276,6 @@ void Trapezoidal<T>::calc_objective(const VectorX<T>& x, T& obj_value) const {
 template <typename T>
 void Trapezoidal<T>::calc_constraints(
         const VectorX<T>& x, Eigen::Ref<VectorX<T>> constraints) const {
-    // TODO parallelize.
     const T& initial_time = x[0];
     const T& final_time = x[1];
     const T duration = final_time - initial_time;
@@ -300,16 +299,19 @@ void Trapezoidal<T>::calc_constraints(
     // --------------------------------------------
     // TODO storing 1 too many derivatives trajectory; don't need the first
     // xdot (at t0). (TODO I don't think this is true anymore).
-    // TODO tradeoff between memory and parallelism.
-    for (int i_mesh = 0; i_mesh < m_num_mesh_points; ++i_mesh) {
-        // TODO should pass the time.
-        const T time = duration * m_mesh[i_mesh] + initial_time;
-        m_ocproblem->calc_differential_algebraic_equations(
-                {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
-                        adjuncts.col(i_mesh), m_empty_diffuse_col, parameters},
-                {m_derivs.col(i_mesh),
-                        constr_view.path_constraints.col(i_mesh)});
-    }
+    // Each mesh point writes to its own columns, so the mesh points can be
+    // evaluated concurrently if the problem supports it.
+    this->run_tasks(m_ocproblem->get_num_threads(), m_num_mesh_points,
+            [&](int i_thread, int i_mesh) {
+                const T time = duration * m_mesh[i_mesh] + initial_time;
+                m_ocproblem->calc_differential_algebraic_equations_in_thread(
+                        i_thread,
+                        {i_mesh, time, states.col(i_mesh), controls.col(i_mesh),
+                                adjuncts.col(i_mesh), m_empty_diffuse_col,
+                                parameters},
+                        {m_derivs.col(i_mesh),
+                                constr_view.path_constraints.col(i_mesh)});
+            });
 
     // Compute constraint defects.
     // ---------------------------